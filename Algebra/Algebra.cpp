@@ -1,5 +1,9 @@
 #include "Algebra.h"
+#include "Join.h"
+#include "JoinPlanner.h"
+#include "../Executor/Executor.h"
 
+#include <cmath>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,37 +20,29 @@ the arguments of the function are
 */
 int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], 
                     char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]) 
+{
+    // a single condition is a predicate tree with just one leaf
+    PredicateNode *condition = Predicate::createCompare(attr, op, strVal);
+    if (condition == nullptr) return FAILURE;
+
+    int ret = Algebra::select(srcRel, targetRel, condition);
+    Predicate::release(condition);
+
+    return ret;
+}
+
+/* used to select all the records that satisfy a WHERE clause made of
+   several conditions joined by AND/OR (see Predicate.h).
+* condition - the parsed predicate tree (it is resolved against srcRel here)
+*/
+int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition)
 {
     // get the srcRel's rel-id (let it be srcRelid), using OpenRelTable::getRelId()
     // if srcRel is not open in open relation table, return E_RELNOTOPEN
     
-    int srcRelId = OpenRelTable::getRelId(srcRel); // we'll implement this later
+    int srcRelId = OpenRelTable::getRelId(srcRel);
     if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
 
-    // get the attr-cat entry for attr, using AttrCacheTable::getAttrCatEntry()
-    // if getAttrcatEntry() call fails return E_ATTRNOTEXIST
-    AttrCatEntry attrCatEntry;
-    int ret = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry);
-
-    if (ret == E_ATTRNOTEXIST) return E_ATTRNOTEXIST;
-
-    /*** Convert strVal to an attribute of data type NUMBER or STRING ***/
-
-    // TODO: Convert strVal (string) to an attribute of data type NUMBER or STRING 
-    int type = attrCatEntry.attrType;
-    Attribute attrVal;
-    if (type == NUMBER)
-    {
-        if (isNumber(strVal)) // the isNumber() function is implemented below
-            attrVal.nVal = atof(strVal);
-        else
-            return E_ATTRTYPEMISMATCH;
-    }
-    else if (type == STRING)
-        strcpy(attrVal.sVal, strVal);
-
-    /*** Creating and opening the target relation ***/
-    // Prepare arguments for createRel() in the following way:
     // get RelcatEntry of srcRel using RelCacheTable::getRelCatEntry()
     RelCatEntry relCatEntryBuffer;
     RelCacheTable::getRelCatEntry(srcRelId, &relCatEntryBuffer);
@@ -57,82 +53,660 @@ int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE],
         (will store the attribute names of rel). */
     char srcAttrNames [srcNoAttrs][ATTR_SIZE];
 
-    // let attr_types[src_nAttrs] be an array of type int
-    int srcAttrTypes [srcNoAttrs];
-
     /*iterate through 0 to src_nAttrs-1 :
         get the i'th attribute's AttrCatEntry using AttrCacheTable::getAttrCatEntry()
-        fill the attr_names, attr_types arrays that we declared with the entries
-        of corresponding attributes
+        fill the attr_names array with the name of the attribute
     */
     for (int attrIndex = 0; attrIndex < srcNoAttrs; attrIndex++) {
         AttrCatEntry attrCatEntryBuffer;
         AttrCacheTable::getAttrCatEntry(srcRelId, attrIndex, &attrCatEntryBuffer);
 
         strcpy (srcAttrNames[attrIndex], attrCatEntryBuffer.attrName);
-        srcAttrTypes[attrIndex] = attrCatEntryBuffer.attrType;
     }
 
-    /* Create the relation for target relation by calling Schema::createRel()
-       by providing appropriate arguments */
-    // if the createRel returns an error code, then return that value.
+    // selecting every attribute is a projection on all of them
+    return Algebra::select(srcRel, targetRel, srcNoAttrs, srcAttrNames, condition);
+}
 
-    ret = Schema::createRel(targetRel, srcNoAttrs, srcAttrNames, srcAttrTypes);
+/*
+    The plan select() and project() read the records of srcRelId with, for a
+    query that needs only the attributes attrNames of the records that satisfy
+    the (resolved) condition: the path AccessPath estimates to be the cheapest
+    and, for a linear search, the number of worker threads it is split over
+    (1 unless a ParallelScan is worth it). EXPLAIN shows the same choice.
+*/
+static int choosePlan(int srcRelId, PredicateNode *condition, int numAttrs, char attrNames[][ATTR_SIZE],
+                      AccessPathEstimate *estimate)
+{
+    int ret = AccessPath::estimate(srcRelId, condition, numAttrs, attrNames, estimate);
     if (ret != SUCCESS) return ret;
 
-    /* Open the newly created target relation by calling OpenRelTable::openRel()
-       method and store the target relid */
-    /* If opening fails, delete the target relation by calling Schema::deleteRel()
-       and return the error value returned from openRel() */
-    int targetRelId = OpenRelTable::openRel(targetRel);
-    if (targetRelId < 0 || targetRelId >= MAX_OPEN) return targetRelId;
+    int numWorkers = WorkerPool::getDefaultWorkers();
+    if (estimate->path == PATH_LINEAR && ParallelScan::worthwhile(srcRelId, numWorkers))
+        estimate->numWorkers = numWorkers;
+
+    return SUCCESS;
+}
 
-    /*** Selecting and inserting records into the target relation ***/
-    /* Before calling the search function, reset the search to start from the
-       first using RelCacheTable::resetSearchIndex() */
-    // RelCacheTable::resetSearchIndex(srcRelId);
+/* used to select the records that satisfy `condition` and project them on
+   tar_Attrs in a single pass: the plan
+       Project(tar_Attrs) <- IndexScan or Scan(srcRel, condition)
+   is run by the executor, which inserts every record it produces straight
+   into targetRel, so no intermediate relation is written. When only one
+   attribute with a B+ tree is read, the plan may be
+       Project(tar_Attrs) <- IndexOnlyScan(srcRel.attr, condition)
+   instead.
+*/
+int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE],
+                    int tar_nAttrs, char tar_Attrs[][ATTR_SIZE], PredicateNode *condition)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
 
-    Attribute record[srcNoAttrs];
+    // look up every attribute of the condition in the attribute cache and
+    // convert every value to the type of its attribute
+    // (returns E_ATTRNOTEXIST or E_ATTRTYPEMISMATCH on failure)
+    int ret = Predicate::resolve(srcRelId, condition);
+    if (ret != SUCCESS) return ret;
 
     /*
-        The BlockAccess::search() function can either do a linearSearch or
-        a B+ tree search. Hence, reset the search index of the relation in the
-        relation cache using RelCacheTable::resetSearchIndex().
-        Also, reset the search index in the attribute cache for the select
-        condition attribute with name given by the argument `attr`. Use
-        AttrCacheTable::resetSearchIndex().
-        Both these calls are necessary to ensure that search begins from the
-        first record.
+        If the condition can be answered from the B+ trees of its attributes,
+        and AccessPath estimates that to read fewer blocks than a scan, the
+        records are looked up in them (an IndexScanOperator checks each one
+        against the whole condition, since an AND may have been answered from
+        the index of just one of its sides).
+
+        If the target attributes and the condition are all on one attribute
+        with a B+ tree, its values may instead be read off the leaf entries
+        of the tree by an IndexOnlyScanOperator, without any record block.
+
+        Otherwise, every record block is scanned once with a ScanCursor, which
+        evaluates the whole condition over a block at a time, and the records
+        selected are projected a batch at a time by the vectorized engine. If
+        there are several worker threads and the relation has enough blocks
+        for all of them, the blocks are read and filtered in parallel by a
+        ParallelScan instead.
     */
+    // project every selected record on the attributes of the target relation
+    // (E_ATTRNOTEXIST if one of them is not in srcRel)
+    AccessPathEstimate estimate;
+    ret = choosePlan(srcRelId, condition, tar_nAttrs, tar_Attrs, &estimate);
+    if (ret != SUCCESS) return ret;
 
-    RelCacheTable::resetSearchIndex(srcRelId);
-    AttrCacheTable::resetSearchIndex(srcRelId, attr);
+    if (estimate.path == PATH_INDEX_ONLY)
+    {
+        ProjectOperator plan (new IndexOnlyScanOperator(srcRelId, tar_Attrs[0], condition), tar_nAttrs, tar_Attrs);
+        return Executor::materialize(&plan, targetRel);
+    }
 
-    // read every record that satisfies the condition by repeatedly calling
-    // BlockAccess::search() until there are no more records to be read
+    if (estimate.path == PATH_BPLUS)
+    {
+        ProjectOperator plan (new IndexScanOperator(srcRelId, condition), tar_nAttrs, tar_Attrs);
+        return Executor::materialize(&plan, targetRel);
+    }
+
+    if (estimate.numWorkers > 1)
+    {
+        BatchProjectOperator plan (new ParallelScanOperator(srcRelId, condition, estimate.numWorkers), tar_nAttrs,
+                                   tar_Attrs);
+        return Executor::materialize(&plan, targetRel);
+    }
+
+    BatchProjectOperator plan (new BatchScanOperator(srcRelId, condition), tar_nAttrs, tar_Attrs);
+    return Executor::materialize(&plan, targetRel);
+}
 
-    while (BlockAccess::search(srcRelId, record, attr, attrVal, op) == SUCCESS) 
+// the records of srcRel that satisfy the condition (all of them if it is
+// nullptr), read the way select() would read them
+static Operator *selectionSource(int srcRelId, PredicateNode *condition, int *ret)
+{
+    *ret = SUCCESS;
+    if (condition == nullptr) return new ScanOperator(srcRelId);
+
+    AccessPathEstimate estimate;
+    *ret = Predicate::resolve(srcRelId, condition);
+    if (*ret == SUCCESS) *ret = AccessPath::estimate(srcRelId, condition, &estimate);
+    if (*ret != SUCCESS) return nullptr;
+
+    if (estimate.path == PATH_BPLUS) return new IndexScanOperator(srcRelId, condition);
+    return new ScanOperator(srcRelId, condition);
+}
+
+/*
+    The records of srcRel that satisfy the condition (all of them if it is
+    nullptr) in the order of the keys, or only the first `limit` of them if
+    limit is not -1:
+        Sort(keys) <- IndexScan or Scan(srcRel, condition)
+    sorts all of them with an ExternalSort, and is cut short by a Limit if
+    there is one. For a limit, two more plans are considered:
+        TopN(keys, limit) <- IndexScan or Scan(srcRel, condition)
+    keeps the best `limit` records in a bounded heap as they are read (if
+    that many fit in OPERATOR_MEMORY_BLOCKS), and, for a single ascending key
+    with a B+ tree,
+        Limit(limit) <- [Filter(condition) <-] IndexOrderScan(srcRel, key)
+    reads the records in order off the leaves, and stops as soon as `limit`
+    of them have been produced. The index walk is taken if fetching the
+    records it is expected to walk (limit / selectivity of the condition,
+    each from its own block) costs less than reading the relation the way
+    select() would.
+*/
+static Operator *orderedSource(int srcRelId, PredicateNode *condition, int nKeys, char keyAttrs[][ATTR_SIZE],
+                               bool descending[], int limit, int *ret)
+{
+    if (limit >= 0 && nKeys == 1 && !descending[0])
     {
-        ret = BlockAccess::insert(targetRelId, record);
+        AttrCatEntry attrCatEntry;
+        *ret = AttrCacheTable::getAttrCatEntry(srcRelId, keyAttrs[0], &attrCatEntry);
+        if (*ret != SUCCESS) return nullptr;
+
+        if (condition != nullptr) *ret = Predicate::resolve(srcRelId, condition);
+        if (*ret != SUCCESS) return nullptr;
 
-        // if (insert fails) {
-        //     close the targetrel(by calling Schema::closeRel(targetrel))
-        //     delete targetrel (by calling Schema::deleteRel(targetrel))
-        //     return ret;
-        // }
+        AccessPathEstimate estimate;
+        *ret = AccessPath::estimate(srcRelId, condition, &estimate);
+        if (*ret != SUCCESS) return nullptr;
 
-        if (ret != SUCCESS) 
+        double scanCost = estimate.path == PATH_BPLUS ? estimate.indexCost : estimate.linearCost;
+        double walked = fmin(limit / fmax(estimate.selectivity, 1.0 / fmax(estimate.numRecords, 1)),
+                             estimate.numRecords);
+        double walkCost = 1 + ceil(log(fmax(estimate.numRecords / (double)MAX_KEYS_LEAF, 1)) / log(MAX_KEYS_INTERNAL)) +
+                          walked / MAX_KEYS_LEAF + walked;
+
+        if (attrCatEntry.rootBlock != -1 && walkCost < scanCost)
         {
-            Schema::closeRel(targetRel);
-            Schema::deleteRel(targetRel);
-            return ret;
+            Operator *source = new IndexOrderScanOperator(srcRelId, keyAttrs[0]);
+            if (condition != nullptr) source = new FilterOperator(source, condition);
+
+            return new LimitOperator(source, limit);
         }
     }
 
-    // Close the targetRel by calling closeRel() method of schema layer
-    Schema::closeRel(targetRel);
+    Operator *source = selectionSource(srcRelId, condition, ret);
+    if (source == nullptr) return nullptr;
 
-    return SUCCESS;
+    if (limit >= 0 && TopNOperator::fits(limit, source->getNumAttrs()))
+        return new TopNOperator(source, limit, nKeys, keyAttrs, descending);
+
+    Operator *sorted = new SortOperator(source, nKeys, keyAttrs, descending);
+    return limit >= 0 ? new LimitOperator(sorted, limit) : sorted;
+}
+
+/* used to select the records that satisfy `condition` into targetRel in the
+   order of the keys (only the first `limit` of them, unless it is -1): the
+   records are read by the plan orderedSource() picks, and targetRel is filled
+   in that order.
+*/
+int Algebra::orderBy(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition,
+                     int nKeys, char keyAttrs[][ATTR_SIZE], bool descending[], int limit)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    // (E_ATTRNOTEXIST if a key is not in srcRel)
+    int ret;
+    Operator *plan = orderedSource(srcRelId, condition, nKeys, keyAttrs, descending, limit, &ret);
+    if (plan == nullptr) return ret;
+
+    ret = Executor::materialize(plan, targetRel);
+    delete plan;
+
+    return ret;
+}
+
+// the same, with the sorted records projected on tar_Attrs
+int Algebra::orderBy(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                     PredicateNode *condition, int nKeys, char keyAttrs[][ATTR_SIZE], bool descending[], int limit)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    int ret;
+    Operator *source = orderedSource(srcRelId, condition, nKeys, keyAttrs, descending, limit, &ret);
+    if (source == nullptr) return ret;
+
+    // (the records are sorted before they are projected, so the keys need
+    // not be among the target attributes)
+    ProjectOperator plan (source, tar_nAttrs, tar_Attrs);
+
+    return Executor::materialize(&plan, targetRel);
+}
+
+/* used to select the first `limit` records that satisfy `condition` (in the
+   order select() reads them) into targetRel: the plan
+       Limit(limit) <- [Project(tar_Attrs) <-] IndexScan or Scan(srcRel, condition)
+   stops asking the scan for records once `limit` of them have been
+   produced, so the blocks after that are never read.
+*/
+int Algebra::limit(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition, int limit)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    int ret;
+    Operator *source = selectionSource(srcRelId, condition, &ret);
+    if (source == nullptr) return ret;
+
+    LimitOperator plan (source, limit);
+
+    return Executor::materialize(&plan, targetRel);
+}
+
+// the same, with the records projected on tar_Attrs
+int Algebra::limit(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                   PredicateNode *condition, int limit)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    int ret;
+    Operator *source = selectionSource(srcRelId, condition, &ret);
+    if (source == nullptr) return ret;
+
+    // (E_ATTRNOTEXIST if a target attribute is not in srcRel)
+    LimitOperator plan (new ProjectOperator(source, tar_nAttrs, tar_Attrs), limit);
+
+    return Executor::materialize(&plan, targetRel);
+}
+
+/* used to compute aggregates over the groups of records of srcRel with the
+   same value of groupAttr. The plan is one of
+       Project(items) <- Aggregate(groupAttr) <- IndexScan or Scan(srcRel, condition)
+       Project(items) <- SortAggregate(groupAttr) <- [Filter(condition) <-] IndexOrderScan(srcRel, groupAttr)
+   or, for COUNT, MIN and MAX without GROUP BY, IndexAggregate(srcRel,
+   condition), which reads no record block at all.
+   The hash aggregation reads the records the way select() would, but has to
+   spill the records of the groups that do not fit in its memory to
+   partitions and read them back. If groupAttr has a B+ tree and there are
+   more groups (estimated by AttrStatsTable) than fit, the records are
+   instead read in order of groupAttr off its leaves, and each group is
+   handed out as soon as it ends, without holding any other in memory.
+*/
+int Algebra::groupBy(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int nItems, int funcs[],
+                     char itemAttrs[][ATTR_SIZE], PredicateNode *condition, char groupAttr[ATTR_SIZE])
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    // the aggregates in the select list (the group attribute is the only
+    // other attribute a grouped record has)
+    int numAggs = 0;
+    int aggFuncs[nItems];
+    char aggAttrs[nItems][ATTR_SIZE];
+
+    for (int item = 0; item < nItems; item++)
+    {
+        if (funcs[item] == AGG_NONE)
+        {
+            if (groupAttr == nullptr || strcmp(itemAttrs[item], groupAttr) != 0) return E_ATTRNOTEXIST;
+            continue;
+        }
+
+        aggFuncs[numAggs] = funcs[item];
+        strcpy(aggAttrs[numAggs], itemAttrs[item]);
+        numAggs++;
+    }
+
+    // without GROUP BY, COUNT, MIN and MAX may be answered from the catalog
+    // and the B+ trees alone
+    if (groupAttr == nullptr && condition != nullptr)
+    {
+        int ret = Predicate::resolve(srcRelId, condition);
+        if (ret != SUCCESS) return ret;
+    }
+
+    bool indexOnly = groupAttr == nullptr &&
+                     IndexAggregateOperator::canAnswer(srcRelId, numAggs, aggFuncs, aggAttrs, condition);
+
+    bool sortedInput = false;
+    if (groupAttr != nullptr)
+    {
+        AttrCatEntry attrCatEntry;
+        int ret = AttrCacheTable::getAttrCatEntry(srcRelId, groupAttr, &attrCatEntry);
+        if (ret != SUCCESS) return ret;
+
+        double numGroups;
+        if (attrCatEntry.rootBlock != -1 &&
+            AttrStatsTable::getNumDistinct(srcRelId, attrCatEntry.offset, &numGroups) == SUCCESS)
+            sortedInput = numGroups > AggregateOperator::getMaxGroups(numAggs);
+    }
+
+    int ret = SUCCESS;
+    AggregateOperator *aggregate;
+
+    if (indexOnly)
+    {
+        aggregate = new IndexAggregateOperator(srcRelId, numAggs, aggFuncs, aggAttrs, condition);
+    }
+    else if (sortedInput)
+    {
+        Operator *source = new IndexOrderScanOperator(srcRelId, groupAttr);
+        if (condition != nullptr) source = new FilterOperator(source, condition);
+
+        aggregate = new SortAggregateOperator(source, groupAttr, numAggs, aggFuncs, aggAttrs);
+    }
+    else
+    {
+        Operator *source = selectionSource(srcRelId, condition, &ret);
+        if (source == nullptr) return ret;
+
+        aggregate = new AggregateOperator(source, groupAttr, numAggs, aggFuncs, aggAttrs);
+    }
+
+    // (E_ATTRNOTEXIST if an attribute is not in srcRel, E_ATTRTYPEMISMATCH
+    // for SUM or AVG of a STRING)
+    ret = aggregate->getStatus();
+    if (ret != SUCCESS)
+    {
+        delete aggregate;
+        return ret;
+    }
+
+    // the target attributes in the order of the select list: the group
+    // attribute comes first out of the aggregate, then the aggregates
+    char targetAttrs[nItems][ATTR_SIZE];
+    int aggIndex = groupAttr == nullptr ? 0 : 1;
+
+    for (int item = 0; item < nItems; item++)
+    {
+        int attrOffset = funcs[item] == AGG_NONE ? 0 : aggIndex++;
+        strcpy(targetAttrs[item], aggregate->getAttr(attrOffset)->attrName);
+    }
+
+    ProjectOperator plan (aggregate, nItems, targetAttrs);
+    return Executor::materialize(&plan, targetRel);
+}
+
+// the names of all the attributes of a relation, in order
+static void getAttrNames(int relId, int numAttrs, char attrNames[][ATTR_SIZE])
+{
+    for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+    {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+        strcpy(attrNames[attrOffset], attrCatEntry.attrName);
+    }
+}
+
+/* used to select the records that satisfy `condition` (all of them if it
+   is nullptr), project them on tar_Attrs, and leave out the duplicates. The
+   plan is one of
+       Distinct <- Project(tar_Attrs) <- IndexScan or Scan(srcRel, condition)
+       SortDistinct <- Project(tar_Attrs) <- IndexOnlyScan(srcRel.attr, condition)
+   The hash-based Distinct reads the records the way select() would, but has
+   to spill the records that do not fit in its memory to partitions and read
+   them back. If the target attributes and the condition are all on one
+   attribute with a B+ tree, and either reading its leaves is the cheapest
+   path or there are more distinct values (estimated by AttrStatsTable) than
+   fit, the values are instead read in order off the leaves, and each run of
+   equal values is skipped as it is walked.
+*/
+int Algebra::distinct(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE],
+                      int tar_nAttrs, char tar_Attrs[][ATTR_SIZE], PredicateNode *condition)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    int ret;
+    if (condition != nullptr)
+    {
+        ret = Predicate::resolve(srcRelId, condition);
+        if (ret != SUCCESS) return ret;
+    }
+
+    AccessPathEstimate estimate;
+    ret = AccessPath::estimate(srcRelId, condition, tar_nAttrs, tar_Attrs, &estimate);
+    if (ret != SUCCESS) return ret;
+
+    bool sortedInput = estimate.path == PATH_INDEX_ONLY;
+    if (!sortedInput && estimate.coveringOffset != -1)
+    {
+        double numDistinct;
+        if (AttrStatsTable::getNumDistinct(srcRelId, estimate.coveringOffset, &numDistinct) == SUCCESS)
+            sortedInput = numDistinct > DistinctOperator::getMaxRecords(tar_nAttrs);
+    }
+
+    Operator *source;
+    if (sortedInput)
+        source = new IndexOnlyScanOperator(srcRelId, tar_Attrs[0], condition);
+    else if (estimate.path == PATH_BPLUS)
+        source = new IndexScanOperator(srcRelId, condition);
+    else
+        source = new ScanOperator(srcRelId, condition);
+
+    // (E_ATTRNOTEXIST if a target attribute is not in srcRel)
+    Operator *projected = new ProjectOperator(source, tar_nAttrs, tar_Attrs);
+
+    if (sortedInput)
+    {
+        SortDistinctOperator plan (projected);
+        return Executor::materialize(&plan, targetRel);
+    }
+
+    DistinctOperator plan (projected);
+    return Executor::materialize(&plan, targetRel);
+}
+
+int Algebra::distinct(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntry);
+
+    char srcAttrNames[relCatEntry.numAttrs][ATTR_SIZE];
+    getAttrNames(srcRelId, relCatEntry.numAttrs, srcAttrNames);
+
+    return Algebra::distinct(srcRel, targetRel, relCatEntry.numAttrs, srcAttrNames, condition);
+}
+
+/*
+   Combine the records of srcRel1 and srcRel2, which must have the same number
+   of attributes (E_NATTRMISMATCH) of the same types (E_ATTRTYPEMISMATCH); the
+   target takes the attribute names of srcRel1. setOp (SetOperation) is one of
+       UNION ALL: Concat(Scan(srcRel1), Scan(srcRel2))
+       UNION:     Distinct <- Concat(Scan(srcRel1), Scan(srcRel2))
+       INTERSECT, EXCEPT:
+                  [Distinct <-] HashSet(Scan(srcRel1), Scan(srcRel2)), or
+                  MergeSet(Sort(Scan(srcRel1)), Sort(Scan(srcRel2)))
+   Each relation is read once. The records of srcRel2 are held in a hash table
+   and srcRel1 is streamed past it if they fit in OPERATOR_MEMORY_BLOCKS;
+   otherwise both are sorted on all their attributes (externally, if need be)
+   and merged.
+*/
+int Algebra::setOperation(char srcRel1[ATTR_SIZE], char srcRel2[ATTR_SIZE], char targetRel[ATTR_SIZE], int setOp)
+{
+    int srcRelId1 = OpenRelTable::getRelId(srcRel1);
+    int srcRelId2 = OpenRelTable::getRelId(srcRel2);
+    if (srcRelId1 == E_RELNOTOPEN || srcRelId2 == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    RelCatEntry relCatEntry1, relCatEntry2;
+    RelCacheTable::getRelCatEntry(srcRelId1, &relCatEntry1);
+    RelCacheTable::getRelCatEntry(srcRelId2, &relCatEntry2);
+
+    // (the operators check that the relations are union-compatible)
+    Operator *left = new ScanOperator(srcRelId1, nullptr);
+    Operator *right = new ScanOperator(srcRelId2, nullptr);
+
+    if (setOp == SET_UNION_ALL || setOp == SET_UNION)
+    {
+        Operator *plan = new ConcatOperator(left, right);
+        if (setOp == SET_UNION) plan = new DistinctOperator(plan);
+
+        int ret = Executor::materialize(plan, targetRel);
+        delete plan;
+        return ret;
+    }
+
+    if (setOp != SET_INTERSECT && setOp != SET_EXCEPT)
+    {
+        delete left;
+        delete right;
+        return E_INVALID;
+    }
+
+    Operator *plan;
+    if (relCatEntry2.numRecs <= DistinctOperator::getMaxRecords(relCatEntry2.numAttrs))
+    {
+        plan = new HashSetOperator(left, right, setOp);
+        if (setOp == SET_EXCEPT) plan = new DistinctOperator(plan);
+    }
+    else
+    {
+        char keyNames1[relCatEntry1.numAttrs][ATTR_SIZE], keyNames2[relCatEntry2.numAttrs][ATTR_SIZE];
+        getAttrNames(srcRelId1, relCatEntry1.numAttrs, keyNames1);
+        getAttrNames(srcRelId2, relCatEntry2.numAttrs, keyNames2);
+
+        // (all ascending)
+        bool descending1[relCatEntry1.numAttrs], descending2[relCatEntry2.numAttrs];
+        for (int attrOffset = 0; attrOffset < relCatEntry1.numAttrs; attrOffset++) descending1[attrOffset] = false;
+        for (int attrOffset = 0; attrOffset < relCatEntry2.numAttrs; attrOffset++) descending2[attrOffset] = false;
+
+        left = new SortOperator(left, relCatEntry1.numAttrs, keyNames1, descending1);
+        right = new SortOperator(right, relCatEntry2.numAttrs, keyNames2, descending2);
+        plan = new MergeSetOperator(left, right, setOp);
+    }
+
+    int ret = Executor::materialize(plan, targetRel);
+    delete plan;
+    return ret;
+}
+
+/*
+   Select the records of srcRel whose attr is (or, if anti, is not) among the
+   values of innerAttr in innerRel, and project them on tar_Attrs (semi-join:
+   attr IN (SELECT innerAttr FROM innerRel); anti-join: NOT IN). A record of
+   srcRel is written at most once, and no joined record is made. The plan is
+   one of
+       Project <- IndexSemiJoin(innerRel.innerAttr) <- Scan(srcRel)
+       Project <- SemiJoin(Project(innerAttr) <- Scan(innerRel)) <- Scan(srcRel)
+       Project <- MergeSemiJoin(Sort <- Project(innerAttr) <- Scan(innerRel))
+                  <- Sort(attr) <- Scan(srcRel)
+   The hash table of SemiJoin is chosen if the distinct values of innerAttr
+   (estimated by AttrStatsTable) fit in OPERATOR_MEMORY_BLOCKS, and the B+
+   tree of innerAttr if it has one and either they do not fit, or a descent
+   per record of srcRel reads fewer blocks than a scan of innerRel. If
+   neither works, both sides are sorted and merged.
+*/
+int Algebra::semiJoin(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                      char attr[ATTR_SIZE], char innerRel[ATTR_SIZE], char innerAttr[ATTR_SIZE], bool anti)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    int innerRelId = OpenRelTable::getRelId(innerRel);
+    if (srcRelId == E_RELNOTOPEN || innerRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    RelCatEntry srcRelCatEntry, innerRelCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    RelCacheTable::getRelCatEntry(innerRelId, &innerRelCatEntry);
+
+    AttrCatEntry innerAttrCatEntry;
+    int ret = AttrCacheTable::getAttrCatEntry(innerRelId, innerAttr, &innerAttrCatEntry);
+    if (ret != SUCCESS) return ret;
+
+    double numDistinct;
+    if (AttrStatsTable::getNumDistinct(innerRelId, innerAttrCatEntry.offset, &numDistinct) != SUCCESS)
+        numDistinct = innerRelCatEntry.numRecs;
+
+    bool fits = numDistinct <= SemiJoinOperator::getMaxValues();
+
+    double scanCost = ceil((double)innerRelCatEntry.numRecs / innerRelCatEntry.numSlotsPerBlk);
+    double probeCost = srcRelCatEntry.numRecs *
+                       (1 + ceil(log(fmax(innerRelCatEntry.numRecs / (double)MAX_KEYS_LEAF, 1)) / log(MAX_KEYS_INTERNAL)));
+
+    Operator *source = new ScanOperator(srcRelId);
+    Operator *filtered;
+
+    if (innerAttrCatEntry.rootBlock != -1 && (!fits || probeCost < scanCost))
+    {
+        filtered = new IndexSemiJoinOperator(source, attr, innerRelId, innerAttr, anti);
+    }
+    else
+    {
+        char innerAttrs[1][ATTR_SIZE];
+        strcpy(innerAttrs[0], innerAttr);
+        Operator *innerValues = new ProjectOperator(new ScanOperator(innerRelId), 1, innerAttrs);
+
+        if (fits)
+        {
+            filtered = new SemiJoinOperator(source, attr, innerValues, anti);
+        }
+        else
+        {
+            char keyAttrs[1][ATTR_SIZE];
+            strcpy(keyAttrs[0], attr);
+            bool descending[1] = {false};
+
+            source = new SortOperator(source, 1, keyAttrs, descending);
+            innerValues = new SortOperator(innerValues, 1, innerAttrs, descending);
+            filtered = new MergeSemiJoinOperator(source, attr, innerValues, anti);
+        }
+    }
+
+    ProjectOperator plan (filtered, tar_nAttrs, tar_Attrs);
+    return Executor::materialize(&plan, targetRel);
+}
+
+int Algebra::semiJoin(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE],
+                      char innerRel[ATTR_SIZE], char innerAttr[ATTR_SIZE], bool anti)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntry);
+
+    char srcAttrNames[relCatEntry.numAttrs][ATTR_SIZE];
+    getAttrNames(srcRelId, relCatEntry.numAttrs, srcAttrNames);
+
+    return Algebra::semiJoin(srcRel, targetRel, relCatEntry.numAttrs, srcAttrNames, attr, innerRel, innerAttr, anti);
+}
+
+/*
+    The plan select() would read the records of srcRel that satisfy the
+    condition with, when every attribute is selected, and the estimates it was
+    chosen on (for EXPLAIN); nothing is read or written.
+*/
+int Algebra::explainSelect(char srcRel[ATTR_SIZE], PredicateNode *condition, AccessPathEstimate *estimate)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntry);
+
+    char srcAttrNames[relCatEntry.numAttrs][ATTR_SIZE];
+    for (int attrIndex = 0; attrIndex < relCatEntry.numAttrs; attrIndex++)
+    {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(srcRelId, attrIndex, &attrCatEntry);
+        strcpy(srcAttrNames[attrIndex], attrCatEntry.attrName);
+    }
+
+    return Algebra::explainSelect(srcRel, relCatEntry.numAttrs, srcAttrNames, condition, estimate);
+}
+
+/*
+    The same, when only tar_Attrs are selected (which may be read off the
+    leaves of a B+ tree by an index-only scan).
+*/
+int Algebra::explainSelect(char srcRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                           PredicateNode *condition, AccessPathEstimate *estimate)
+{
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN) return E_RELNOTOPEN;
+
+    int ret = Predicate::resolve(srcRelId, condition);
+    if (ret != SUCCESS) return ret;
+
+    // (select() reports E_ATTRNOTEXIST for a target attribute not in srcRel)
+    for (int attrIndex = 0; attrIndex < tar_nAttrs; attrIndex++)
+    {
+        AttrCatEntry attrCatEntry;
+        if (AttrCacheTable::getAttrCatEntry(srcRelId, tar_Attrs[attrIndex], &attrCatEntry) != SUCCESS)
+            return E_ATTRNOTEXIST;
+    }
+
+    return choosePlan(srcRelId, condition, tar_nAttrs, tar_Attrs, estimate);
 }
 
 // int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], 
@@ -269,104 +843,28 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
     // if srcRel is not open in open relation table, return E_RELNOTOPEN
     if (srcRelId < 0 || srcRelId >= MAX_OPEN) return E_RELNOTOPEN;
 
-    // get RelCatEntry of srcRel using RelCacheTable::getRelCatEntry()
-    RelCatEntry relCatEntryBuffer;
-    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntryBuffer);
-
-    // get the no. of attributes present in relation from the fetched RelCatEntry.
-    int srcNoAttrs = relCatEntryBuffer.numAttrs;
-
-    // declare attr_offset[tar_nAttrs] an array of type int.
-    // where i-th entry will store the offset in a record of srcRel for the
-    // i-th attribute in the target relation.
-    int attrOffset [tar_nAttrs];
-    // for (int attrIndex = 0; attrIndex < tar_nAttrs; attrIndex++) {
-    //     attrOffset[attrIndex] = AttrCacheTable::getAttributeOffset(srcRelId, tar_Attrs[attrIndex]);
-    //     if (attrOffset[attrIndex] < 0) return attrOffset[attrIndex];
-    // }
-
-    // let attr_types[tar_nAttrs] be an array of type int.
-    // where i-th entry will store the type of the i-th attribute in the target relation.
-    int attrTypes [tar_nAttrs];
-    
-    /*** Checking if attributes of target are present in the source relation
-         and storing its offsets and types ***/
-
-    /*iterate through 0 to tar_nAttrs-1 :
-        - get the attribute catalog entry of the attribute with name tar_attrs[i].
-        - if the attribute is not found return E_ATTRNOTEXIST
-        - fill the attr_offset, attr_types arrays of target relation from the
-          corresponding attribute catalog entries of source relation
-    */
-    
-    for (int attrIndex = 0; attrIndex < tar_nAttrs; attrIndex++) {
-        attrOffset[attrIndex] = AttrCacheTable::getAttributeOffset(srcRelId, tar_Attrs[attrIndex]);
-        if (attrOffset[attrIndex] < 0) return attrOffset[attrIndex];
-
-        AttrCatEntry attrCatEntryBuffer;
-        AttrCacheTable::getAttrCatEntry(srcRelId, tar_Attrs[attrIndex], &attrCatEntryBuffer);
-
-        attrTypes[attrIndex] = attrCatEntryBuffer.attrType;
-    }
-
-    /*** Creating and opening the target relation ***/
-
-    // Create a relation for target relation by calling Schema::createRel()
-    int ret = Schema::createRel(targetRel, tar_nAttrs, tar_Attrs, attrTypes);
-
-    // if the createRel returns an error code, then return that value.
+    // every record of srcRel is read using a ScanOperator (no condition), or
+    // a ParallelScan if it is worth it, and projected on the attributes of
+    // the target relation as it is read (E_ATTRNOTEXIST if one of them is not
+    // in srcRel); a projection on just an attribute with a B+ tree may be
+    // read off its leaves instead
+    AccessPathEstimate estimate;
+    int ret = choosePlan(srcRelId, nullptr, tar_nAttrs, tar_Attrs, &estimate);
     if (ret != SUCCESS) return ret;
 
-    // Open the newly created target relation by calling OpenRelTable::openRel()
-    // and get the target relid
-    int targetRelId = OpenRelTable::openRel(targetRel);
-
-    // If opening fails, delete the target relation by calling Schema::deleteRel()
-    // and return the error value from openRel()
+    Operator *source;
+    if (estimate.path == PATH_INDEX_ONLY)
+        source = new IndexOnlyScanOperator(srcRelId, tar_Attrs[0]);
+    else if (estimate.numWorkers > 1)
+        source = new ParallelScanOperator(srcRelId, nullptr, estimate.numWorkers);
+    else
+        source = new ScanOperator(srcRelId);
 
-    if (targetRelId < 0)
-    {
-        Schema::deleteRel (targetRel);
-        return targetRelId;
-    }
-
-    /*** Inserting projected records into the target relation ***/
-
-    // Take care to reset the searchIndex before calling the project function
-    // using RelCacheTable::resetSearchIndex()
-    RelCacheTable::resetSearchIndex(srcRelId);
-
-    Attribute record[srcNoAttrs];
-
-    while (BlockAccess::project(srcRelId, record) == SUCCESS) {
-        // the variable `record` will contain the next record
-        Attribute proj_record[tar_nAttrs];
-
-        //iterate through 0 to tar_attrs-1:
-        //    proj_record[attr_iter] = record[attr_offset[attr_iter]]
-
-        for (int attrIndex = 0; attrIndex < tar_nAttrs; attrIndex++)
-            proj_record[attrIndex] = record[attrOffset[attrIndex]];
-
-
-        ret = BlockAccess::insert(targetRelId, proj_record);
-
-        if (ret != SUCCESS) {
-            // close the targetrel by calling Schema::closeRel()
-            // delete targetrel by calling Schema::deleteRel()
-            // return ret;
-
-            Schema::closeRel(targetRel);
-            Schema::deleteRel(targetRel);
-
-            return ret;
-        }
-    }
+    ProjectOperator plan (source, tar_nAttrs, tar_Attrs);
 
-    // Close the targetRel by calling Schema::closeRel()
-    Schema::closeRel(targetRel);
-
-    return SUCCESS;
+    // the target relation is created with the attributes of the plan, and
+    // every projected record is inserted into it
+    return Executor::materialize(&plan, targetRel);
 }
 
 int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) 
@@ -376,78 +874,18 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE])
     // if srcRel is not open in open relation table, return E_RELNOTOPEN
     if (srcRelId < 0 || srcRelId >= MAX_OPEN) return E_RELNOTOPEN;
 
-    // get RelCatEntry of srcRel using RelCacheTable::getRelCatEntry()
-    RelCatEntry relCatEntryBuffer;
-    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntryBuffer);
-
-    // get the no. of attributes present in relation from the fetched RelCatEntry.
-    int srcNoAttrs = relCatEntryBuffer.numAttrs;
-
-    // attrNames and attrTypes will be used to store the attribute names
-    // and types of the source relation respectively
-    char attrNames[srcNoAttrs][ATTR_SIZE];
-    int attrTypes[srcNoAttrs];
-
-    /*iterate through every attribute of the source relation :
-        - get the AttributeCat entry of the attribute with offset.
-          (using AttrCacheTable::getAttrCatEntry())
-        - fill the arrays `attrNames` and `attrTypes` that we declared earlier
-          with the data about each attribute
-    */
-
-    for (int attrIndex = 0; attrIndex < srcNoAttrs; attrIndex++) {
-        AttrCatEntry attrCatEntryBuffer;
-        AttrCacheTable::getAttrCatEntry(srcRelId, attrIndex, &attrCatEntryBuffer);
-
-        strcpy (attrNames[attrIndex], attrCatEntryBuffer.attrName);
-        attrTypes[attrIndex] = attrCatEntryBuffer.attrType;
-    }
-
-    /*** Creating and opening the target relation ***/
-
-    // Create a relation for target relation by calling Schema::createRel()
-    int ret = Schema::createRel(targetRel, srcNoAttrs, attrNames, attrTypes);
-    
-    // if the createRel returns an error code, then return that value.
-    if (ret != SUCCESS) return ret;
-
-    // Open the newly created target relation by calling OpenRelTable::openRel()
-    // and get the target relid
-    int targetRelId = OpenRelTable::openRel(targetRel);
-
-    // If opening fails, delete the target relation by calling Schema::deleteRel() of
-    // return the error value returned from openRel().
-    if (targetRelId < 0 || targetRelId >= MAX_OPEN) return targetRelId;
-
-    /*** Inserting projected records into the target relation ***/
-
-    // Take care to reset the searchIndex before calling the project function
-    // using RelCacheTable::resetSearchIndex()
-    RelCacheTable::resetSearchIndex(srcRelId);
-
-    Attribute record[srcNoAttrs];
-
-    while (BlockAccess::project(srcRelId, record) == SUCCESS)
+    // a copy is a scan of every record of srcRel, into a target relation
+    // with the same attributes
+    int numWorkers = WorkerPool::getDefaultWorkers();
+    if (ParallelScan::worthwhile(srcRelId, numWorkers))
     {
-        // record will contain the next record
-
-        ret = BlockAccess::insert(targetRelId, record);
-
-        if (ret != SUCCESS) {
-            // close the targetrel by calling Schema::closeRel()
-            // delete targetrel by calling Schema::deleteRel()
-            // return ret;
-
-            Schema::closeRel(targetRel);
-            Schema::deleteRel(targetRel);
-            return ret;
-        }
+        ParallelScanOperator plan (srcRelId, nullptr, numWorkers);
+        return Executor::materialize(&plan, targetRel);
     }
 
-    // Close the targetRel by calling Schema::closeRel()
-    Schema::closeRel(targetRel);
+    ScanOperator plan (srcRelId);
 
-    return SUCCESS;
+    return Executor::materialize(&plan, targetRel);
 }
 
 // will return if a string can be parsed as a floating point number
@@ -532,6 +970,85 @@ int Algebra::insert(char relName[ATTR_SIZE], int nAttrs, char record[][ATTR_SIZE
 int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], 
             char targetRelation[ATTR_SIZE], char attribute1[ATTR_SIZE], 
             char attribute2[ATTR_SIZE]) 
+{
+    // (an equi-join is a join on the single condition attribute1 = attribute2)
+    char attrsOne[1][ATTR_SIZE], attrsTwo[1][ATTR_SIZE];
+    int ops[1] = {EQ};
+    strcpy(attrsOne[0], attribute1);
+    strcpy(attrsTwo[0], attribute2);
+
+    return Algebra::join(srcRelation1, srcRelation2, targetRelation, 1, attrsOne, ops, attrsTwo);
+}
+
+// whether attrName is the attribute of one of the `=` conditions of a join
+// (attrs holds the attributes of the conditions on the same relation)
+static bool isEquiJoinAttr(char attrName[ATTR_SIZE], int nConds, char attrs[][ATTR_SIZE], int ops[])
+{
+    for (int condIndex = 0; condIndex < nConds; condIndex++)
+        if (ops[condIndex] == EQ && strcmp(attrName, attrs[condIndex]) == 0) return true;
+
+    return false;
+}
+
+int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], 
+            char targetRelation[ATTR_SIZE], int nConds, char attrsOne[][ATTR_SIZE],
+            int ops[], char attrsTwo[][ATTR_SIZE]) 
+{
+    int srcRelId1 = OpenRelTable::getRelId(srcRelation1);
+    int srcRelId2 = OpenRelTable::getRelId(srcRelation2);
+
+    if (srcRelId1 == E_RELNOTOPEN || srcRelId2 == E_RELNOTOPEN)
+        return E_RELNOTOPEN;
+
+    // get the relation catalog entries for the relations from the relation cache
+    // (use RelCacheTable::getRelCatEntry() function)
+    RelCatEntry relCatEntryBuf1, relCatEntryBuf2;
+    RelCacheTable::getRelCatEntry(srcRelId1, &relCatEntryBuf1);
+    RelCacheTable::getRelCatEntry(srcRelId2, &relCatEntryBuf2);
+
+    int numOfAttributes1 = relCatEntryBuf1.numAttrs;
+    int numOfAttributes2 = relCatEntryBuf2.numAttrs;
+
+    //* Note: the attribute of srcRelation2 in an `=` condition is left out of
+    //* the target relation (Why?) -> Because it always holds the same value as
+    //* the attribute of srcRelation1 it is equated to, and should not be
+    //* present twice! (for `<`, `>=`, ... both attributes are kept)
+    int numOfAttributesInTarget = 0;
+    char targetRelAttrNames[numOfAttributes1 + numOfAttributes2][ATTR_SIZE];
+
+    // the target relation has all the attributes of both the source relations,
+    // excluding those (use AttrCacheTable::getAttrCatEntry())
+    for (int attrindex = 0; attrindex < numOfAttributes1; attrindex++)
+    {
+        AttrCatEntry attrcatentry; 
+        AttrCacheTable::getAttrCatEntry(srcRelId1, attrindex, &attrcatentry);
+
+        strcpy(targetRelAttrNames[numOfAttributesInTarget++], attrcatentry.attrName);
+    }
+
+    for (int attrindex = 0; attrindex < numOfAttributes2; attrindex++)
+    {
+        AttrCatEntry attrcatentry; 
+        AttrCacheTable::getAttrCatEntry(srcRelId2, attrindex, &attrcatentry);
+
+        if (isEquiJoinAttr(attrcatentry.attrName, nConds, attrsTwo, ops)) continue;
+
+        strcpy(targetRelAttrNames[numOfAttributesInTarget++], attrcatentry.attrName);
+    }
+
+    return Algebra::join(srcRelation1, srcRelation2, targetRelation, nConds, attrsOne, ops, attrsTwo,
+                         numOfAttributesInTarget, targetRelAttrNames);
+}
+
+/* used to join srcRelation1 and srcRelation2 on the conjunction of the
+   conditions `attrsOne[i] ops[i] attrsTwo[i]` and project every joined record
+   on tar_Attrs in the same pass: only the requested attributes of each
+   matching pair are assembled, and they are written once, straight into
+   targetRelation.
+*/
+int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], 
+            char targetRelation[ATTR_SIZE], int nConds, char attrsOne[][ATTR_SIZE],
+            int ops[], char attrsTwo[][ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE]) 
 {
     // get the srcRelation1's rel-id using OpenRelTable::getRelId() method
     int srcRelId1 = OpenRelTable::getRelId(srcRelation1);
@@ -545,21 +1062,33 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE],
     if (srcRelId1 == E_RELNOTOPEN || srcRelId2 == E_RELNOTOPEN)
         return E_RELNOTOPEN;
 
-    AttrCatEntry attrCatEntry1, attrCatEntry2;
+    if (nConds < 1) return E_INVALID;
 
-    int ret = AttrCacheTable::getAttrCatEntry(srcRelId1, attribute1, &attrCatEntry1);
-    if (ret != SUCCESS) return E_ATTRNOTEXIST;
+    // look up both attributes of every condition
+    AttrCatEntry attrCatEntries1[nConds], attrCatEntries2[nConds];
+    JoinCondition conditions[nConds];
+    int ret;
 
-    ret = AttrCacheTable::getAttrCatEntry(srcRelId2, attribute2, &attrCatEntry2);
-    if (ret != SUCCESS) return E_ATTRNOTEXIST;
+    for (int condIndex = 0; condIndex < nConds; condIndex++)
+    {
+        ret = AttrCacheTable::getAttrCatEntry(srcRelId1, attrsOne[condIndex], &attrCatEntries1[condIndex]);
+        if (ret != SUCCESS) return E_ATTRNOTEXIST;
+
+        ret = AttrCacheTable::getAttrCatEntry(srcRelId2, attrsTwo[condIndex], &attrCatEntries2[condIndex]);
+        if (ret != SUCCESS) return E_ATTRNOTEXIST;
 
-    // if attribute1 and attribute2 are of different types return E_ATTRTYPEMISMATCH
-    if (attrCatEntry1.attrType != attrCatEntry2.attrType)
-        return E_ATTRTYPEMISMATCH;
+        // if the two attributes are of different types return E_ATTRTYPEMISMATCH
+        if (attrCatEntries1[condIndex].attrType != attrCatEntries2[condIndex].attrType)
+            return E_ATTRTYPEMISMATCH;
+
+        conditions[condIndex] = JoinCondition {attrCatEntries1[condIndex].offset, ops[condIndex],
+                                               attrCatEntries2[condIndex].offset,
+                                               attrCatEntries1[condIndex].attrType};
+    }
 
     // TODO: iterate through all the attributes in both the source relations and check if
-    // TODO: there are any other pair of attributes other than join attributes
-    // (i.e. attribute1 and attribute2) with duplicate names in srcRelation1 and
+    // TODO: there are any other pair of attributes other than the attributes of the
+    // `=` join conditions with duplicate names in srcRelation1 and
     // srcRelation2 (use AttrCacheTable::getAttrCatEntry())
     // If yes, return E_DUPLICATEATTR
 
@@ -577,76 +1106,117 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE],
         AttrCatEntry attrCatEntryTemp1;
         AttrCacheTable::getAttrCatEntry(srcRelId1, attrindex1, &attrCatEntryTemp1);
 
-        if (strcmp(attrCatEntryTemp1.attrName, attribute1) == 0) continue;
+        if (isEquiJoinAttr(attrCatEntryTemp1.attrName, nConds, attrsOne, ops)) continue;
         
         for (int attrindex2 = 0; attrindex2 < numOfAttributes2; attrindex2++)
         {
             AttrCatEntry attrCatEntryTemp2;
             AttrCacheTable::getAttrCatEntry(srcRelId2, attrindex2, &attrCatEntryTemp2);
 
-            if (strcmp (attrCatEntryTemp2.attrName, attribute2) == 0) continue;
+            if (isEquiJoinAttr(attrCatEntryTemp2.attrName, nConds, attrsTwo, ops)) continue;
 
             if (strcmp (attrCatEntryTemp1.attrName, attrCatEntryTemp2.attrName) == 0)
                 return E_DUPLICATEATTR;
         }
     }
 
-    // if rel2 does not have an index on attr2
-    //     create it using BPlusTree:bPlusCreate()
-    //     if call fails, return the appropriate error code
-    //     (if your implementation is correct, the only error code that will
-    //      be returned here is E_DISKFULL)
+    // find where each attribute of the target relation comes from: an
+    // attribute of srcRelation1 is taken from there, any other one from
+    // srcRelation2 (this also covers the attribute of srcRelation2 in an `=`
+    // condition, which equals the one of srcRelation1)
+    int targetSrcRel[tar_nAttrs];
+    int targetSrcOffset[tar_nAttrs];
+    int targetRelAttrTypes[tar_nAttrs];
 
-    int rootBlock = attrCatEntry2.rootBlock;
-    if (rootBlock == -1)
+    for (int attrindex = 0; attrindex < tar_nAttrs; attrindex++)
     {
-        ret = BPlusTree::bPlusCreate(srcRelId2, attribute2);
-        if (ret == E_DISKFULL) return E_DISKFULL;
+        AttrCatEntry attrcatentry;
+        targetSrcRel[attrindex] = 1;
+        ret = AttrCacheTable::getAttrCatEntry(srcRelId1, tar_Attrs[attrindex], &attrcatentry);
 
-        rootBlock = attrCatEntry2.rootBlock;
-    }
+        if (ret != SUCCESS)
+        {
+            targetSrcRel[attrindex] = 2;
+            ret = AttrCacheTable::getAttrCatEntry(srcRelId2, tar_Attrs[attrindex], &attrcatentry);
+        }
 
-    int numOfAttributesInTarget = numOfAttributes1 + numOfAttributes2 - 1;
+        if (ret != SUCCESS) return E_ATTRNOTEXIST;
 
-    //* Note: The target relation has number of attributes one less than
-    //* nAttrs1+nAttrs2 (Why?) -> Because one attribute on which EquiJoin is 
-    //* performed should not be present twice!
+        targetSrcOffset[attrindex] = attrcatentry.offset;
+        targetRelAttrTypes[attrindex] = attrcatentry.attrType;
+    }
 
-    // declare the following arrays to store the details of the target relation
-    char targetRelAttrNames[numOfAttributesInTarget][ATTR_SIZE];
-    int targetRelAttrTypes[numOfAttributesInTarget];
+    bool nestedLoopJoin = false, rangeJoin = false;
+    bool hashJoin = false, mergeJoin = false, transientIndexJoin = false;
 
-    // iterate through all the attributes in both the source relations and
-    // update targetRelAttrNames[],targetRelAttrTypes[] arrays excluding attribute2
-    // in srcRelation2 (use AttrCacheTable::getAttrCatEntry())
+    // the records of srcRelation2 that can pair with a record of srcRelation1
+    // are looked up on one condition (the first one, for an equi-join)
+    int lookupCond = 0;
 
-    for (int attrindex = 0; attrindex < numOfAttributes1; attrindex++)
-    {
-        AttrCatEntry attrcatentry; 
-        AttrCacheTable::getAttrCatEntry(srcRelId1, attrindex ,&attrcatentry);
+    // (a TransientIndex on an attribute of srcRelation2 fits in memory)
+    bool transientIndexFits = relCatEntryBuf2.numRecs * sizeof(Index) <= OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE;
 
-        strcpy(targetRelAttrNames[attrindex], attrcatentry.attrName);
-        targetRelAttrTypes[attrindex] = attrcatentry.attrType;
+    if (nConds == 1 && ops[0] == EQ)
+    {
+        int rootBlock1 = attrCatEntries1[0].rootBlock, rootBlock2 = attrCatEntries2[0].rootBlock;
+
+        // if neither relation has an index on its join attribute, hash join them
+        // (building a B+ tree only for this join would read and write the whole
+        // relation, and leave the index behind)
+        hashJoin = rootBlock1 == -1 && rootBlock2 == -1;
+
+        // if both of them have one, merge the leaves of the two indexes in a
+        // single pass, instead of searching rel2's index from the root once per
+        // record of rel1
+        mergeJoin = rootBlock1 != -1 && rootBlock2 != -1;
+
+        // if only rel1 has one, look rel2 up in a TransientIndex on attr2 that is
+        // thrown away after the join (instead of creating a B+ tree on attr2 that
+        // every later insert into rel2 would have to maintain), or hash join them
+        // if the index would not fit in memory
+        transientIndexJoin = rootBlock1 != -1 && rootBlock2 == -1 && transientIndexFits;
+        hashJoin = hashJoin || (rootBlock1 != -1 && rootBlock2 == -1 && !transientIndexFits);
     }
-
-    for (int attrindex = 0, flag = 0; attrindex < numOfAttributes2; attrindex++)
+    else
     {
-        AttrCatEntry attrcatentry; 
-        AttrCacheTable::getAttrCatEntry(srcRelId2, attrindex ,&attrcatentry);
-
-        if (strcmp(attribute2, attrcatentry.attrName) == 0)
+        // for `<`, `<=`, `>`, `>=` (and BETWEEN, which is a `>=` and a `<=`),
+        // the records of srcRelation2 that can pair with a record of
+        // srcRelation1 form a range of values of the attribute of one of the
+        // conditions (preferably an indexed one): look that range up in the
+        // attribute's B+ tree, or in a TransientIndex on it
+        lookupCond = -1;
+        for (int condIndex = 0; condIndex < nConds; condIndex++)
         {
-            flag = 1;
-            continue;
+            if (ops[condIndex] == NE) continue;
+
+            if (lookupCond == -1 ||
+                (attrCatEntries2[lookupCond].rootBlock == -1 && attrCatEntries2[condIndex].rootBlock != -1))
+                lookupCond = condIndex;
         }
 
-        strcpy(targetRelAttrNames[numOfAttributes1 + attrindex-flag], attrcatentry.attrName);
-        targetRelAttrTypes[numOfAttributes1 + attrindex-flag] = attrcatentry.attrType;
-    }    
+        rangeJoin = lookupCond != -1 && (attrCatEntries2[lookupCond].rootBlock != -1 || transientIndexFits);
+
+        // otherwise (e.g. only `!=` conditions) every pair has to be compared,
+        // with a block nested-loop join
+        nestedLoopJoin = !rangeJoin;
+        if (lookupCond == -1) lookupCond = 0;
+    }
+
+    // if all of srcRelation2 fits in the hash table at once, the hash join is
+    // run by the vectorized engine instead: the records of srcRelation1 are
+    // probed against it a batch at a time, and the target attributes gathered
+    // a column at a time (with no partitioning, as nothing has to spill)
+    if (hashJoin && relCatEntryBuf2.numRecs <= BatchHashJoinOperator::getChunkRecords(numOfAttributes2))
+    {
+        BatchHashJoinOperator *batchJoin = new BatchHashJoinOperator(new BatchScanOperator(srcRelId1),
+                                                                     new BatchScanOperator(srcRelId2),
+                                                                     attrsOne[0], attrsTwo[0]);
+        BatchProjectOperator plan (batchJoin, tar_nAttrs, tar_Attrs);
+        return Executor::materialize(&plan, targetRelation);
+    }
 
     // create the target relation using the Schema::createRel() function
-    ret = Schema::createRel(targetRelation, numOfAttributesInTarget, 
-                                targetRelAttrNames, targetRelAttrTypes);
+    ret = Schema::createRel(targetRelation, tar_nAttrs, tar_Attrs, targetRelAttrTypes);
 
     // if createRel() returns an error, return that error
     if (ret != SUCCESS) return ret;
@@ -664,62 +1234,324 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE],
         return targetRelId;
     }
 
-    Attribute record1[numOfAttributes1];
-    Attribute record2[numOfAttributes2];
-    Attribute targetRecord[numOfAttributesInTarget];
+    AttrCatEntry &attrCatEntry1 = attrCatEntries1[lookupCond], &attrCatEntry2 = attrCatEntries2[lookupCond];
+
+    JoinInput input1 {srcRelId1, numOfAttributes1, relCatEntryBuf1.numRecs, "",
+                      attrCatEntry1.offset, attrCatEntry1.attrType, attrCatEntry1.rootBlock};
+    JoinInput input2 {srcRelId2, numOfAttributes2, relCatEntryBuf2.numRecs, "",
+                      attrCatEntry2.offset, attrCatEntry2.attrType, attrCatEntry2.rootBlock};
+    strcpy(input1.attrName, attrCatEntry1.attrName);
+    strcpy(input2.attrName, attrCatEntry2.attrName);
+
+    JoinTarget target {targetRelId, tar_nAttrs, targetSrcRel, targetSrcOffset};
+
+    if (nestedLoopJoin)
+        ret = Join::blockNestedLoopJoin(&input1, &input2, nConds, conditions, &target);
+    else if (rangeJoin)
+        ret = Join::rangeJoin(&input1, &input2, nConds, conditions, &target);
+    else if (hashJoin)
+        ret = Join::hashJoin(&input1, &input2, &target);
+    else if (mergeJoin)
+        ret = Join::sortMergeJoin(&input1, &input2, &target);
+    else if (transientIndexJoin)
+        ret = Join::transientIndexJoin(&input1, &input2, &target);
+    else
+        ret = Join::indexNestedLoopJoin(&input1, &input2, &target);
+
+    // close the target relation by calling OpenRelTable::closeRel()
+    OpenRelTable::closeRel(targetRelId);
+
+    // if the join fails (insert should fail only due to DISK being FULL)
+    // delete targetRelation (by calling Schema::deleteRel())
+    if (ret != SUCCESS)
+    {
+        Schema::deleteRel(targetRelation);
+        return ret;
+    }
+
+    return SUCCESS;
+}
+
+/* looks up the relations of a multi-way join and turns its conditions
+   `relsOne[i].attrsOne[i] ops[i] relsTwo[i].attrsTwo[i]` into edges between
+   them (edge.rel1 and edge.rel2 index srcRelations)
+*/
+static int resolveMultiJoin(int numRels, char srcRelations[][ATTR_SIZE], int nConds,
+                            char relsOne[][ATTR_SIZE], char attrsOne[][ATTR_SIZE], int ops[],
+                            char relsTwo[][ATTR_SIZE], char attrsTwo[][ATTR_SIZE],
+                            int relIds[], JoinEdge edges[])
+{
+    if (numRels < 2 || numRels > MAX_JOIN_RELATIONS) return E_INVALID;
+
+    for (int relIndex = 0; relIndex < numRels; relIndex++)
+    {
+        // a relation can only appear once in the join
+        for (int prevIndex = 0; prevIndex < relIndex; prevIndex++)
+            if (strcmp(srcRelations[prevIndex], srcRelations[relIndex]) == 0) return E_INVALID;
+
+        relIds[relIndex] = OpenRelTable::getRelId(srcRelations[relIndex]);
+        if (relIds[relIndex] == E_RELNOTOPEN) return E_RELNOTOPEN;
+    }
+
+    for (int condIndex = 0; condIndex < nConds; condIndex++)
+    {
+        int rel1 = -1, rel2 = -1;
+        for (int relIndex = 0; relIndex < numRels; relIndex++)
+        {
+            if (strcmp(srcRelations[relIndex], relsOne[condIndex]) == 0) rel1 = relIndex;
+            if (strcmp(srcRelations[relIndex], relsTwo[condIndex]) == 0) rel2 = relIndex;
+        }
+
+        // both sides of a condition must be (different) relations of the join
+        if (rel1 == -1 || rel2 == -1 || rel1 == rel2) return E_INVALID;
+
+        AttrCatEntry attrCatEntry1, attrCatEntry2;
+        if (AttrCacheTable::getAttrCatEntry(relIds[rel1], attrsOne[condIndex], &attrCatEntry1) != SUCCESS ||
+            AttrCacheTable::getAttrCatEntry(relIds[rel2], attrsTwo[condIndex], &attrCatEntry2) != SUCCESS)
+            return E_ATTRNOTEXIST;
+
+        if (attrCatEntry1.attrType != attrCatEntry2.attrType) return E_ATTRTYPEMISMATCH;
+
+        edges[condIndex] = JoinEdge {rel1, attrCatEntry1.offset, ops[condIndex], rel2, attrCatEntry2.offset,
+                                     attrCatEntry1.attrType};
+    }
+
+    return SUCCESS;
+}
+
+// whether the attribute at attrOffset of the relation at relIndex is equated,
+// by an `=` condition, to an attribute of a relation before it in the join
+// (it is then left out of the target relation, like attribute2 of join())
+static bool isEquatedToEarlier(int relIndex, int attrOffset, int nConds, JoinEdge edges[])
+{
+    for (int condIndex = 0; condIndex < nConds; condIndex++)
+    {
+        JoinEdge *edge = &edges[condIndex];
+        if (edge->op != EQ) continue;
+
+        if ((edge->rel2 == relIndex && edge->attrOffset2 == attrOffset && edge->rel1 < relIndex) ||
+            (edge->rel1 == relIndex && edge->attrOffset1 == attrOffset && edge->rel2 < relIndex))
+            return true;
+    }
+
+    return false;
+}
+
+int Algebra::multiJoin(int numRels, char srcRelations[][ATTR_SIZE], char targetRelation[ATTR_SIZE],
+                       int nConds, char relsOne[][ATTR_SIZE], char attrsOne[][ATTR_SIZE], int ops[],
+                       char relsTwo[][ATTR_SIZE], char attrsTwo[][ATTR_SIZE])
+{
+    int relIds[numRels > 0 ? numRels : 1];
+    JoinEdge edges[nConds > 0 ? nConds : 1];
+
+    int ret = resolveMultiJoin(numRels, srcRelations, nConds, relsOne, attrsOne, ops, relsTwo, attrsTwo,
+                               relIds, edges);
+    if (ret != SUCCESS) return ret;
+
+    // the target relation has all the attributes of the source relations, in
+    // order, except those equated to an attribute of an earlier relation
+    int totalAttrs = 0;
+    for (int relIndex = 0; relIndex < numRels; relIndex++)
+    {
+        RelCatEntry relCatEntry;
+        RelCacheTable::getRelCatEntry(relIds[relIndex], &relCatEntry);
+        totalAttrs += relCatEntry.numAttrs;
+    }
+
+    int numOfAttributesInTarget = 0;
+    char targetRelAttrNames[totalAttrs][ATTR_SIZE];
+
+    for (int relIndex = 0; relIndex < numRels; relIndex++)
+    {
+        RelCatEntry relCatEntry;
+        RelCacheTable::getRelCatEntry(relIds[relIndex], &relCatEntry);
+
+        for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+        {
+            if (isEquatedToEarlier(relIndex, attrOffset, nConds, edges)) continue;
+
+            AttrCatEntry attrCatEntry;
+            AttrCacheTable::getAttrCatEntry(relIds[relIndex], attrOffset, &attrCatEntry);
+            strcpy(targetRelAttrNames[numOfAttributesInTarget++], attrCatEntry.attrName);
+        }
+    }
+
+    return Algebra::multiJoin(numRels, srcRelations, targetRelation, nConds, relsOne, attrsOne, ops,
+                              relsTwo, attrsTwo, numOfAttributesInTarget, targetRelAttrNames);
+}
 
-    // this loop is to get every record of the srcRelation1 one by one
-    RelCacheTable::resetSearchIndex(srcRelId1);
+/* used to join all of srcRelations at once, on the conjunction of the
+   conditions `relsOne[i].attrsOne[i] ops[i] relsTwo[i].attrsTwo[i]`, into
+   targetRelation (projected on tar_Attrs). JoinPlanner picks the order in
+   which the relations are joined and how each of them is accessed, and the
+   joined tuples are pipelined from one relation to the next, so no
+   intermediate relation is ever written to the disk.
+*/
+int Algebra::multiJoin(int numRels, char srcRelations[][ATTR_SIZE], char targetRelation[ATTR_SIZE],
+                       int nConds, char relsOne[][ATTR_SIZE], char attrsOne[][ATTR_SIZE], int ops[],
+                       char relsTwo[][ATTR_SIZE], char attrsTwo[][ATTR_SIZE],
+                       int tar_nAttrs, char tar_Attrs[][ATTR_SIZE])
+{
+    int relIds[numRels > 0 ? numRels : 1];
+    JoinEdge edges[nConds > 0 ? nConds : 1];
 
-    while (BlockAccess::project(srcRelId1, record1) == SUCCESS) 
+    int ret = resolveMultiJoin(numRels, srcRelations, nConds, relsOne, attrsOne, ops, relsTwo, attrsTwo,
+                               relIds, edges);
+    if (ret != SUCCESS) return ret;
+
+    JoinInput inputs[numRels];
+    for (int relIndex = 0; relIndex < numRels; relIndex++)
     {
-        // reset the search index of `srcRelation2` in the relation cache
-        // using RelCacheTable::resetSearchIndex()
-        RelCacheTable::resetSearchIndex(srcRelId2);
+        RelCatEntry relCatEntry;
+        RelCacheTable::getRelCatEntry(relIds[relIndex], &relCatEntry);
 
-        // reset the search index of `attribute2` in the attribute cache
-        // using AttrCacheTable::resetSearchIndex()
-        AttrCacheTable::resetSearchIndex(srcRelId2, attribute2);
+        inputs[relIndex] = JoinInput {relIds[relIndex], relCatEntry.numAttrs, relCatEntry.numRecs, "", -1, -1, -1};
+    }
 
-        // this loop is to get every record of the srcRelation2 which satisfies
-        //the following condition:
-        // record1.attribute1 = record2.attribute2 (i.e. Equi-Join condition)
-        while (BlockAccess::search(srcRelId2, record2, attribute2, 
-                                    record1[attrCatEntry1.offset], EQ) == SUCCESS) 
+    // apart from those equated to an attribute of an earlier relation, no two
+    // attributes of the source relations may have the same name
+    for (int relIndex = 0; relIndex < numRels; relIndex++)
+    {
+        for (int attrOffset = 0; attrOffset < inputs[relIndex].numAttrs; attrOffset++)
         {
-            // copy srcRelation1's and srcRelation2's attribute values(except
-            // for attribute2 in rel2) from record1 and record2 to targetRecord
-            for (int attrindex = 0; attrindex < numOfAttributes1; attrindex++)
-                targetRecord[attrindex] = record1[attrindex];
+            if (isEquatedToEarlier(relIndex, attrOffset, nConds, edges)) continue;
 
-            for (int attrindex = 0, flag = 0; attrindex < numOfAttributes2; attrindex++)
+            AttrCatEntry attrCatEntry;
+            AttrCacheTable::getAttrCatEntry(relIds[relIndex], attrOffset, &attrCatEntry);
+
+            for (int prevIndex = 0; prevIndex < relIndex; prevIndex++)
             {
-                if (attrindex == attrCatEntry2.offset)
-                {
-                    flag = 1;
-                    continue;
-                }
-                targetRecord[attrindex + numOfAttributes1-flag] = record2[attrindex];
+                AttrCatEntry prevAttrCatEntry;
+                if (AttrCacheTable::getAttrCatEntry(relIds[prevIndex], attrCatEntry.attrName, &prevAttrCatEntry) == SUCCESS &&
+                    !isEquatedToEarlier(prevIndex, prevAttrCatEntry.offset, nConds, edges))
+                    return E_DUPLICATEATTR;
             }
+        }
+    }
+
+    // find the relation and offset each attribute of the target relation comes
+    // from (an attribute left out of `*` can still be asked for by name)
+    int targetSrcRelIndex[tar_nAttrs];
+    int targetSrcOffset[tar_nAttrs];
+    int targetRelAttrTypes[tar_nAttrs];
 
-            // insert the current record into the target relation by calling
-            // BlockAccess::insert()
-            ret = BlockAccess::insert(targetRelId, targetRecord);
+    for (int attrindex = 0; attrindex < tar_nAttrs; attrindex++)
+    {
+        targetSrcRelIndex[attrindex] = -1;
 
-            // if insert fails (insert should fail only due to DISK being FULL)
-            if (ret == E_DISKFULL)
+        for (int pass = 0; pass < 2 && targetSrcRelIndex[attrindex] == -1; pass++)
+        {
+            for (int relIndex = 0; relIndex < numRels; relIndex++)
             {
-                // close the target relation by calling OpenRelTable::closeRel()
-                ret = OpenRelTable::closeRel(targetRelId);
+                AttrCatEntry attrCatEntry;
+                if (AttrCacheTable::getAttrCatEntry(relIds[relIndex], tar_Attrs[attrindex], &attrCatEntry) != SUCCESS)
+                    continue;
 
-                // delete targetRelation (by calling Schema::deleteRel())
-                ret = Schema::deleteRel(targetRelation);
+                // (the first pass only looks at attributes that are not left out)
+                if (pass == 0 && isEquatedToEarlier(relIndex, attrCatEntry.offset, nConds, edges)) continue;
 
-                return E_DISKFULL;
+                targetSrcRelIndex[attrindex] = relIndex;
+                targetSrcOffset[attrindex] = attrCatEntry.offset;
+                targetRelAttrTypes[attrindex] = attrCatEntry.attrType;
+                break;
             }
         }
+
+        if (targetSrcRelIndex[attrindex] == -1) return E_ATTRNOTEXIST;
+    }
+
+    JoinPlan plan;
+    ret = JoinPlanner::plan(numRels, inputs, nConds, edges, &plan);
+    if (ret != SUCCESS) return ret;
+
+    // lay the steps of the pipeline out in the order of the plan: the records
+    // of each relation go after those of the relations joined in before it
+    JoinStep steps[numRels];
+    int stepOf[numRels];
+    for (int relIndex = 0; relIndex < numRels; relIndex++)
+        stepOf[relIndex] = numRels;
+
+    JoinCondition conditions[numRels][nConds > 0 ? nConds : 1];
+    int tupleOffset = 0;
+
+    for (int stepIndex = 0; stepIndex < numRels; stepIndex++)
+    {
+        int relIndex = plan.order[stepIndex];
+        stepOf[relIndex] = stepIndex;
+
+        JoinStep &step = steps[stepIndex];
+        step.input = inputs[relIndex];
+        step.access = plan.access[stepIndex];
+        step.tupleOffset = tupleOffset;
+        step.numConditions = 0;
+        step.conditions = conditions[stepIndex];
+        step.lookupCond = -1;
+
+        tupleOffset += inputs[relIndex].numAttrs;
+
+        // the conditions with the relations joined in before, written as
+        // `tuple attribute op attribute of this relation`
+        for (int condIndex = 0; condIndex < nConds; condIndex++)
+        {
+            JoinEdge *edge = &edges[condIndex];
+            JoinCondition condition;
+
+            if (edge->rel2 == relIndex && stepOf[edge->rel1] < stepIndex)
+                condition = JoinCondition {steps[stepOf[edge->rel1]].tupleOffset + edge->attrOffset1, edge->op,
+                                           edge->attrOffset2, edge->attrType};
+            else if (edge->rel1 == relIndex && stepOf[edge->rel2] < stepIndex)
+                condition = JoinCondition {steps[stepOf[edge->rel2]].tupleOffset + edge->attrOffset2,
+                                           Predicate::flipOperator(edge->op), edge->attrOffset1, edge->attrType};
+            else
+                continue;
+
+            if (condIndex == plan.lookupEdge[stepIndex]) step.lookupCond = step.numConditions;
+            step.conditions[step.numConditions++] = condition;
+        }
+
+        // the lookup attribute of the relation
+        if (step.lookupCond != -1)
+        {
+            AttrCatEntry attrCatEntry;
+            AttrCacheTable::getAttrCatEntry(step.input.relId, step.conditions[step.lookupCond].attrOffset2, &attrCatEntry);
+
+            strcpy(step.input.attrName, attrCatEntry.attrName);
+            step.input.attrOffset = attrCatEntry.offset;
+            step.input.attrType = attrCatEntry.attrType;
+            step.input.rootBlock = attrCatEntry.rootBlock;
+        }
+    }
+
+    int targetSrcRel[tar_nAttrs];
+    for (int attrindex = 0; attrindex < tar_nAttrs; attrindex++)
+    {
+        targetSrcRel[attrindex] = 1;
+        targetSrcOffset[attrindex] += steps[stepOf[targetSrcRelIndex[attrindex]]].tupleOffset;
+    }
+
+    // create the target relation using the Schema::createRel() function
+    ret = Schema::createRel(targetRelation, tar_nAttrs, tar_Attrs, targetRelAttrTypes);
+    if (ret != SUCCESS) return ret;
+
+    int targetRelId = OpenRelTable::openRel(targetRelation);
+    if (targetRelId < 0)
+    {
+        Schema::deleteRel(targetRelation);
+        return targetRelId;
+    }
+
+    JoinTarget target {targetRelId, tar_nAttrs, targetSrcRel, targetSrcOffset};
+    ret = Join::pipelinedJoin(numRels, steps, &target);
+
+    OpenRelTable::closeRel(targetRelId);
+
+    // if the join fails (insert should fail only due to DISK being FULL)
+    // delete targetRelation (by calling Schema::deleteRel())
+    if (ret != SUCCESS)
+    {
+        Schema::deleteRel(targetRelation);
+        return ret;
     }
 
-    // close the target relation by calling OpenRelTable::closeRel()
     return SUCCESS;
-}
\ No newline at end of file
+}
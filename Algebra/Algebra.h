@@ -2,6 +2,8 @@
 #define NITCBASE_ALGEBRA_H
 
 #include "../Cache/OpenRelTable.h"
+#include "../Executor/AggregateOperator.h"
+#include "../Executor/SetOperator.h"
 #include "../Schema/Schema.h"
 #include "../define/constants.h"
 
@@ -13,6 +15,59 @@ class Algebra {
   // Select
   static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]);
 
+  // Select (WHERE clause with AND/OR)
+  static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition);
+
+  // Select + Project, in a single pass
+  static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                    PredicateNode *condition);
+
+  // Select (on a condition, or all the records if it is nullptr), sorted on
+  // the keys, each ascending or descending (ORDER BY), keeping only the first
+  // `limit` records unless it is -1 (ORDER BY ... LIMIT)
+  static int orderBy(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition,
+                     int nKeys, char keyAttrs[][ATTR_SIZE], bool descending[], int limit = -1);
+
+  // Select + Project, sorted on the keys (which need not be projected)
+  static int orderBy(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                     PredicateNode *condition, int nKeys, char keyAttrs[][ATTR_SIZE], bool descending[],
+                     int limit = -1);
+
+  // Select (+ Project), keeping only the first `limit` records (LIMIT)
+  static int limit(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition, int limit);
+  static int limit(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                   PredicateNode *condition, int limit);
+
+  // Aggregates of the records that satisfy the condition (all of them if it
+  // is nullptr), one record per value of groupAttr (or a single one over all
+  // the records if groupAttr is nullptr): the i-th target attribute is
+  // funcs[i] (AggregateFunction) of itemAttrs[i], or, for AGG_NONE, the
+  // group attribute itself (GROUP BY)
+  static int groupBy(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int nItems, int funcs[],
+                     char itemAttrs[][ATTR_SIZE], PredicateNode *condition, char groupAttr[ATTR_SIZE]);
+
+  // Select + Project, without duplicate records (DISTINCT)
+  static int distinct(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], PredicateNode *condition);
+  static int distinct(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                      PredicateNode *condition);
+
+  // UNION [ALL], INTERSECT or EXCEPT (setOp, a SetOperation) of two
+  // union-compatible relations
+  static int setOperation(char srcRel1[ATTR_SIZE], char srcRel2[ATTR_SIZE], char targetRel[ATTR_SIZE], int setOp);
+
+  // Select (+ Project) the records whose attr is (or, if anti, is not) among
+  // the values of innerAttr in innerRel (semi-join: IN, EXISTS; anti-join:
+  // NOT IN, NOT EXISTS)
+  static int semiJoin(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE],
+                      char innerRel[ATTR_SIZE], char innerAttr[ATTR_SIZE], bool anti);
+  static int semiJoin(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                      char attr[ATTR_SIZE], char innerRel[ATTR_SIZE], char innerAttr[ATTR_SIZE], bool anti);
+
+  // the plan select() would read the records with for the condition (EXPLAIN)
+  static int explainSelect(char srcRel[ATTR_SIZE], PredicateNode *condition, AccessPathEstimate *estimate);
+  static int explainSelect(char srcRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+                           PredicateNode *condition, AccessPathEstimate *estimate);
+
   // Project all (Copy)
   static int project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]);
 
@@ -22,6 +77,27 @@ class Algebra {
   // Join
   static int join(char srcRelOne[ATTR_SIZE], char srcRelTwo[ATTR_SIZE], char targetRel[ATTR_SIZE],
                   char attrOne[ATTR_SIZE], char attrTwo[ATTR_SIZE]);
+
+  // Join, on the conjunction of the conditions attrsOne[i] ops[i] attrsTwo[i]
+  static int join(char srcRelOne[ATTR_SIZE], char srcRelTwo[ATTR_SIZE], char targetRel[ATTR_SIZE],
+                  int nConds, char attrsOne[][ATTR_SIZE], int ops[], char attrsTwo[][ATTR_SIZE]);
+
+  // Join (on the conjunction of the conditions) + Project, in a single pass
+  static int join(char srcRelOne[ATTR_SIZE], char srcRelTwo[ATTR_SIZE], char targetRel[ATTR_SIZE],
+                  int nConds, char attrsOne[][ATTR_SIZE], int ops[], char attrsTwo[][ATTR_SIZE],
+                  int tar_nAttrs, char tar_Attrs[][ATTR_SIZE]);
+
+  // Join all of srcRels at once, on the conjunction of the conditions
+  // relsOne[i].attrsOne[i] ops[i] relsTwo[i].attrsTwo[i] (see JoinPlanner)
+  static int multiJoin(int numRels, char srcRels[][ATTR_SIZE], char targetRel[ATTR_SIZE],
+                       int nConds, char relsOne[][ATTR_SIZE], char attrsOne[][ATTR_SIZE], int ops[],
+                       char relsTwo[][ATTR_SIZE], char attrsTwo[][ATTR_SIZE]);
+
+  // Multi-way join + Project, in a single pass
+  static int multiJoin(int numRels, char srcRels[][ATTR_SIZE], char targetRel[ATTR_SIZE],
+                       int nConds, char relsOne[][ATTR_SIZE], char attrsOne[][ATTR_SIZE], int ops[],
+                       char relsTwo[][ATTR_SIZE], char attrsTwo[][ATTR_SIZE],
+                       int tar_nAttrs, char tar_Attrs[][ATTR_SIZE]);
 };
 
 inline bool isNumber(char *str);
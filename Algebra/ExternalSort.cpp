@@ -0,0 +1,260 @@
+#include "ExternalSort.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// the number of runs merged at once (one block is kept for the merged run)
+static const int MERGE_FAN_IN = OPERATOR_MEMORY_BLOCKS - 1;
+
+ExternalSort::ExternalSort(int numAttrs, int numKeys, SortKey keys[])
+{
+	this->numAttrs = numAttrs;
+	this->keys.assign(keys, keys + numKeys);
+
+	capacity = (OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE) / (numAttrs * ATTR_SIZE);
+	numBuffered = 0, position = 0;
+	buffer = nullptr, order = nullptr, heads = nullptr;
+}
+
+ExternalSort::ExternalSort(int numAttrs, int attrOffset, int attrType)
+{
+	this->numAttrs = numAttrs;
+	keys.push_back(SortKey {attrOffset, attrType, false});
+
+	capacity = (OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE) / (numAttrs * ATTR_SIZE);
+	numBuffered = 0, position = 0;
+	buffer = nullptr, order = nullptr, heads = nullptr;
+}
+
+// < 0 if the record lhs comes before the record rhs, > 0 if after, 0 if their keys are equal
+int ExternalSort::compare(Attribute *lhs, Attribute *rhs)
+{
+	for (SortKey &key : keys)
+	{
+		int diff = compareAttrs(lhs[key.attrOffset], rhs[key.attrOffset], key.attrType);
+		if (diff != 0) return key.descending ? -diff : diff;
+	}
+
+	return 0;
+}
+
+int ExternalSort::add(Attribute *record)
+{
+	// (the memory is only taken when the first record comes in)
+	if (buffer == nullptr)
+	{
+		buffer = (Attribute *)malloc(capacity * numAttrs * sizeof(Attribute));
+		order = (int *)malloc(capacity * sizeof(int));
+		if (buffer == nullptr || order == nullptr) return FAILURE;
+	}
+
+	if (numBuffered == capacity)
+	{
+		int ret = writeRun();
+		if (ret != SUCCESS) return ret;
+	}
+
+	memcpy(buffer + numBuffered * numAttrs, record, numAttrs * sizeof(Attribute));
+	numBuffered++;
+
+	return SUCCESS;
+}
+
+// sorts the positions of the records in memory on the keys
+int ExternalSort::sortBuffer()
+{
+	for (int index = 0; index < numBuffered; index++)
+		order[index] = index;
+
+	std::stable_sort(order, order + numBuffered, [this](int lhs, int rhs) {
+		return compare(buffer + lhs * numAttrs, buffer + rhs * numAttrs) < 0;
+	});
+
+	position = 0;
+	return SUCCESS;
+}
+
+// writes the records in memory out, in sorted order, as a new run
+int ExternalSort::writeRun()
+{
+	sortBuffer();
+
+	runs.push_back(SpillFile(numAttrs));
+	SpillFile &run = runs.back();
+
+	for (int index = 0; index < numBuffered; index++)
+	{
+		int ret = run.append(buffer + order[index] * numAttrs);
+		if (ret != SUCCESS) return ret;
+	}
+
+	numBuffered = 0;
+	return SUCCESS;
+}
+
+int ExternalSort::sort()
+{
+	// everything fit in memory: just sort it there
+	if (runs.empty())
+		return sortBuffer();
+
+	// otherwise the rest goes out as the last run, and the runs are merged
+	if (numBuffered > 0)
+	{
+		int ret = writeRun();
+		if (ret != SUCCESS) return ret;
+	}
+
+	free(buffer), free(order);
+	buffer = nullptr, order = nullptr;
+
+	while ((int)runs.size() > MERGE_FAN_IN)
+	{
+		int ret = mergePass();
+		if (ret != SUCCESS) return ret;
+	}
+
+	return startMerge();
+}
+
+int ExternalSort::next(Attribute *record)
+{
+	if (runs.empty())
+	{
+		if (position >= numBuffered) return E_NOTFOUND;
+
+		memcpy(record, buffer + order[position++] * numAttrs, numAttrs * sizeof(Attribute));
+		return SUCCESS;
+	}
+
+	return nextMerged(record);
+}
+
+/*
+    Whether the current record of `run` wins its match against that of
+    `otherRun`. The index runs.size() stands for a run that beats every other
+    (it fills the tree before the real runs are played in), and a run that
+    has been read to the end loses to every other. Equal keys are won by the
+    earlier run, which holds the records that were added first.
+*/
+bool ExternalSort::beats(int run, int otherRun)
+{
+	int numRuns = runs.size();
+
+	if (run == numRuns) return true;
+	if (otherRun == numRuns) return false;
+	if (!headValid[run]) return false;
+	if (!headValid[otherRun]) return true;
+
+	int diff = compare(heads + run * numAttrs, heads + otherRun * numAttrs);
+	return diff < 0 || (diff == 0 && run < otherRun);
+}
+
+// plays the current record of `run` up from its leaf to the root: at every
+// node the loser stays and the winner moves on
+void ExternalSort::replay(int run)
+{
+	int numRuns = runs.size();
+	int winner = run;
+
+	// (the leaf of run r is node numRuns + r, and the parent of node n is n / 2)
+	for (int node = (numRuns + run) / 2; node > 0; node /= 2)
+	{
+		if (beats(tree[node], winner))
+			std::swap(tree[node], winner);
+	}
+
+	tree[0] = winner;
+}
+
+// reads the first record of every run and builds the loser tree over them
+int ExternalSort::startMerge()
+{
+	int numRuns = runs.size();
+
+	free(heads);
+	heads = (Attribute *)malloc(numRuns * numAttrs * sizeof(Attribute));
+	if (heads == nullptr) return FAILURE;
+
+	headValid.assign(numRuns, false);
+	for (int run = 0; run < numRuns; run++)
+		headValid[run] = runs[run].next(heads + run * numAttrs) == SUCCESS;
+
+	tree.assign(numRuns, numRuns);
+	for (int run = numRuns - 1; run >= 0; run--)
+		replay(run);
+
+	return SUCCESS;
+}
+
+int ExternalSort::nextMerged(Attribute *record)
+{
+	int winner = tree[0];
+	if (!headValid[winner]) return E_NOTFOUND;
+
+	memcpy(record, heads + winner * numAttrs, numAttrs * sizeof(Attribute));
+
+	headValid[winner] = runs[winner].next(heads + winner * numAttrs) == SUCCESS;
+	replay(winner);
+
+	return SUCCESS;
+}
+
+// merges every MERGE_FAN_IN consecutive runs into one (so that the runs
+// stay in the order their records were added in)
+int ExternalSort::mergePass()
+{
+	std::vector<SpillFile> pending;
+	pending.swap(runs);
+
+	std::vector<SpillFile> merged;
+	Attribute record[numAttrs];
+	int ret = SUCCESS;
+
+	int start = 0;
+	while (ret == SUCCESS && start < (int)pending.size())
+	{
+		int end = std::min(start + MERGE_FAN_IN, (int)pending.size());
+		runs.assign(pending.begin() + start, pending.begin() + end);
+
+		SpillFile out (numAttrs);
+		ret = startMerge();
+
+		while (ret == SUCCESS && (ret = nextMerged(record)) == SUCCESS)
+			ret = out.append(record);
+
+		if (ret == E_NOTFOUND) ret = SUCCESS;
+
+		if (ret == SUCCESS)
+		{
+			for (SpillFile &run : runs)
+				run.release();
+			start = end;
+		}
+		else
+			out.release();
+
+		runs.clear();
+		merged.push_back(out);
+	}
+
+	// (on failure, the runs not merged yet are kept so that release() frees them)
+	runs.swap(merged);
+	runs.insert(runs.end(), pending.begin() + start, pending.end());
+
+	return ret;
+}
+
+void ExternalSort::release()
+{
+	for (SpillFile &run : runs)
+		run.release();
+	runs.clear();
+	headValid.clear();
+	tree.clear();
+
+	free(buffer), free(order), free(heads);
+	buffer = nullptr, order = nullptr, heads = nullptr;
+	numBuffered = 0, position = 0;
+}
@@ -0,0 +1,82 @@
+#ifndef NITCBASE_EXTERNALSORT_H
+#define NITCBASE_EXTERNALSORT_H
+
+#include <vector>
+
+#include "../BlockAccess/SpillFile.h"
+#include "../define/constants.h"
+
+/*
+    Sorts a stream of records on one or more attributes without holding more
+    than OPERATOR_MEMORY_BLOCKS worth of records in memory:
+        * add() collects the records; every time the memory is full the
+          records in it are sorted and written out as a run (a SpillFile)
+        * sort() is called after the last add()
+        * next() then hands out the records in sorted order, merging the
+          runs if there were any (records with equal keys keep the order in
+          which they were added)
+    release() frees the memory and the blocks of the runs.
+
+    The runs are merged with a loser tree: a tournament over the current
+    record of every run, in which each inner node remembers the run that lost
+    the match played there. After the winner is handed out, only the matches
+    on the path from its run to the root are replayed, so each record costs
+    log2(number of runs) comparisons. At most OPERATOR_MEMORY_BLOCKS - 1 runs
+    are merged at once (a block of each is read at a time, and a block of the
+    merged run is written); if there are more, groups of them are first
+    merged into longer runs.
+*/
+
+// one attribute the records are sorted on (the first key decides, ties are
+// broken by the next one, and so on)
+typedef struct SortKey {
+  int attrOffset;
+  int attrType;
+  bool descending;
+} SortKey;
+
+class ExternalSort {
+ public:
+  ExternalSort(int numAttrs, int numKeys, SortKey keys[]);
+
+  // in ascending order of a single attribute
+  ExternalSort(int numAttrs, int attrOffset, int attrType);
+
+  int add(Attribute *record);
+  int sort();
+
+  // copy the next record in sorted order into `record`; E_NOTFOUND at the end
+  int next(Attribute *record);
+
+  void release();
+
+ private:
+  int numAttrs;
+  std::vector<SortKey> keys;
+
+  // records held in memory
+  int capacity;
+  int numBuffered;
+  Attribute *buffer;
+  int *order;  // positions in `buffer`, in sorted order
+  int position;
+
+  // sorted runs written out, the current (smallest unread) record of each,
+  // and the loser tree over them (tree[0] is the run of the winner)
+  std::vector<SpillFile> runs;
+  Attribute *heads;
+  std::vector<bool> headValid;
+  std::vector<int> tree;
+
+  int compare(Attribute *lhs, Attribute *rhs);
+  int sortBuffer();
+  int writeRun();
+
+  int startMerge();
+  int nextMerged(Attribute *record);
+  bool beats(int run, int otherRun);
+  void replay(int run);
+  int mergePass();
+};
+
+#endif  // NITCBASE_EXTERNALSORT_H
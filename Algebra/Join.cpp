@@ -0,0 +1,856 @@
+#include "Join.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../BPlusTree/BPlusTree.h"
+#include "../Executor/HashTable.h"
+
+int Join::emit(JoinTarget *target, Attribute *record1, Attribute *record2)
+{
+	Attribute targetRecord[target->numAttrs];
+
+	for (int attrIndex = 0; attrIndex < target->numAttrs; attrIndex++)
+		targetRecord[attrIndex] = target->srcRel[attrIndex] == 1 ? record1[target->srcOffset[attrIndex]]
+																  : record2[target->srcOffset[attrIndex]];
+
+	return BlockAccess::insert(target->relId, targetRecord);
+}
+
+// FNV-1a hash of an attribute value
+uint32_t Join::hashAttr(Attribute attrVal, int attrType)
+{
+	uint32_t hash = 2166136261u;
+
+	if (attrType == NUMBER)
+	{
+		// (0.0 and -0.0 compare equal, so they must hash the same)
+		double nVal = attrVal.nVal == 0 ? 0 : attrVal.nVal;
+
+		unsigned char bytes[sizeof(double)];
+		memcpy(bytes, &nVal, sizeof(double));
+
+		for (int byteIndex = 0; byteIndex < (int)sizeof(double); byteIndex++)
+			hash = (hash ^ bytes[byteIndex]) * 16777619u;
+	}
+	else
+	{
+		for (int charIndex = 0; charIndex < ATTR_SIZE && attrVal.sVal[charIndex] != '\0'; charIndex++)
+			hash = (hash ^ (unsigned char)attrVal.sVal[charIndex]) * 16777619u;
+	}
+
+	return hash;
+}
+
+int Join::indexNestedLoopJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target)
+{
+	Attribute record1[input1->numAttrs];
+	Attribute record2[input2->numAttrs];
+
+	// this loop is to get every record of input1 one by one
+	// (a ScanCursor is used so that the outer scan does not share the
+	// relation cache searchIndex with anything done inside the loop)
+	ScanCursor outerCursor (input1->relId);
+
+	while (outerCursor.next(record1) == SUCCESS)
+	{
+		// reset the search index of input2's attribute so that the search
+		// below starts from the root of its B+ tree
+		AttrCacheTable::resetSearchIndex(input2->relId, input2->attrName);
+
+		// this loop is to get every record of input2 which satisfies
+		// record1.attr1 = record2.attr2 (i.e. Equi-Join condition)
+		// (the B+ tree is searched directly rather than through
+		// BlockAccess::search(), which would weigh it against a linear search
+		// again for every record of input1: an equality probe always uses it)
+		RecId recId;
+		while ((recId = BPlusTree::bPlusSearch(input2->relId, input2->attrName,
+											   record1[input1->attrOffset], EQ)).block != -1)
+		{
+			RecBuffer blockBuffer (recId.block);
+			blockBuffer.getRecord(record2, recId.slot);
+
+			int ret = emit(target, record1, record2);
+			if (ret != SUCCESS) return ret;
+		}
+	}
+
+	return SUCCESS;
+}
+
+int Join::transientIndexJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target)
+{
+	TransientIndex index (input2->relId, input2->attrOffset, input2->attrType);
+
+	int ret = index.build();
+
+	Attribute record1[input1->numAttrs];
+	Attribute record2[input2->numAttrs];
+
+	ScanCursor outerCursor (input1->relId);
+
+	while (ret == SUCCESS && outerCursor.next(record1) == SUCCESS)
+	{
+		// the entries of input2 equal to record1.attr1 are all together
+		Attribute attrVal = record1[input1->attrOffset];
+		int last = index.upperBound(attrVal);
+
+		for (int position = index.lowerBound(attrVal); position < last && ret == SUCCESS; position++)
+		{
+			Index *entry = index.getEntry(position);
+
+			RecBuffer blockBuffer (entry->block);
+			blockBuffer.getRecord(record2, entry->slot);
+
+			ret = emit(target, record1, record2);
+		}
+	}
+
+	index.release();
+	return ret;
+}
+
+// whether two values that compare as cmpVal satisfy op
+static bool satisfiesOp(int cmpVal, int op)
+{
+	return (op == NE && cmpVal != 0) ||
+		   (op == LT && cmpVal < 0) ||
+		   (op == LE && cmpVal <= 0) ||
+		   (op == EQ && cmpVal == 0) ||
+		   (op == GT && cmpVal > 0) ||
+		   (op == GE && cmpVal >= 0);
+}
+
+bool Join::satisfiesAll(int numConditions, JoinCondition conditions[], Attribute *record1, Attribute *record2)
+{
+	for (int condIndex = 0; condIndex < numConditions; condIndex++)
+	{
+		JoinCondition *condition = &conditions[condIndex];
+
+		int cmpVal = compareAttrs(record1[condition->attrOffset1], record2[condition->attrOffset2], condition->attrType);
+		if (!satisfiesOp(cmpVal, condition->op)) return false;
+	}
+
+	return true;
+}
+
+int Join::blockNestedLoopJoin(JoinInput *input1, JoinInput *input2, int numConditions,
+							  JoinCondition conditions[], JoinTarget *target)
+{
+	int chunkCapacity = (OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE) / (input1->numAttrs * ATTR_SIZE);
+
+	Attribute *chunk = (Attribute *)malloc(chunkCapacity * input1->numAttrs * sizeof(Attribute));
+	if (chunk == nullptr) return FAILURE;
+
+	Attribute record2[input2->numAttrs];
+
+	ScanCursor outerCursor (input1->relId);
+	bool outerDone = false;
+	int ret = SUCCESS;
+
+	while (ret == SUCCESS && !outerDone)
+	{
+		// fill the chunk with the next records of input1
+		int chunkSize = 0;
+		while (chunkSize < chunkCapacity && !outerDone)
+		{
+			if (outerCursor.next(chunk + chunkSize * input1->numAttrs) == SUCCESS) chunkSize++;
+			else outerDone = true;
+		}
+
+		if (chunkSize == 0) break;
+
+		// one scan of input2 for the whole chunk
+		ScanCursor innerCursor (input2->relId);
+
+		while (ret == SUCCESS && innerCursor.next(record2) == SUCCESS)
+		{
+			for (int chunkIndex = 0; chunkIndex < chunkSize && ret == SUCCESS; chunkIndex++)
+			{
+				Attribute *record1 = chunk + chunkIndex * input1->numAttrs;
+
+				if (Join::satisfiesAll(numConditions, conditions, record1, record2))
+					ret = emit(target, record1, record2);
+			}
+		}
+	}
+
+	free(chunk);
+	return ret;
+}
+
+/*
+	The values of input2's join attribute that can satisfy every condition on
+	it, given a record of input1: a lower and/or an upper bound, each of which
+	may or may not include the bound itself.
+*/
+typedef struct Range
+{
+	bool hasLow, lowInclusive;
+	Attribute low;
+	bool hasHigh, highInclusive;
+	Attribute high;
+} Range;
+
+static Range rangeOf(JoinInput *input2, int numConditions, JoinCondition conditions[], Attribute *record1)
+{
+	Range range;
+	range.hasLow = range.hasHigh = false;
+
+	for (int condIndex = 0; condIndex < numConditions; condIndex++)
+	{
+		JoinCondition *condition = &conditions[condIndex];
+		if (condition->attrOffset2 != input2->attrOffset || condition->op == NE) continue;
+
+		// record1.attr1 op X bounds X from below for <, <= and =, and from
+		// above for >, >= and =
+		Attribute attrVal = record1[condition->attrOffset1];
+		int op = condition->op;
+
+		if (op == LT || op == LE || op == EQ)
+		{
+			int cmpVal = range.hasLow ? compareAttrs(attrVal, range.low, condition->attrType) : 1;
+			if (cmpVal > 0 || (cmpVal == 0 && op == LT))
+				range.hasLow = true, range.low = attrVal, range.lowInclusive = op != LT;
+		}
+		if (op == GT || op == GE || op == EQ)
+		{
+			int cmpVal = range.hasHigh ? compareAttrs(attrVal, range.high, condition->attrType) : -1;
+			if (cmpVal < 0 || (cmpVal == 0 && op == GT))
+				range.hasHigh = true, range.high = attrVal, range.highInclusive = op != GT;
+		}
+	}
+
+	return range;
+}
+
+// whether a value is at or beyond the low end of `range`
+static bool aboveLow(Range *range, Attribute attrVal, int attrType)
+{
+	if (!range->hasLow) return true;
+
+	int cmpVal = compareAttrs(attrVal, range->low, attrType);
+	return cmpVal > 0 || (cmpVal == 0 && range->lowInclusive);
+}
+
+// whether a value at or beyond the low end of `range` is below its high end
+static bool belowHigh(Range *range, Attribute attrVal, int attrType)
+{
+	if (!range->hasHigh) return true;
+
+	int cmpVal = compareAttrs(attrVal, range->high, attrType);
+	return cmpVal < 0 || (cmpVal == 0 && range->highInclusive);
+}
+
+// the leaves of a B+ tree from the leaf where the low end of `range` would
+// be (or, with no low end, from the leftmost leaf)
+static LeafCursor rangeLeaves(int rootBlock, Range *range, int attrType)
+{
+	if (!range->hasLow) return LeafCursor(rootBlock);
+
+	return LeafCursor(rootBlock, range->low, attrType, range->lowInclusive ? GE : GT);
+}
+
+int Join::rangeJoin(JoinInput *input1, JoinInput *input2, int numConditions,
+					JoinCondition conditions[], JoinTarget *target)
+{
+	bool useBPlusTree = input2->rootBlock != -1;
+
+	TransientIndex index (input2->relId, input2->attrOffset, input2->attrType);
+	int ret = useBPlusTree ? SUCCESS : index.build();
+
+	Attribute record1[input1->numAttrs];
+	Attribute record2[input2->numAttrs];
+
+	ScanCursor outerCursor (input1->relId);
+
+	while (ret == SUCCESS && outerCursor.next(record1) == SUCCESS)
+	{
+		Range range = rangeOf(input2, numConditions, conditions, record1);
+
+		if (useBPlusTree)
+		{
+			// the leaf entries come in ascending order from the low end of the
+			// range up, so the walk stops at the first value past the high
+			// end, and only the records of the entries in the range are read
+			LeafCursor leaves = rangeLeaves(input2->rootBlock, &range, input2->attrType);
+
+			Index entry;
+			while (ret == SUCCESS && leaves.next(&entry) == SUCCESS)
+			{
+				if (!aboveLow(&range, entry.attrVal, input2->attrType)) continue;
+				if (!belowHigh(&range, entry.attrVal, input2->attrType)) break;
+
+				RecBuffer blockBuffer (entry.block);
+				blockBuffer.getRecord(record2, entry.slot);
+
+				if (Join::satisfiesAll(numConditions, conditions, record1, record2))
+					ret = emit(target, record1, record2);
+			}
+		}
+		else
+		{
+			int first = !range.hasLow ? 0 : range.lowInclusive ? index.lowerBound(range.low)
+															   : index.upperBound(range.low);
+			int last = !range.hasHigh ? index.getNumEntries()
+									  : range.highInclusive ? index.upperBound(range.high)
+															: index.lowerBound(range.high);
+
+			for (int position = first; position < last && ret == SUCCESS; position++)
+			{
+				Index *entry = index.getEntry(position);
+
+				RecBuffer blockBuffer (entry->block);
+				blockBuffer.getRecord(record2, entry->slot);
+
+				if (Join::satisfiesAll(numConditions, conditions, record1, record2))
+					ret = emit(target, record1, record2);
+			}
+		}
+	}
+
+	index.release();
+	return ret;
+}
+
+/*
+	The in-memory hash table of a hash join: the records of (one partition of)
+	the build side, looked up on their join value. The distinct values are
+	kept in a HashTable, and the records with each value are chained from the
+	position of the value there.
+*/
+typedef struct JoinTable
+{
+	HashTable *values;
+	int numAttrs;
+	std::vector<Attribute> records;  // numAttrs per record
+	std::vector<int> nextRecord;	 // the record added before it with the same value, or -1
+	std::vector<int> lastRecord;	 // per value, the record added last with it
+} JoinTable;
+
+static JoinTable *createTable(JoinInput *input, int expectedRecords)
+{
+	int keyTypes[] = {input->attrType};
+
+	JoinTable *table = new JoinTable;
+	table->values = new HashTable(1, keyTypes, input->numAttrs, expectedRecords);
+	table->numAttrs = input->numAttrs;
+	table->records.reserve((size_t)expectedRecords * input->numAttrs);
+
+	return table;
+}
+
+static void deleteTable(JoinTable *table)
+{
+	if (table == nullptr) return;
+
+	delete table->values;
+	delete table;
+}
+
+/*
+	The records of a partition all agree on the hash digits the partitions
+	were split on (the remainders of hash / divisor for every level of
+	partitioning, divisor being the product of the numbers of partitions of
+	the levels before), so the table is given the digits left, hash / divisor,
+	to pick its buckets with.
+*/
+static void tableInsert(JoinTable *table, Attribute *record, int attrOffset, uint32_t hash)
+{
+	int value = table->values->find(&record[attrOffset], hash);
+	if (value == -1)
+	{
+		value = table->values->add(&record[attrOffset], hash);
+		table->lastRecord.push_back(-1);
+	}
+
+	table->nextRecord.push_back(table->lastRecord[value]);
+	table->lastRecord[value] = table->nextRecord.size() - 1;
+	table->records.insert(table->records.end(), record, record + table->numAttrs);
+}
+
+// the last record added with `attrVal` (the others follow by nextRecord), or -1
+static int tableFind(JoinTable *table, Attribute attrVal, uint32_t hash)
+{
+	int value = table->values->find(&attrVal, hash);
+	return value == -1 ? -1 : table->lastRecord[value];
+}
+
+// the records of one side of a hash join: either the whole relation or one of
+// its spilled partitions
+typedef struct RecordSource
+{
+	ScanCursor *cursor;
+	SpillFile *spill;
+} RecordSource;
+
+static int nextRecord(RecordSource source, Attribute *record)
+{
+	return source.cursor != nullptr ? source.cursor->next(record) : source.spill->next(record);
+}
+
+/*
+	Joins the records of `buildSource` (records of `build`) with those of
+	`probeSource` (records of `probe`) with an in-memory hash table built on
+	`buildSource`. At most `maxRecords` records (all of them if -1) are taken
+	from `buildSource`, and the rest are left to be read by the next call.
+*/
+static int joinPartition(JoinInput *build, RecordSource buildSource, JoinInput *probe, RecordSource probeSource,
+						 bool buildIsInput1, uint64_t divisor, int expectedRecords, int maxRecords, JoinTarget *target)
+{
+	JoinTable *table = createTable(build, expectedRecords);
+
+	Attribute buildRecord[build->numAttrs];
+	Attribute probeRecord[probe->numAttrs];
+
+	// build
+	int numRecords = 0;
+	while ((maxRecords < 0 || numRecords < maxRecords) && nextRecord(buildSource, buildRecord) == SUCCESS)
+	{
+		uint32_t hash = Join::hashAttr(buildRecord[build->attrOffset], build->attrType);
+		tableInsert(table, buildRecord, build->attrOffset, hash / divisor);
+		numRecords++;
+	}
+
+	// probe
+	int ret = SUCCESS;
+	while (ret == SUCCESS && nextRecord(probeSource, probeRecord) == SUCCESS)
+	{
+		Attribute probeVal = probeRecord[probe->attrOffset];
+		uint32_t hash = Join::hashAttr(probeVal, probe->attrType);
+
+		for (int recordIndex = tableFind(table, probeVal, hash / divisor);
+			 recordIndex != -1 && ret == SUCCESS; recordIndex = table->nextRecord[recordIndex])
+		{
+			Attribute *record = table->records.data() + recordIndex * table->numAttrs;
+			ret = buildIsInput1 ? Join::emit(target, record, probeRecord) : Join::emit(target, probeRecord, record);
+		}
+	}
+
+	deleteTable(table);
+	return ret;
+}
+
+// writes every record of `source` to partitions[(hash / divisor) % numPartitions]
+static int partitionSource(JoinInput *input, RecordSource source, uint64_t divisor, std::vector<SpillFile> &partitions)
+{
+	int numPartitions = partitions.size();
+	Attribute record[input->numAttrs];
+
+	while (nextRecord(source, record) == SUCCESS)
+	{
+		uint32_t hash = Join::hashAttr(record[input->attrOffset], input->attrType);
+
+		int ret = partitions[(hash / divisor) % numPartitions].append(record);
+		if (ret != SUCCESS) return ret;
+	}
+
+	return SUCCESS;
+}
+
+/*
+	Splits both sides on the hash of the join attribute into partitions small
+	enough to be joined in memory one at a time (matching records always land
+	in partitions with the same number), and joins them. The records of
+	`buildSource` (`buildRecords` of them) all agree on hash % divisor, and
+	are split on the next digits, (hash / divisor) % numPartitions.
+
+	A build partition still larger than the budget (e.g. because of skew) is
+	split again, recursively, on the digits after those. If splitting it does
+	not make it any smaller, its records have the same hash (mostly, the same
+	join value), and no further split can help: it is then joined a chunk of
+	`budgetRecords` build records at a time, reading the probe partition once
+	per chunk.
+*/
+static int joinPartitioned(JoinInput *build, RecordSource buildSource, int buildRecords,
+						   JoinInput *probe, RecordSource probeSource, bool buildIsInput1,
+						   uint64_t divisor, int budgetRecords, JoinTarget *target)
+{
+	int numPartitions = buildRecords / budgetRecords + 1;
+	if (numPartitions > OPERATOR_MEMORY_BLOCKS) numPartitions = OPERATOR_MEMORY_BLOCKS;
+
+	std::vector<SpillFile> buildPartitions (numPartitions, SpillFile(build->numAttrs));
+	std::vector<SpillFile> probePartitions (numPartitions, SpillFile(probe->numAttrs));
+
+	int ret = partitionSource(build, buildSource, divisor, buildPartitions);
+	if (ret == SUCCESS) ret = partitionSource(probe, probeSource, divisor, probePartitions);
+
+	uint64_t partitionDivisor = divisor * numPartitions;
+
+	for (int partition = 0; partition < numPartitions; partition++)
+	{
+		SpillFile *buildPartition = &buildPartitions[partition];
+		SpillFile *probePartition = &probePartitions[partition];
+		int partitionRecords = buildPartition->getNumRecords();
+
+		RecordSource buildPartitionSource {nullptr, buildPartition};
+		RecordSource probePartitionSource {nullptr, probePartition};
+
+		if (ret != SUCCESS || partitionRecords == 0)
+			;
+		else if (partitionRecords <= budgetRecords)
+			ret = joinPartition(build, buildPartitionSource, probe, probePartitionSource,
+								buildIsInput1, partitionDivisor, partitionRecords, -1, target);
+		else if (partitionRecords < buildRecords)
+			ret = joinPartitioned(build, buildPartitionSource, partitionRecords, probe, probePartitionSource,
+								  buildIsInput1, partitionDivisor, budgetRecords, target);
+		else
+		{
+			for (int taken = 0; ret == SUCCESS && taken < partitionRecords; taken += budgetRecords)
+			{
+				probePartition->rewind();
+				ret = joinPartition(build, buildPartitionSource, probe, probePartitionSource,
+									buildIsInput1, partitionDivisor, budgetRecords, budgetRecords, target);
+			}
+		}
+
+		buildPartition->release();
+		probePartition->release();
+	}
+
+	return ret;
+}
+
+int Join::hashJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target)
+{
+	// build on the smaller relation, probe with the other
+	bool buildIsInput1 = input1->numRecords <= input2->numRecords;
+	JoinInput *build = buildIsInput1 ? input1 : input2;
+	JoinInput *probe = buildIsInput1 ? input2 : input1;
+
+	int budgetRecords = (OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE) / (build->numAttrs * ATTR_SIZE);
+
+	ScanCursor buildCursor (build->relId), probeCursor (probe->relId);
+	RecordSource buildSource {&buildCursor, nullptr}, probeSource {&probeCursor, nullptr};
+
+	// the whole build side fits in memory: a single pass over each relation
+	if (build->numRecords <= budgetRecords)
+		return joinPartition(build, buildSource, probe, probeSource, buildIsInput1, 1, build->numRecords, -1, target);
+
+	// otherwise partition both relations (grace hash join)
+	return joinPartitioned(build, buildSource, build->numRecords, probe, probeSource,
+						   buildIsInput1, 1, budgetRecords, target);
+}
+
+// one side of a sort-merge join, in ascending order of its join attribute:
+// either the leaves of its B+ tree or an external sort of its records
+typedef struct SortedInput
+{
+	LeafCursor *leaves;
+	ExternalSort *sorter;
+	int numAttrs;
+	int attrOffset;
+	Attribute *record;  // the current record, when read from the sorter
+	Index entry;        // the current index entry, when read from the leaves
+} SortedInput;
+
+/*
+	Moves to the next record of the input and sets `key` to its join
+	attribute. Off the leaves of a B+ tree, the key is that of the index
+	entry: the record itself is only read by getSorted(), so that the merge
+	reads the records of the keys that match, and none of the others.
+*/
+static int nextSorted(SortedInput *input, Attribute *key)
+{
+	int ret;
+
+	if (input->leaves == nullptr)
+	{
+		ret = input->sorter->next(input->record);
+		if (ret == SUCCESS) *key = input->record[input->attrOffset];
+	}
+	else
+	{
+		ret = input->leaves->next(&input->entry);
+		if (ret == SUCCESS) *key = input->entry.attrVal;
+	}
+
+	return ret;
+}
+
+// copy the current record of the input into `record`
+static int getSorted(SortedInput *input, Attribute *record)
+{
+	if (input->leaves == nullptr)
+	{
+		memcpy(record, input->record, input->numAttrs * sizeof(Attribute));
+		return SUCCESS;
+	}
+
+	RecBuffer blockBuffer (input->entry.block);
+	return blockBuffer.getRecord(record, input->entry.slot);
+}
+
+static int sortInput(JoinInput *input, ExternalSort *sorter)
+{
+	Attribute record[input->numAttrs];
+
+	ScanCursor cursor (input->relId);
+	while (cursor.next(record) == SUCCESS)
+	{
+		int ret = sorter->add(record);
+		if (ret != SUCCESS) return ret;
+	}
+
+	return sorter->sort();
+}
+
+static int mergeInputs(JoinInput *input1, SortedInput *sorted1, JoinInput *input2, SortedInput *sorted2,
+					   JoinTarget *target)
+{
+	Attribute record1[input1->numAttrs];
+	Attribute record2[input2->numAttrs];
+	int attrType = input1->attrType;
+
+	Attribute key1, key2;
+	bool has1 = nextSorted(sorted1, &key1) == SUCCESS;
+	bool has2 = nextSorted(sorted2, &key2) == SUCCESS;
+
+	// the records of input2 with the key being joined
+	std::vector<Attribute> group;
+
+	while (has1 && has2)
+	{
+		int cmpVal = compareAttrs(key1, key2, attrType);
+
+		// move the side with the smaller key forward
+		if (cmpVal < 0)
+		{
+			has1 = nextSorted(sorted1, &key1) == SUCCESS;
+			continue;
+		}
+		if (cmpVal > 0)
+		{
+			has2 = nextSorted(sorted2, &key2) == SUCCESS;
+			continue;
+		}
+
+		// equal keys: collect every record of input2 with this key, and pair
+		// each record of input1 with this key with all of them
+		Attribute key = key2;
+
+		group.clear();
+		while (has2 && compareAttrs(key2, key, attrType) == 0)
+		{
+			int ret = getSorted(sorted2, record2);
+			if (ret != SUCCESS) return ret;
+
+			group.insert(group.end(), record2, record2 + input2->numAttrs);
+			has2 = nextSorted(sorted2, &key2) == SUCCESS;
+		}
+
+		while (has1 && compareAttrs(key1, key, attrType) == 0)
+		{
+			int ret = getSorted(sorted1, record1);
+			if (ret != SUCCESS) return ret;
+
+			for (int groupIndex = 0; groupIndex * input2->numAttrs < (int)group.size(); groupIndex++)
+			{
+				ret = Join::emit(target, record1, group.data() + groupIndex * input2->numAttrs);
+				if (ret != SUCCESS) return ret;
+			}
+
+			has1 = nextSorted(sorted1, &key1) == SUCCESS;
+		}
+	}
+
+	return SUCCESS;
+}
+
+int Join::sortMergeJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target)
+{
+	LeafCursor leaves1 (input1->rootBlock), leaves2 (input2->rootBlock);
+	ExternalSort sorter1 (input1->numAttrs, input1->attrOffset, input1->attrType);
+	ExternalSort sorter2 (input2->numAttrs, input2->attrOffset, input2->attrType);
+	Attribute current1[input1->numAttrs], current2[input2->numAttrs];
+
+	SortedInput sorted1 {input1->rootBlock != -1 ? &leaves1 : nullptr, &sorter1,
+						 input1->numAttrs, input1->attrOffset, current1, Index()};
+	SortedInput sorted2 {input2->rootBlock != -1 ? &leaves2 : nullptr, &sorter2,
+						 input2->numAttrs, input2->attrOffset, current2, Index()};
+
+	// an input without an index is sorted first
+	int ret = SUCCESS;
+	if (input1->rootBlock == -1) ret = sortInput(input1, &sorter1);
+	if (ret == SUCCESS && input2->rootBlock == -1) ret = sortInput(input2, &sorter2);
+
+	if (ret == SUCCESS) ret = mergeInputs(input1, &sorted1, input2, &sorted2, target);
+
+	sorter1.release();
+	sorter2.release();
+
+	return ret;
+}
+
+// what a step of a pipelined join looks its records up in
+typedef struct StepState
+{
+	ScanCursor *cursor;		// ACCESS_SCAN
+	JoinTable *table;		// ACCESS_HASH
+	TransientIndex *index;	// ACCESS_TRANSIENT
+} StepState;
+
+static int buildStep(JoinStep *step, StepState *state)
+{
+	JoinInput *input = &step->input;
+
+	state->cursor = nullptr, state->table = nullptr, state->index = nullptr;
+
+	if (step->access == ACCESS_SCAN)
+	{
+		state->cursor = new ScanCursor(input->relId);
+		return SUCCESS;
+	}
+
+	if (step->access == ACCESS_TRANSIENT)
+	{
+		state->index = new TransientIndex(input->relId, input->attrOffset, input->attrType);
+		return state->index->build();
+	}
+
+	if (step->access == ACCESS_HASH)
+	{
+		state->table = createTable(input, input->numRecords);
+
+		Attribute record[input->numAttrs];
+		ScanCursor cursor (input->relId);
+
+		while (cursor.next(record) == SUCCESS)
+			tableInsert(state->table, record, input->attrOffset, Join::hashAttr(record[input->attrOffset], input->attrType));
+
+		return SUCCESS;
+	}
+
+	return SUCCESS;
+}
+
+static void releaseStep(StepState *state)
+{
+	delete state->cursor;
+
+	if (state->index != nullptr) state->index->release();
+	delete state->index;
+
+	deleteTable(state->table);
+}
+
+/*
+	Looks up the records of steps[stepIndex] that join with `tuple` (which
+	holds the records of the steps before it), places each of them in the
+	tuple in turn and goes on to the next step; past the last step the tuple
+	is complete and is emitted.
+*/
+static int runStep(int stepIndex, int numSteps, JoinStep steps[], StepState states[], Attribute *tuple,
+				   JoinTarget *target)
+{
+	if (stepIndex == numSteps) return Join::emit(target, tuple, nullptr);
+
+	JoinStep *step = &steps[stepIndex];
+	StepState *state = &states[stepIndex];
+	JoinInput *input = &step->input;
+
+	Attribute *record = tuple + step->tupleOffset;
+	int ret = SUCCESS;
+
+	if (step->access == ACCESS_SCAN)
+	{
+		state->cursor->reset();
+
+		while (ret == SUCCESS && state->cursor->next(record) == SUCCESS)
+		{
+			if (Join::satisfiesAll(step->numConditions, step->conditions, tuple, record))
+				ret = runStep(stepIndex + 1, numSteps, steps, states, tuple, target);
+		}
+	}
+	else if (step->access == ACCESS_HASH)
+	{
+		Attribute probeVal = tuple[step->conditions[step->lookupCond].attrOffset1];
+		uint32_t hash = Join::hashAttr(probeVal, input->attrType);
+		JoinTable *table = state->table;
+
+		for (int recordIndex = tableFind(table, probeVal, hash);
+			 recordIndex != -1 && ret == SUCCESS; recordIndex = table->nextRecord[recordIndex])
+		{
+			memcpy(record, table->records.data() + recordIndex * table->numAttrs, table->numAttrs * sizeof(Attribute));
+
+			if (Join::satisfiesAll(step->numConditions, step->conditions, tuple, record))
+				ret = runStep(stepIndex + 1, numSteps, steps, states, tuple, target);
+		}
+	}
+	else
+	{
+		// the records in the range of values the conditions on the lookup
+		// attribute allow (see rangeJoin())
+		Range range = rangeOf(input, step->numConditions, step->conditions, tuple);
+
+		if (step->access == ACCESS_BPLUS)
+		{
+			// (the walk keeps its own position, so the later steps may search
+			// the B+ trees of the other relations meanwhile)
+			LeafCursor leaves = rangeLeaves(input->rootBlock, &range, input->attrType);
+
+			Index entry;
+			while (ret == SUCCESS && leaves.next(&entry) == SUCCESS)
+			{
+				if (!aboveLow(&range, entry.attrVal, input->attrType)) continue;
+				if (!belowHigh(&range, entry.attrVal, input->attrType)) break;
+
+				RecBuffer blockBuffer (entry.block);
+				blockBuffer.getRecord(record, entry.slot);
+
+				if (Join::satisfiesAll(step->numConditions, step->conditions, tuple, record))
+					ret = runStep(stepIndex + 1, numSteps, steps, states, tuple, target);
+			}
+		}
+		else
+		{
+			TransientIndex *index = state->index;
+
+			int first = !range.hasLow ? 0 : range.lowInclusive ? index->lowerBound(range.low)
+															   : index->upperBound(range.low);
+			int last = !range.hasHigh ? index->getNumEntries()
+									  : range.highInclusive ? index->upperBound(range.high)
+															: index->lowerBound(range.high);
+
+			for (int position = first; position < last && ret == SUCCESS; position++)
+			{
+				Index *entry = index->getEntry(position);
+
+				RecBuffer blockBuffer (entry->block);
+				blockBuffer.getRecord(record, entry->slot);
+
+				if (Join::satisfiesAll(step->numConditions, step->conditions, tuple, record))
+					ret = runStep(stepIndex + 1, numSteps, steps, states, tuple, target);
+			}
+		}
+	}
+
+	return ret;
+}
+
+int Join::pipelinedJoin(int numSteps, JoinStep steps[], JoinTarget *target)
+{
+	int tupleSize = 0;
+	for (int stepIndex = 0; stepIndex < numSteps; stepIndex++)
+		tupleSize += steps[stepIndex].input.numAttrs;
+
+	Attribute tuple[tupleSize];
+
+	// build the hash tables and TransientIndexes of all the steps up front
+	StepState states[numSteps];
+	int ret = SUCCESS;
+
+	for (int stepIndex = 0; stepIndex < numSteps; stepIndex++)
+	{
+		int buildRet = buildStep(&steps[stepIndex], &states[stepIndex]);
+		if (ret == SUCCESS) ret = buildRet;
+	}
+
+	if (ret == SUCCESS) ret = runStep(0, numSteps, steps, states, tuple, target);
+
+	for (int stepIndex = 0; stepIndex < numSteps; stepIndex++)
+		releaseStep(&states[stepIndex]);
+
+	return ret;
+}
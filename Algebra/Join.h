@@ -0,0 +1,124 @@
+#ifndef NITCBASE_JOIN_H
+#define NITCBASE_JOIN_H
+
+#include <cstdint>
+
+#include "../BPlusTree/LeafCursor.h"
+#include "../BlockAccess/BlockAccess.h"
+#include "../BlockAccess/ScanCursor.h"
+#include "../BlockAccess/SpillFile.h"
+#include "../Cache/OpenRelTable.h"
+#include "../define/constants.h"
+#include "ExternalSort.h"
+#include "TransientIndex.h"
+
+/*
+    The algorithms Algebra::join() chooses from to compute the join of R1 and
+    R2 on R1.attr1 = R2.attr2 (or, for the range and nested-loop joins, on a
+    conjunction of conditions R1.attr1 op R2.attr2), and the pipeline that
+    Algebra::multiJoin() runs to join more than two relations at once (see
+    JoinPlanner). Every algorithm hands each matching pair of records
+    (record1 from R1, record2 from R2) to emit(), which assembles the
+    projected target record and inserts it into the target relation.
+*/
+
+// one side of the join, as looked up in the caches by Algebra::join()
+typedef struct JoinInput {
+  int relId;
+  int numAttrs;
+  int numRecords;
+  char attrName[ATTR_SIZE];  // join attribute
+  int attrOffset;
+  int attrType;
+  int rootBlock;
+} JoinInput;
+
+// where the joined records go: the i-th attribute of a target record is taken
+// from record1 if srcRel[i] == 1 and from record2 otherwise, at srcOffset[i]
+typedef struct JoinTarget {
+  int relId;
+  int numAttrs;
+  int *srcRel;
+  int *srcOffset;
+} JoinTarget;
+
+// one condition `record1[attrOffset1] op record2[attrOffset2]` of a join
+typedef struct JoinCondition {
+  int attrOffset1;
+  int op;
+  int attrOffset2;
+  int attrType;
+} JoinCondition;
+
+// how the records of the relation joined in at a step of a pipelined join
+// are found, for each tuple coming out of the steps before it
+enum JoinAccess {
+  ACCESS_SCAN,       // scan the whole relation
+  ACCESS_HASH,       // in-memory hash table on the lookup attribute
+  ACCESS_BPLUS,      // B+ tree on the lookup attribute
+  ACCESS_TRANSIENT   // TransientIndex on the lookup attribute
+};
+
+// one relation of a pipelined (multi-way) join
+typedef struct JoinStep {
+  JoinInput input;  // attrName, attrOffset, attrType, rootBlock: the lookup attribute
+  int access;
+  int tupleOffset;  // where the records of the relation go in the joined tuple
+  // the conditions between the relation and those joined in before it:
+  // attrOffset1 is an offset in the joined tuple, attrOffset2 one in a record
+  // of the relation; the records are looked up on conditions[lookupCond]
+  int numConditions;
+  JoinCondition *conditions;
+  int lookupCond;
+} JoinStep;
+
+class Join {
+ public:
+  // probes the B+ tree of input2 (which must have one) once per record of input1
+  static int indexNestedLoopJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target);
+
+  // sorts the (value, rec-id) pairs of input2 in memory (a TransientIndex),
+  // and looks up the records of input2 in it once per record of input1
+  static int transientIndexJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target);
+
+  // holds as many records of input1 as fit in OPERATOR_MEMORY_BLOCKS at a
+  // time, and scans input2 once per such chunk, pairing every record of the
+  // chunk with every record of input2 that satisfies all the conditions
+  static int blockNestedLoopJoin(JoinInput *input1, JoinInput *input2, int numConditions,
+                                 JoinCondition conditions[], JoinTarget *target);
+
+  // for every record of input1, turns the conditions on the join attribute of
+  // input2 into a range of its values, and reads that range off input2's B+
+  // tree (or, if it has none, off a TransientIndex); the records in the range
+  // are then checked against all the conditions (band and theta joins)
+  static int rangeJoin(JoinInput *input1, JoinInput *input2, int numConditions,
+                       JoinCondition conditions[], JoinTarget *target);
+
+  // builds a hash table on the smaller input and probes it with the other;
+  // partitions both inputs to spill files first if the build side does not
+  // fit in OPERATOR_MEMORY_BLOCKS (grace hash join), and partitions again,
+  // recursively, every build partition that still does not fit
+  static int hashJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target);
+
+  // reads both inputs in ascending order of their join attributes (walking
+  // the leaves of an input's B+ tree, or sorting its records externally if it
+  // has none) and merges them in a single pass
+  static int sortMergeJoin(JoinInput *input1, JoinInput *input2, JoinTarget *target);
+
+  // joins the relations of the steps in a single pipeline: the records of
+  // steps[0] are scanned, and each tuple (the records joined so far, side by
+  // side) is looked up in the next relation and passed on, without being
+  // written to the disk; the target attributes are taken from the tuple
+  // (srcRel 1) of the last step
+  static int pipelinedJoin(int numSteps, JoinStep steps[], JoinTarget *target);
+
+  // inserts the target record made of record1 and record2
+  static int emit(JoinTarget *target, Attribute *record1, Attribute *record2);
+
+  // whether record1 and record2 satisfy all the conditions
+  static bool satisfiesAll(int numConditions, JoinCondition conditions[], Attribute *record1, Attribute *record2);
+
+  static uint32_t hashAttr(Attribute attrVal, int attrType);
+};
+
+#endif  // NITCBASE_JOIN_H
@@ -0,0 +1,182 @@
+#include "JoinPlanner.h"
+
+#include <cmath>
+
+// cost of producing (or probing with) one tuple, in blocks read
+static const double TUPLE_COST = 0.01;
+
+// selectivity of `<`, `<=`, `>` and `>=`, for which the statistics say nothing
+static const double RANGE_SELECTIVITY = 1.0 / 3;
+
+static double numBlocks(JoinInput *input)
+{
+	int numSlots = floor((2016 * 1.00) / (16 * input->numAttrs + 1));
+	return ceil((double)input->numRecords / numSlots);
+}
+
+static double numDistinct(JoinInput *input, int attrOffset)
+{
+	// (without complete statistics, every value is taken to be distinct)
+	double distinct;
+	if (AttrStatsTable::getNumDistinct(input->relId, attrOffset, &distinct) != SUCCESS)
+		distinct = input->numRecords;
+
+	return distinct;
+}
+
+// the fraction of the pairs of records of edge->rel1 and edge->rel2 that satisfy the edge
+static double selectivity(JoinInput inputs[], JoinEdge *edge)
+{
+	if (edge->op != EQ && edge->op != NE) return RANGE_SELECTIVITY;
+
+	// (the values of the side with fewer distinct values are assumed to
+	// appear among those of the other side)
+	double distinct = fmax(numDistinct(&inputs[edge->rel1], edge->attrOffset1),
+						   numDistinct(&inputs[edge->rel2], edge->attrOffset2));
+	distinct = fmax(distinct, 1);
+
+	return edge->op == EQ ? 1 / distinct : 1 - 1 / distinct;
+}
+
+typedef struct AccessChoice
+{
+	double cost;
+	int access;
+	int edge;
+} AccessChoice;
+
+/*
+	The cheapest way of looking up, for each of `outerTuples` tuples of the
+	relations in `outerMask`, the matching records of relation `rel`.
+*/
+static AccessChoice cheapestAccess(int rel, int outerMask, double outerTuples, JoinInput inputs[],
+								   int numEdges, JoinEdge edges[], double edgeSelectivity[], double memoryShare)
+{
+	JoinInput *input = &inputs[rel];
+	double blocks = numBlocks(input);
+
+	// scanning the relation for every tuple is always possible
+	AccessChoice best {outerTuples * (blocks + TUPLE_COST * input->numRecords), ACCESS_SCAN, -1};
+
+	for (int edgeIndex = 0; edgeIndex < numEdges; edgeIndex++)
+	{
+		JoinEdge *edge = &edges[edgeIndex];
+
+		// the attribute of rel in a condition with one of the outer relations
+		int attrOffset;
+		if (edge->rel1 == rel && (outerMask & (1 << edge->rel2)))
+			attrOffset = edge->attrOffset1;
+		else if (edge->rel2 == rel && (outerMask & (1 << edge->rel1)))
+			attrOffset = edge->attrOffset2;
+		else
+			continue;
+
+		// (`!=` does not narrow down the records to look at)
+		if (edge->op == NE) continue;
+
+		double matches = input->numRecords * edgeSelectivity[edgeIndex];
+
+		AttrCatEntry attrCatEntry;
+		AttrCacheTable::getAttrCatEntry(input->relId, attrOffset, &attrCatEntry);
+
+		AccessChoice choices[3];
+		int numChoices = 0;
+
+		if (attrCatEntry.rootBlock != -1)
+		{
+			double height = 1 + ceil(log(fmax(input->numRecords / (double)MAX_KEYS_LEAF, 1)) / log(MAX_KEYS_INTERNAL));
+			choices[numChoices++] = AccessChoice {outerTuples * (height + matches), ACCESS_BPLUS, edgeIndex};
+		}
+
+		double tableSize = input->numRecords * (input->numAttrs * ATTR_SIZE + 3 * sizeof(int));
+		if (edge->op == EQ && tableSize <= memoryShare)
+			choices[numChoices++] = AccessChoice {blocks + outerTuples * TUPLE_COST * (1 + matches), ACCESS_HASH, edgeIndex};
+
+		if (input->numRecords * sizeof(Index) <= memoryShare)
+			choices[numChoices++] = AccessChoice {blocks + outerTuples * (TUPLE_COST + matches), ACCESS_TRANSIENT, edgeIndex};
+
+		for (int choice = 0; choice < numChoices; choice++)
+			if (choices[choice].cost < best.cost) best = choices[choice];
+	}
+
+	return best;
+}
+
+int JoinPlanner::plan(int numRels, JoinInput inputs[], int numEdges, JoinEdge edges[], JoinPlan *plan)
+{
+	if (numRels < 1 || numRels > MAX_JOIN_RELATIONS) return E_INVALID;
+
+	int numMasks = 1 << numRels;
+
+	double edgeSelectivity[numEdges];
+	for (int edgeIndex = 0; edgeIndex < numEdges; edgeIndex++)
+		edgeSelectivity[edgeIndex] = selectivity(inputs, &edges[edgeIndex]);
+
+	// estimated number of tuples in the join of the relations in each subset
+	// (the same whatever order they are joined in)
+	double cardinality[numMasks];
+	for (int mask = 1; mask < numMasks; mask++)
+	{
+		cardinality[mask] = 1;
+
+		for (int rel = 0; rel < numRels; rel++)
+			if (mask & (1 << rel)) cardinality[mask] *= inputs[rel].numRecords;
+
+		for (int edgeIndex = 0; edgeIndex < numEdges; edgeIndex++)
+			if ((mask & (1 << edges[edgeIndex].rel1)) && (mask & (1 << edges[edgeIndex].rel2)))
+				cardinality[mask] *= edgeSelectivity[edgeIndex];
+	}
+
+	// the in-memory structures of all the steps have to fit together
+	double memoryShare = (double)OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE / (numRels > 1 ? numRels - 1 : 1);
+
+	// the cheapest pipeline over each subset, and the relation it ends with
+	double bestCost[numMasks];
+	int bestLast[numMasks], bestAccess[numMasks], bestEdge[numMasks];
+
+	for (int mask = 1; mask < numMasks; mask++)
+	{
+		bestCost[mask] = -1;
+
+		for (int rel = 0; rel < numRels; rel++)
+		{
+			if (!(mask & (1 << rel))) continue;
+
+			int outerMask = mask & ~(1 << rel);
+			AccessChoice choice;
+
+			// the first relation is scanned once
+			if (outerMask == 0)
+				choice = AccessChoice {numBlocks(&inputs[rel]), ACCESS_SCAN, -1};
+			else
+				choice = cheapestAccess(rel, outerMask, cardinality[outerMask], inputs, numEdges, edges,
+										edgeSelectivity, memoryShare);
+
+			double cost = (outerMask == 0 ? 0 : bestCost[outerMask]) + choice.cost + TUPLE_COST * cardinality[mask];
+
+			if (bestCost[mask] < 0 || cost < bestCost[mask])
+			{
+				bestCost[mask] = cost;
+				bestLast[mask] = rel, bestAccess[mask] = choice.access, bestEdge[mask] = choice.edge;
+			}
+		}
+	}
+
+	// walk back from the whole set to recover the order
+	plan->numRels = numRels;
+	plan->cost = bestCost[numMasks - 1];
+
+	for (int mask = numMasks - 1, step = numRels - 1; step >= 0; step--)
+	{
+		int rel = bestLast[mask];
+
+		plan->order[step] = rel;
+		plan->access[step] = bestAccess[mask];
+		plan->lookupEdge[step] = bestEdge[mask];
+		plan->cardinality[step] = cardinality[mask];
+
+		mask &= ~(1 << rel);
+	}
+
+	return SUCCESS;
+}
@@ -0,0 +1,62 @@
+#ifndef NITCBASE_JOINPLANNER_H
+#define NITCBASE_JOINPLANNER_H
+
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/AttrStatsTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../define/constants.h"
+#include "Join.h"
+
+/*
+    Picks the order in which the relations of a multi-way join are joined,
+    and how the records of each of them are found, for Join::pipelinedJoin().
+
+    The plans considered are left-deep pipelines: the first relation is
+    scanned, and every tuple that comes out of a step is looked up in the
+    next relation (in its B+ tree, an in-memory hash table or TransientIndex
+    built on it, or by a scan of it). Nothing is written to the disk in
+    between. The cheapest such plan is found by dynamic programming over the
+    subsets of the relations, costing each plan in blocks read:
+        * the number of records after each step is estimated from #Records
+          of the relations and the selectivity of the conditions between
+          them: 1 / (number of distinct values) for `=` (AttrStatsTable, if
+          the statistics of the relation are complete, and #Records
+          otherwise; the planner never reads a relation to get them), and
+          1/3 for `<`, `<=`, `>` and `>=`
+        * a scan costs the blocks of the relation, once per tuple looked up
+        * a B+ tree lookup costs its height plus a block per record found
+        * a hash table or TransientIndex costs one scan to build, plus (for
+          the TransientIndex) a block per record found, and is only chosen if
+          it fits in its share of OPERATOR_MEMORY_BLOCKS
+    plus a small cost per tuple produced, which favours orders that keep the
+    intermediate results small.
+*/
+
+// a condition `relation rel1's attribute op relation rel2's attribute` of a
+// multi-way join (rel1 and rel2 index the relations of the join)
+typedef struct JoinEdge {
+  int rel1;
+  int attrOffset1;
+  int op;
+  int rel2;
+  int attrOffset2;
+  int attrType;
+} JoinEdge;
+
+typedef struct JoinPlan {
+  int numRels;
+  int order[MAX_JOIN_RELATIONS];          // the relations, in the order they are joined in
+  int access[MAX_JOIN_RELATIONS];         // how the records of order[i] are found (JoinAccess)
+  int lookupEdge[MAX_JOIN_RELATIONS];     // the condition they are looked up on (-1 for a scan)
+  double cardinality[MAX_JOIN_RELATIONS]; // estimated number of tuples after joining order[i]
+  double cost;
+} JoinPlan;
+
+class JoinPlanner {
+ public:
+  // plan the join of inputs[0..numRels-1] (only relId, numAttrs and
+  // numRecords of the inputs are used) on the conjunction of the edges
+  static int plan(int numRels, JoinInput inputs[], int numEdges, JoinEdge edges[], JoinPlan *plan);
+};
+
+#endif  // NITCBASE_JOINPLANNER_H
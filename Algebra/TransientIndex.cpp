@@ -0,0 +1,74 @@
+#include "TransientIndex.h"
+
+#include <algorithm>
+
+TransientIndex::TransientIndex(int relId, int attrOffset, int attrType)
+{
+	this->relId = relId;
+	this->attrOffset = attrOffset;
+	this->attrType = attrType;
+}
+
+int TransientIndex::build()
+{
+	RelCatEntry relCatEntry;
+	int ret = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	entries.clear();
+	entries.reserve(relCatEntry.numRecs);
+
+	Attribute record[relCatEntry.numAttrs];
+
+	ScanCursor cursor (relId);
+	while (cursor.next(record) == SUCCESS)
+	{
+		RecId recId = cursor.getRecId();
+
+		Index entry;
+		entry.attrVal = record[attrOffset];
+		entry.block = recId.block, entry.slot = recId.slot;
+		entries.push_back(entry);
+	}
+
+	// (stable, so that equal values keep the order of the records on disk)
+	std::stable_sort(entries.begin(), entries.end(), [this](const Index &lhs, const Index &rhs) {
+		return compareAttrs(lhs.attrVal, rhs.attrVal, attrType) < 0;
+	});
+
+	return SUCCESS;
+}
+
+int TransientIndex::lowerBound(Attribute attrVal)
+{
+	auto entry = std::lower_bound(entries.begin(), entries.end(), attrVal, [this](const Index &lhs, Attribute rhs) {
+		return compareAttrs(lhs.attrVal, rhs, attrType) < 0;
+	});
+
+	return entry - entries.begin();
+}
+
+int TransientIndex::upperBound(Attribute attrVal)
+{
+	auto entry = std::upper_bound(entries.begin(), entries.end(), attrVal, [this](Attribute lhs, const Index &rhs) {
+		return compareAttrs(lhs, rhs.attrVal, attrType) < 0;
+	});
+
+	return entry - entries.begin();
+}
+
+int TransientIndex::getNumEntries()
+{
+	return entries.size();
+}
+
+Index *TransientIndex::getEntry(int position)
+{
+	return &entries[position];
+}
+
+void TransientIndex::release()
+{
+	// (swap with an empty vector, so that the memory is really given back)
+	std::vector<Index>().swap(entries);
+}
@@ -0,0 +1,41 @@
+#ifndef NITCBASE_TRANSIENTINDEX_H
+#define NITCBASE_TRANSIENTINDEX_H
+
+#include <vector>
+
+#include "../BlockAccess/ScanCursor.h"
+#include "../define/constants.h"
+
+/*
+    An in-memory stand-in for a B+ tree on one attribute of an open relation:
+    the (attribute value, rec-id) pairs of all its records, sorted on the
+    value. It is built by one scan of the relation for the duration of a
+    single operation (e.g. a join on an unindexed attribute) and released
+    after it, so the relation's catalog and disk blocks are left untouched.
+
+    The entries are held as Index structs, the same as in a leaf of a B+ tree.
+*/
+class TransientIndex {
+ public:
+  TransientIndex(int relId, int attrOffset, int attrType);
+
+  int build();
+
+  // position of the first entry with value >= attrVal (lowerBound) or
+  // value > attrVal (upperBound); getNumEntries() if there is none
+  int lowerBound(Attribute attrVal);
+  int upperBound(Attribute attrVal);
+
+  int getNumEntries();
+  Index *getEntry(int position);
+
+  void release();
+
+ private:
+  int relId;
+  int attrOffset;
+  int attrType;
+  std::vector<Index> entries;
+};
+
+#endif  // NITCBASE_TRANSIENTINDEX_H
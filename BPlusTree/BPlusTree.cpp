@@ -2,6 +2,8 @@
 
 #include <cstring>
 
+#include "IndexBuilder.h"
+
 inline bool operator == (RecId lhs, RecId rhs) {
 	return (lhs.block == rhs.block && lhs.slot == rhs.slot);
 }
@@ -259,77 +261,10 @@ int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE])
     if (attrCatEntryBuffer.rootBlock != -1)
         return SUCCESS;
 
-    /******Creating a new B+ Tree ******/
-
-    // get a free leaf block using constructor 1 to allocate a new block
-    IndLeaf rootBlockBuf;
-
-    // (if the block could not be allocated, the appropriate error code
-    //  will be stored in the blockNum member field of the object)
-
-    // declare rootBlock to store the blockNumber of the new leaf block
-    int rootBlock = rootBlockBuf.getBlockNum();
-
-    // if there is no more disk space for creating an index
-    if (rootBlock == E_DISKFULL) return E_DISKFULL;
-
-    attrCatEntryBuffer.rootBlock = rootBlock;
-    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntryBuffer);
-
-    RelCatEntry relCatEntryBuffer;
-
-    // load the relation catalog entry into relCatEntry
-    // using RelCacheTable::getRelCatEntry().
-    RelCacheTable::getRelCatEntry(relId, &relCatEntryBuffer);
-    int block = relCatEntryBuffer.firstBlk; // first record block of the relation 
-
-    /***** Traverse all the blocks in the relation and insert them one
-           by one into the B+ Tree *****/
-    while (block != -1) {
-        // declare a RecBuffer object for `block` (using appropriate constructor)
-        RecBuffer blockBuffer (block);
-
-        // load the slot map into slotMap using RecBuffer::getSlotMap().
-        unsigned char slotmap[relCatEntryBuffer.numSlotsPerBlk];
-        blockBuffer.getSlotMap(slotmap);
-
-        for (int slot = 0; slot < relCatEntryBuffer.numSlotsPerBlk; slot++)
-        {
-            if (slotmap[slot] == SLOT_OCCUPIED)
-            {
-                Attribute record[relCatEntryBuffer.numAttrs];
-                // load the record corresponding to the slot into `record`
-                // using RecBuffer::getRecord().
-                blockBuffer.getRecord(record, slot);
-
-                // declare recId and store the rec-id of this record in it
-                // RecId recId{block, slot};
-                RecId recId = RecId{block, slot};
-
-                // insert the attribute value corresponding to attrName from the record
-                // into the B+ tree using bPlusInsert.
-                // (note that bPlusInsert will destroy any existing bplus tree if
-                // insert fails i.e when disk is full)
-
-                ret = bPlusInsert(relId, attrName, 
-                                    record[attrCatEntryBuffer.offset], recId);
-
-                if (ret == E_DISKFULL) {
-                    // (unable to get enough blocks to build the B+ Tree.)
-                    return E_DISKFULL;
-                }
-            }
-        }
-        
-        // get the header of the block using BlockBuffer::getHeader()
-        HeadInfo blockHeader;
-        blockBuffer.getHeader(&blockHeader);
-
-        // set block = rblock of current block (from the header)
-        block = blockHeader.rblock;
-    }
-
-    return SUCCESS;
+    // sort the (value, rec-id) pairs of the relation with the workers and
+    // build the tree bottom-up (see IndexBuilder), instead of inserting the
+    // records into it one by one
+    return IndexBuilder::build(relId, attrName, WorkerPool::getDefaultWorkers());
 }
 
 int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], 
@@ -651,6 +586,11 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE],
 
     Update the lChild of the internalEntry immediately following the newly added
     entry to the rChild of the newly added entry.
+
+    The new entry goes right where the child that was split (its lChild) is:
+    with duplicate values, the first entry greater than it may be further
+    along, and putting the entry there would hang the new child off the
+    wrong entries and leave the leaves out of order.
     */
 
     // bool inserted = false;
@@ -660,9 +600,9 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE],
         InternalEntry internalBlockEntry;
         internalBlock.getEntry(&internalBlockEntry, entryindex);
 
-        if (compareAttrs(internalBlockEntry.attrVal, intEntry.attrVal, attrCatEntryBuffer.attrType) <= 0)
+        if (internalBlockEntry.lChild != intEntry.lChild)
         {
-            // the new value is lesser (or equal to), hence does not go here
+            // the split child is further along, hence the entry does not go here
             internalEntries[entryindex] = internalBlockEntry;
         }
         else 
@@ -1002,6 +942,194 @@ int BPlusTree::bPlusDestroy(int rootBlockNum) {
         return E_INVALIDBLOCK;
 }
 
+/*
+    Index-only lookups: these read only index blocks, never the record
+    blocks the index entries point to.
+*/
+
+// the leaf with the first entry that can satisfy `attrVal op` (the leftmost
+// leaf for LT, LE and NE, whose matches start at the smallest value)
+int BPlusTree::findFirstLeaf(int rootBlock, Attribute attrVal, int attrType, int op)
+{
+    int block = rootBlock;
+
+    while (block != -1 && StaticBuffer::getStaticBlockType(block) == IND_INTERNAL)
+    {
+        IndInternal internalBlk (block);
+
+        HeadInfo intHead;
+        internalBlk.getHeader(&intHead);
+
+        InternalEntry intEntry;
+
+        if (op == NE || op == LT || op == LE)
+        {
+            internalBlk.getEntry(&intEntry, 0);
+            block = intEntry.lChild;
+            continue;
+        }
+
+        // (EQ, GE and GT: the left child of the first entry that is >= (or,
+        // for GT, >) attrVal, or the right child of the last entry)
+        int entryIndex = 0;
+        for (; entryIndex < intHead.numEntries; entryIndex++)
+        {
+            internalBlk.getEntry(&intEntry, entryIndex);
+
+            int cmpVal = compareAttrs(intEntry.attrVal, attrVal, attrType);
+            if (op == GT ? cmpVal > 0 : cmpVal >= 0) break;
+        }
+
+        block = entryIndex < intHead.numEntries ? intEntry.lChild : intEntry.rChild;
+    }
+
+    return block;
+}
+
+// the entry with the smallest value in the B+ tree; E_NOTFOUND if it is empty
+int BPlusTree::getFirstEntry(int rootBlock, Index *entry)
+{
+    if (rootBlock == -1) return E_NOINDEX;
+
+    // move down the leftmost path, always taking the left child of the
+    // first entry of an internal block
+    int block = rootBlock;
+    while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL)
+    {
+        IndInternal internalBlk (block);
+
+        InternalEntry intEntry;
+        internalBlk.getEntry(&intEntry, 0);
+
+        block = intEntry.lChild;
+    }
+
+    IndLeaf leafBlk (block);
+
+    HeadInfo leafHead;
+    leafBlk.getHeader(&leafHead);
+
+    if (leafHead.numEntries == 0) return E_NOTFOUND;
+
+    return leafBlk.getEntry(entry, 0);
+}
+
+// the entry with the largest value in the B+ tree; E_NOTFOUND if it is empty
+int BPlusTree::getLastEntry(int rootBlock, Index *entry)
+{
+    if (rootBlock == -1) return E_NOINDEX;
+
+    // move down the rightmost path, always taking the right child of the
+    // last entry of an internal block
+    int block = rootBlock;
+    while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL)
+    {
+        IndInternal internalBlk (block);
+
+        HeadInfo intHead;
+        internalBlk.getHeader(&intHead);
+
+        InternalEntry intEntry;
+        internalBlk.getEntry(&intEntry, intHead.numEntries - 1);
+
+        block = intEntry.rChild;
+    }
+
+    IndLeaf leafBlk (block);
+
+    HeadInfo leafHead;
+    leafBlk.getHeader(&leafHead);
+
+    if (leafHead.numEntries == 0) return E_NOTFOUND;
+
+    return leafBlk.getEntry(entry, leafHead.numEntries - 1);
+}
+
+/*
+    Counts the entries of the B+ tree on attrName that satisfy `attrVal op`
+    (i.e. the records of the relation that do). The leaves are walked from
+    the first one that can hold a match: a leaf whose first and last entries
+    both satisfy the condition is counted from its header alone, and only
+    the leaves where the matches start or end are looked at entry by entry.
+    `!=` is counted as #Records minus the count of `=`.
+*/
+int BPlusTree::bPlusCount(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op, int *count)
+{
+    AttrCatEntry attrCatEntry;
+    int ret = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (ret != SUCCESS) return ret;
+
+    if (attrCatEntry.rootBlock == -1) return E_NOINDEX;
+
+    if (op == NE)
+    {
+        RelCatEntry relCatEntry;
+        RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+        int numEqual;
+        ret = bPlusCount(relId, attrName, attrVal, EQ, &numEqual);
+        if (ret != SUCCESS) return ret;
+
+        *count = relCatEntry.numRecs - numEqual;
+        return SUCCESS;
+    }
+
+    int attrType = attrCatEntry.attrType;
+    auto satisfies = [&](Attribute value) {
+        int cmpVal = compareAttrs(value, attrVal, attrType);
+        return (op == EQ && cmpVal == 0) || (op == LE && cmpVal <= 0) || (op == LT && cmpVal < 0) ||
+               (op == GE && cmpVal >= 0) || (op == GT && cmpVal > 0);
+    };
+
+    *count = 0;
+    bool started = false;
+
+    for (int block = findFirstLeaf(attrCatEntry.rootBlock, attrVal, attrType, op); block != -1; )
+    {
+        IndLeaf leafBlk (block);
+
+        HeadInfo leafHead;
+        leafBlk.getHeader(&leafHead);
+
+        if (leafHead.numEntries > 0)
+        {
+            Index firstEntry, lastEntry;
+            leafBlk.getEntry(&firstEntry, 0);
+            leafBlk.getEntry(&lastEntry, leafHead.numEntries - 1);
+
+            // (the values between the first and the last satisfy it too)
+            if (satisfies(firstEntry.attrVal) && satisfies(lastEntry.attrVal))
+            {
+                *count += leafHead.numEntries;
+                started = true;
+            }
+            else
+            {
+                for (int index = 0; index < leafHead.numEntries; index++)
+                {
+                    Index leafEntry;
+                    leafBlk.getEntry(&leafEntry, index);
+
+                    if (satisfies(leafEntry.attrVal))
+                    {
+                        (*count)++;
+                        started = true;
+                    }
+                    // the matches are a contiguous stretch of the leaves;
+                    // once it has ended, nothing to the right matches
+                    else if (started || ((op == EQ || op == LE || op == LT) &&
+                                         compareAttrs(leafEntry.attrVal, attrVal, attrType) > 0))
+                        return SUCCESS;
+                }
+            }
+        }
+
+        block = leafHead.rblock;
+    }
+
+    return SUCCESS;
+}
+
 
 
 
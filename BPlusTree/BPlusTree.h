@@ -21,6 +21,12 @@ class BPlusTree {
   static int bPlusInsert(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recordId);
   static RecId bPlusSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, int op);
   static int bPlusDestroy(int rootBlockNum);
+
+  // answered from the index blocks alone
+  static int findFirstLeaf(int rootBlock, Attribute attrVal, int attrType, int op);
+  static int getFirstEntry(int rootBlock, Index *entry);
+  static int getLastEntry(int rootBlock, Index *entry);
+  static int bPlusCount(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, int op, int *count);
 };
 
 #endif  // NITCBASE_BPLUSTREE_H
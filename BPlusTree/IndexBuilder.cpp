@@ -0,0 +1,393 @@
+#include "IndexBuilder.h"
+
+#include <algorithm>
+#include <cstring>
+
+bool IndexBuilder::fits(int relId)
+{
+	RelCatEntry relCatEntry;
+	if (RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS) return false;
+
+	// (the runs being merged and the runs merged from them are held at once)
+	return 2.0 * relCatEntry.numRecs * sizeof(Index) <= (double)INDEX_BUILD_MEMORY_BLOCKS * BLOCK_SIZE;
+}
+
+// the pairs of the records in the blocks [firstBlock, lastBlock) of `blocks`,
+// sorted on their values (run by a worker)
+int IndexBuilder::extractRun(std::vector<int> &blocks, int firstBlock, int lastBlock,
+							 int attrOffset, int attrType, std::vector<Index> &run)
+{
+	unsigned char block[BLOCK_SIZE];
+
+	for (int blockIndex = firstBlock; blockIndex < lastBlock; blockIndex++)
+	{
+		int ret = StaticBuffer::copyBlock(blocks[blockIndex], block);
+		if (ret != SUCCESS) return ret;
+
+		HeadInfo blockHeader;
+		memcpy(&blockHeader, block, sizeof(HeadInfo));
+
+		// the slotmap follows the header, and the record at slot s is at
+		// HEADER_SIZE + numSlots + s * recordSize
+		unsigned char *slotMap = block + HEADER_SIZE;
+		unsigned char *records = slotMap + blockHeader.numSlots;
+		int recordSize = blockHeader.numAttrs * ATTR_SIZE;
+
+		for (int slot = 0; slot < blockHeader.numSlots; slot++)
+		{
+			if (slotMap[slot] != SLOT_OCCUPIED) continue;
+
+			Index entry {};
+			memcpy(&entry.attrVal, records + slot * recordSize + attrOffset * ATTR_SIZE, ATTR_SIZE);
+			entry.block = blocks[blockIndex], entry.slot = slot;
+
+			run.push_back(entry);
+		}
+	}
+
+	// (stable, so that pairs with equal values stay in the order of the records)
+	std::stable_sort(run.begin(), run.end(), [attrType](const Index &lhs, const Index &rhs) {
+		return compareAttrs(lhs.attrVal, rhs.attrVal, attrType) < 0;
+	});
+
+	return SUCCESS;
+}
+
+// the pairs of all the records in `blocks`, sorted on their values
+int IndexBuilder::sortRuns(std::vector<int> &blocks, int attrOffset, int attrType,
+						   WorkerPool &pool, std::vector<Index> &entries)
+{
+	int numRuns = (blocks.size() + MORSEL_BLOCKS - 1) / MORSEL_BLOCKS;
+	if (numRuns == 0) return SUCCESS;
+
+	// a run for each morsel, sorted by the worker that takes it
+	std::vector<std::vector<Index>> runs (numRuns);
+	std::vector<int> statuses (numRuns, SUCCESS);
+
+	pool.run(numRuns, [&](int run, int worker) {
+		int firstBlock = run * MORSEL_BLOCKS;
+		int lastBlock = std::min(firstBlock + MORSEL_BLOCKS, (int)blocks.size());
+
+		statuses[run] = extractRun(blocks, firstBlock, lastBlock, attrOffset, attrType, runs[run]);
+	});
+
+	for (int status : statuses)
+		if (status != SUCCESS) return status;
+
+	auto before = [attrType](const Index &lhs, const Index &rhs) {
+		return compareAttrs(lhs.attrVal, rhs.attrVal, attrType) < 0;
+	};
+
+	// merge every two neighbouring runs into one until a single run is left
+	// (std::merge takes equal pairs from the left run first, which holds the
+	// earlier records)
+	while (runs.size() > 1)
+	{
+		int numMerged = (runs.size() + 1) / 2;
+		std::vector<std::vector<Index>> merged (numMerged);
+
+		pool.run(numMerged, [&](int pair, int worker) {
+			std::vector<Index> &left = runs[2 * pair];
+
+			// (an odd run out is carried over to the next round as it is)
+			if (2 * pair + 1 == (int)runs.size())
+			{
+				merged[pair].swap(left);
+				return;
+			}
+
+			std::vector<Index> &right = runs[2 * pair + 1];
+
+			merged[pair].resize(left.size() + right.size());
+			std::merge(left.begin(), left.end(), right.begin(), right.end(), merged[pair].begin(), before);
+
+			std::vector<Index>().swap(left);
+			std::vector<Index>().swap(right);
+		});
+
+		runs.swap(merged);
+	}
+
+	entries.swap(runs[0]);
+	return SUCCESS;
+}
+
+// the pairs of all the records in `blocks`, sorted a chunk of blocks at a
+// time (as many as fit in INDEX_BUILD_MEMORY_BLOCKS), each chunk written out
+// as a run of records of two attributes, which hold the bytes of an Index
+int IndexBuilder::spillRuns(std::vector<int> &blocks, int numSlotsPerBlk, int attrOffset, int attrType,
+							WorkerPool &pool, std::vector<SpillFile> &runs)
+{
+	static_assert(sizeof(Index) == 2 * sizeof(Attribute), "an Index is spilled as two attributes");
+
+	// (the pairs of a chunk are held twice while its runs are merged)
+	int maxPairs = (INDEX_BUILD_MEMORY_BLOCKS * BLOCK_SIZE) / (2 * sizeof(Index));
+	int chunkBlocks = std::max(maxPairs / numSlotsPerBlk / MORSEL_BLOCKS, 1) * MORSEL_BLOCKS;
+
+	for (int firstBlock = 0; firstBlock < (int)blocks.size(); firstBlock += chunkBlocks)
+	{
+		int lastBlock = std::min(firstBlock + chunkBlocks, (int)blocks.size());
+		std::vector<int> chunk (blocks.begin() + firstBlock, blocks.begin() + lastBlock);
+
+		std::vector<Index> entries;
+		int ret = sortRuns(chunk, attrOffset, attrType, pool, entries);
+		if (ret != SUCCESS) return ret;
+
+		runs.push_back(SpillFile(2));
+		for (Index &entry : entries)
+		{
+			Attribute record[2];
+			memcpy(record, &entry, sizeof(Index));
+
+			ret = runs.back().append(record);
+			if (ret != SUCCESS) return ret;
+		}
+	}
+
+	return SUCCESS;
+}
+
+// the next pair of a run written by spillRuns(); E_NOTFOUND at its end
+static int readRun(SpillFile &run, Index *entry)
+{
+	Attribute record[2];
+
+	int ret = run.next(record);
+	if (ret == SUCCESS) memcpy(entry, record, sizeof(Index));
+
+	return ret;
+}
+
+// write the numEntries pairs handed out by nextEntry (in sorted order) to
+// leaves linked left to right, filled to INDEX_BUILD_FILL_PERCENT and
+// evenly; `level` gets the leaves and `maxVals` the largest value in each
+int IndexBuilder::writeLeaves(int numEntries, std::function<int(Index *)> nextEntry, std::vector<int> &level,
+							  std::vector<Attribute> &maxVals, std::vector<int> &allocated)
+{
+	int leafCapacity = std::max(MAX_KEYS_LEAF * INDEX_BUILD_FILL_PERCENT / 100, 1);
+
+	// (a relation with no records gets a single empty leaf, as the root)
+	int numLeaves = numEntries == 0 ? 1 : (numEntries + leafCapacity - 1) / leafCapacity;
+
+	for (int leafIndex = 0; leafIndex < numLeaves; leafIndex++)
+	{
+		// (the first numEntries % numLeaves leaves take an entry more than the rest)
+		int leafEntries = numEntries / numLeaves + (leafIndex < numEntries % numLeaves ? 1 : 0);
+
+		IndLeaf leafBlk;
+
+		int leafNum = leafBlk.getBlockNum();
+		if (leafNum == E_DISKFULL) return E_DISKFULL;
+		allocated.push_back(leafNum);
+
+		int prevLeafNum = level.empty() ? -1 : level.back();
+
+		HeadInfo leafHeader;
+		leafBlk.getHeader(&leafHeader);
+		leafHeader.numEntries = leafEntries;
+		leafHeader.lblock = prevLeafNum;
+		leafBlk.setHeader(&leafHeader);
+
+		Attribute maxVal;
+		memset(&maxVal, 0, sizeof(Attribute));
+
+		for (int entryIndex = 0; entryIndex < leafEntries; entryIndex++)
+		{
+			Index entry;
+			int ret = nextEntry(&entry);
+			if (ret != SUCCESS) return ret == E_NOTFOUND ? FAILURE : ret;
+
+			leafBlk.setEntry(&entry, entryIndex);
+			maxVal = entry.attrVal;
+		}
+
+		if (prevLeafNum != -1)
+		{
+			IndLeaf prevLeafBlk (prevLeafNum);
+
+			HeadInfo prevLeafHeader;
+			prevLeafBlk.getHeader(&prevLeafHeader);
+			prevLeafHeader.rblock = leafNum;
+			prevLeafBlk.setHeader(&prevLeafHeader);
+		}
+
+		level.push_back(leafNum);
+		maxVals.push_back(maxVal);
+	}
+
+	return SUCCESS;
+}
+
+// write the internal blocks over the blocks of `level` (with the largest
+// values under them in `maxVals`), and replace the level with them
+int IndexBuilder::writeInternalLevel(std::vector<int> &level, std::vector<Attribute> &maxVals,
+									 std::vector<int> &allocated)
+{
+	int numChildren = level.size();
+
+	// an internal block takes INDEX_BUILD_FILL_PERCENT of the MAX_KEYS_INTERNAL
+	// + 1 children it can have, and when they are spread evenly, never fewer
+	// than two
+	int childCapacity = std::max((MAX_KEYS_INTERNAL + 1) * INDEX_BUILD_FILL_PERCENT / 100, 2);
+	int numBlocks = (numChildren + childCapacity - 1) / childCapacity;
+
+	std::vector<int> parents;
+	std::vector<Attribute> parentMaxVals;
+
+	int firstChild = 0;
+	for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+	{
+		int blockChildren = numChildren / numBlocks + (blockIndex < numChildren % numBlocks ? 1 : 0);
+
+		IndInternal internalBlk;
+
+		int blockNum = internalBlk.getBlockNum();
+		if (blockNum == E_DISKFULL) return E_DISKFULL;
+		allocated.push_back(blockNum);
+
+		HeadInfo blockHeader;
+		internalBlk.getHeader(&blockHeader);
+		blockHeader.numEntries = blockChildren - 1;
+		internalBlk.setHeader(&blockHeader);
+
+		// the entry between two children has the largest value under the left
+		// one, as splitLeaf() and splitInternal() leave it
+		for (int entryIndex = 0; entryIndex < blockChildren - 1; entryIndex++)
+		{
+			InternalEntry entry;
+			entry.lChild = level[firstChild + entryIndex];
+			entry.attrVal = maxVals[firstChild + entryIndex];
+			entry.rChild = level[firstChild + entryIndex + 1];
+
+			internalBlk.setEntry(&entry, entryIndex);
+		}
+
+		for (int child = firstChild; child < firstChild + blockChildren; child++)
+		{
+			BlockBuffer childBlk (level[child]);
+
+			HeadInfo childHeader;
+			childBlk.getHeader(&childHeader);
+			childHeader.pblock = blockNum;
+			childBlk.setHeader(&childHeader);
+		}
+
+		parents.push_back(blockNum);
+		parentMaxVals.push_back(maxVals[firstChild + blockChildren - 1]);
+
+		firstChild += blockChildren;
+	}
+
+	level.swap(parents);
+	maxVals.swap(parentMaxVals);
+
+	return SUCCESS;
+}
+
+int IndexBuilder::build(int relId, char attrName[ATTR_SIZE], int numWorkers)
+{
+	AttrCatEntry attrCatEntry;
+	int ret = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+	int attrType = attrCatEntry.attrType;
+
+	// the record blocks that hold any record, in rblock order (only their
+	// headers are looked at here)
+	std::vector<int> blocks;
+	for (int block = relCatEntry.firstBlk; block != -1; )
+	{
+		RecBuffer blockBuffer (block);
+
+		HeadInfo blockHeader;
+		blockBuffer.getHeader(&blockHeader);
+
+		if (blockHeader.numEntries > 0) blocks.push_back(block);
+		block = blockHeader.rblock;
+	}
+
+	// the sorted pairs: in memory, or in sorted runs on the disk
+	std::vector<Index> entries;
+	std::vector<SpillFile> runs;
+	{
+		WorkerPool pool (numWorkers);
+
+		if (fits(relId))
+			ret = sortRuns(blocks, attrCatEntry.offset, attrType, pool, entries);
+		else
+			ret = spillRuns(blocks, relCatEntry.numSlotsPerBlk, attrCatEntry.offset, attrType, pool, runs);
+	}
+
+	// the tree is written by this thread alone, from the leaves up
+	std::vector<int> level, allocated;
+	std::vector<Attribute> maxVals;
+
+	if (ret == SUCCESS)
+	{
+		// the runs are merged as the leaves are written: the first unread pair
+		// of every run is held, and the smallest of them goes next (that of the
+		// earliest run on a tie, so that equal pairs stay in the order of the
+		// records; there are only a few runs, so they are simply scanned)
+		int numEntries = entries.size();
+		std::vector<Index> heads (runs.size());
+		std::vector<bool> headValid (runs.size());
+
+		for (int run = 0; run < (int)runs.size(); run++)
+		{
+			numEntries += runs[run].getNumRecords();
+			headValid[run] = readRun(runs[run], &heads[run]) == SUCCESS;
+		}
+
+		int position = 0;
+		auto nextEntry = [&](Index *entry) {
+			if (runs.empty())
+			{
+				*entry = entries[position++];
+				return SUCCESS;
+			}
+
+			int smallest = -1;
+			for (int run = 0; run < (int)runs.size(); run++)
+			{
+				if (headValid[run] &&
+					(smallest == -1 || compareAttrs(heads[run].attrVal, heads[smallest].attrVal, attrType) < 0))
+					smallest = run;
+			}
+			if (smallest == -1) return E_NOTFOUND;
+
+			*entry = heads[smallest];
+			headValid[smallest] = readRun(runs[smallest], &heads[smallest]) == SUCCESS;
+
+			return SUCCESS;
+		};
+
+		ret = writeLeaves(numEntries, nextEntry, level, maxVals, allocated);
+	}
+
+	std::vector<Index>().swap(entries);
+	for (SpillFile &run : runs)
+		run.release();
+
+	while (ret == SUCCESS && level.size() > 1)
+		ret = writeInternalLevel(level, maxVals, allocated);
+
+	if (ret != SUCCESS)
+	{
+		// (the tree is not connected yet, so its blocks are given back one by one)
+		for (int blockNum : allocated)
+		{
+			BlockBuffer blockBuffer (blockNum);
+			blockBuffer.releaseBlock();
+		}
+
+		return ret;
+	}
+
+	attrCatEntry.rootBlock = level[0];
+	AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+	return SUCCESS;
+}
@@ -0,0 +1,67 @@
+#ifndef NITCBASE_INDEXBUILDER_H
+#define NITCBASE_INDEXBUILDER_H
+
+#include <functional>
+#include <vector>
+
+#include "../BlockAccess/SpillFile.h"
+#include "../BlockAccess/WorkerPool.h"
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../define/constants.h"
+
+/*
+    Builds the B+ tree of an attribute of an open relation bottom-up, for
+    BPlusTree::bPlusCreate(), instead of inserting the records into it one at
+    a time:
+        * the record blocks are enumerated up front by following the rblock
+          links of their headers, and cut into morsels of MORSEL_BLOCKS
+          blocks
+        * the workers of a WorkerPool each take morsels, copy their blocks
+          (StaticBuffer::copyBlock()), extract the (value, rec-id) pair of
+          every record and sort the pairs of the morsel into a run
+        * the runs are then merged in rounds, the workers merging pairs of
+          neighbouring runs at the same time, until a single one is left
+        * finally, the calling thread alone writes the sorted pairs out to
+          leaves, linked left to right, and the internal levels over them,
+          one level at a time up to the root
+    Pairs with equal values stay in the order of the records in the
+    relation, whatever the number of workers. Every block is filled to
+    INDEX_BUILD_FILL_PERCENT of its capacity (the entries spread evenly), so
+    that the inserts that follow have room before a block splits, where the
+    one-at-a-time build leaves them half full after every split. The workers
+    never touch the buffer or the caches: the blocks are allocated and
+    written only by the calling thread, after they are done.
+
+    The pairs are held in memory (twice, while the runs are merged) if they
+    fit in INDEX_BUILD_MEMORY_BLOCKS. For a larger relation, the morsels are
+    sorted the same way a chunk of blocks at a time, as many as fit, and the
+    sorted pairs of each chunk are written out to a SpillFile; the leaves are
+    then written as the chunks are merged.
+*/
+class IndexBuilder {
+ public:
+  // build the B+ tree of attribute `attrName` of the relation, which must not
+  // have one yet, and set it as its root block in the attribute cache;
+  // E_DISKFULL (with every block taken so far given back) if the disk fills up
+  static int build(int relId, char attrName[ATTR_SIZE], int numWorkers);
+
+ private:
+  // whether the pairs of the relation fit in INDEX_BUILD_MEMORY_BLOCKS
+  static bool fits(int relId);
+
+  static int extractRun(std::vector<int> &blocks, int firstBlock, int lastBlock,
+                        int attrOffset, int attrType, std::vector<Index> &run);
+  static int sortRuns(std::vector<int> &blocks, int attrOffset, int attrType,
+                      WorkerPool &pool, std::vector<Index> &entries);
+  static int spillRuns(std::vector<int> &blocks, int numSlotsPerBlk, int attrOffset, int attrType,
+                       WorkerPool &pool, std::vector<SpillFile> &runs);
+  static int writeLeaves(int numEntries, std::function<int(Index *)> nextEntry, std::vector<int> &level,
+                         std::vector<Attribute> &maxVals, std::vector<int> &allocated);
+  static int writeInternalLevel(std::vector<int> &level, std::vector<Attribute> &maxVals,
+                                std::vector<int> &allocated);
+};
+
+#endif  // NITCBASE_INDEXBUILDER_H
@@ -0,0 +1,47 @@
+#include "LeafCursor.h"
+
+#include "BPlusTree.h"
+
+LeafCursor::LeafCursor(int rootBlock)
+{
+	// move down to the leftmost leaf, always taking the left child of the
+	// first entry of an internal block
+	int block = rootBlock;
+	while (block != -1 && StaticBuffer::getStaticBlockType(block) == IND_INTERNAL)
+	{
+		IndInternal internalBlk (block);
+
+		InternalEntry intEntry;
+		internalBlk.getEntry(&intEntry, 0);
+
+		block = intEntry.lChild;
+	}
+
+	this->block = block;
+	this->index = 0;
+}
+
+LeafCursor::LeafCursor(int rootBlock, Attribute attrVal, int attrType, int op)
+{
+	this->block = BPlusTree::findFirstLeaf(rootBlock, attrVal, attrType, op);
+	this->index = 0;
+}
+
+int LeafCursor::next(Index *entry)
+{
+	while (block != -1)
+	{
+		IndLeaf leafBlk (block);
+
+		HeadInfo leafHead;
+		leafBlk.getHeader(&leafHead);
+
+		if (index < leafHead.numEntries)
+			return leafBlk.getEntry(entry, index++);
+
+		// (this leaf is done; continue with the leaf to its right)
+		block = leafHead.rblock, index = 0;
+	}
+
+	return E_NOTFOUND;
+}
@@ -0,0 +1,32 @@
+#ifndef NITCBASE_LEAFCURSOR_H
+#define NITCBASE_LEAFCURSOR_H
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../define/constants.h"
+
+/*
+    A LeafCursor walks the linked list of leaf blocks of a B+ tree from the
+    leftmost leaf, handing out every index entry (attribute value and rec-id)
+    in ascending order of attribute value. Unlike bPlusSearch(), it descends
+    from the root only once, and it keeps its position in the object instead
+    of in the search index of the attribute cache.
+*/
+class LeafCursor {
+ public:
+  LeafCursor(int rootBlock);
+
+  // start at the first leaf that can hold an entry satisfying `attrVal op`
+  // (BPlusTree::findFirstLeaf()); the entries before the first match in
+  // that leaf are still handed out
+  LeafCursor(int rootBlock, Attribute attrVal, int attrType, int op);
+
+  // copy the next index entry into `entry`; E_NOTFOUND after the last one
+  int next(Index *entry);
+
+ private:
+  int block;
+  int index;
+};
+
+#endif  // NITCBASE_LEAFCURSOR_H
@@ -0,0 +1,298 @@
+#include "AccessPath.h"
+
+#include <cmath>
+#include <cstring>
+
+// selectivity of `<`, `<=`, `>` and `>=` on a STRING, for which the
+// statistics say nothing (the same guess as JoinPlanner's)
+static const double RANGE_SELECTIVITY = 1.0 / 3;
+
+// the smallest and largest value of an attribute over the whole relation,
+// from its zone map (false if the relation has no zone map or no records)
+static bool valueBounds(int relId, int attrOffset, int attrType, Attribute *minVal, Attribute *maxVal)
+{
+	bool found = false;
+
+	for (ZoneMapEntry *zone = ZoneMapTable::getZoneMap(relId); zone != nullptr; zone = zone->next)
+	{
+		if (zone->numEntries == 0) continue;
+
+		if (!found || compareAttrs(zone->minVal[attrOffset], *minVal, attrType) < 0)
+			*minVal = zone->minVal[attrOffset];
+		if (!found || compareAttrs(zone->maxVal[attrOffset], *maxVal, attrType) > 0)
+			*maxVal = zone->maxVal[attrOffset];
+
+		found = true;
+	}
+
+	return found;
+}
+
+// the fraction of the records of the relation that satisfy a single comparison
+static double leafSelectivity(int relId, int numRecords, PredicateNode *node)
+{
+	double distinct;
+	if (AttrStatsTable::getNumDistinct(relId, node->attrOffset, &distinct) != SUCCESS)
+		distinct = numRecords;
+	distinct = fmax(distinct, 1);
+
+	Attribute minVal, maxVal;
+	bool bounded = valueBounds(relId, node->attrOffset, node->attrType, &minVal, &maxVal);
+
+	// (a value outside [min, max] matches nothing with `=`, and everything with `!=`)
+	bool inside = !bounded || (compareAttrs(node->attrVal, minVal, node->attrType) >= 0 &&
+							   compareAttrs(node->attrVal, maxVal, node->attrType) <= 0);
+
+	if (node->op == EQ) return inside ? 1 / distinct : 0;
+	if (node->op == NE) return inside ? 1 - 1 / distinct : 1;
+
+	if (node->attrType == STRING || !bounded) return RANGE_SELECTIVITY;
+
+	// the values of a NUMBER attribute are taken to be spread evenly over [min, max]
+	double below;
+	if (maxVal.nVal == minVal.nVal)
+		below = node->attrVal.nVal > minVal.nVal ? 1 : 0;
+	else
+		below = fmin(fmax((node->attrVal.nVal - minVal.nVal) / (maxVal.nVal - minVal.nVal), 0), 1);
+
+	// (the records equal to the value are on the `<=` and `>=` side)
+	double equal = inside ? 1 / distinct : 0;
+
+	switch (node->op)
+	{
+		case LT: return below;
+		case LE: return fmin(below + equal, 1);
+		case GT: return fmax(1 - below - equal, 0);
+		case GE: return 1 - below;
+	}
+
+	return 1;
+}
+
+// the fraction of the records that satisfy a single comparison, from the
+// catalog alone (every value is taken to be distinct)
+static double catalogSelectivity(int numRecords, PredicateNode *node)
+{
+	if (node->op == EQ) return 1 / fmax(numRecords, 1);
+	if (node->op == NE) return 1 - 1 / fmax(numRecords, 1);
+
+	return RANGE_SELECTIVITY;
+}
+
+// the fraction of the records that satisfy `node` (withStats is false to
+// estimate it from the catalog alone)
+static double selectivity(int relId, int numRecords, PredicateNode *node, bool withStats)
+{
+	if (node->type == PRED_COMPARE)
+		return withStats ? leafSelectivity(relId, numRecords, node) : catalogSelectivity(numRecords, node);
+
+	double left = selectivity(relId, numRecords, node->left, withStats);
+	double right = selectivity(relId, numRecords, node->right, withStats);
+
+	return node->type == PRED_AND ? left * right : left + right - left * right;
+}
+
+// height of a B+ tree on a relation with numRecords records
+static double treeHeight(int numRecords)
+{
+	return 1 + ceil(log(fmax(numRecords / (double)MAX_KEYS_LEAF, 1)) / log(MAX_KEYS_INTERNAL));
+}
+
+/*
+	Blocks read by Predicate::indexSearch() (or, for a single comparison,
+	bPlusSearch()) to find the rec-ids of the records satisfying `node`, and
+	the number of rec-ids it ends up with; -1 if the B+ trees of the relation
+	cannot answer `node` (the same rules as indexSearch()).
+*/
+static double indexWalkCost(int relId, int numRecords, PredicateNode *node, double *numCandidates)
+{
+	if (node->type == PRED_COMPARE)
+	{
+		if (node->rootBlock == -1 || node->op == NE) return -1;
+
+		*numCandidates = numRecords * leafSelectivity(relId, numRecords, node);
+		return treeHeight(numRecords) + *numCandidates / MAX_KEYS_LEAF;
+	}
+
+	double leftCandidates, rightCandidates;
+	double leftCost = indexWalkCost(relId, numRecords, node->left, &leftCandidates);
+	double rightCost = indexWalkCost(relId, numRecords, node->right, &rightCandidates);
+
+	if (node->type == PRED_OR && (leftCost < 0 || rightCost < 0)) return -1;
+	if (leftCost < 0 && rightCost < 0) return -1;
+
+	// an AND with only one side answered keeps the rec-ids of that side
+	if (leftCost < 0)
+	{
+		*numCandidates = rightCandidates;
+		return rightCost;
+	}
+	if (rightCost < 0)
+	{
+		*numCandidates = leftCandidates;
+		return leftCost;
+	}
+
+	double leftFraction = leftCandidates / fmax(numRecords, 1);
+	double rightFraction = rightCandidates / fmax(numRecords, 1);
+
+	if (node->type == PRED_AND)
+		*numCandidates = numRecords * leftFraction * rightFraction;
+	else
+		*numCandidates = numRecords * (leftFraction + rightFraction - leftFraction * rightFraction);
+
+	return leftCost + rightCost;
+}
+
+// the fraction of the leaf entries an index-only scan walks for `node`: the
+// comparisons joined by AND (other than `!=`) bound the walk, an OR does not
+// (withStats is false to estimate it from the catalog alone)
+static double walkedFraction(int relId, int numRecords, PredicateNode *node, bool withStats)
+{
+	if (node == nullptr) return 1;
+
+	if (node->type == PRED_COMPARE)
+	{
+		if (node->op == NE) return 1;
+		return withStats ? leafSelectivity(relId, numRecords, node) : catalogSelectivity(numRecords, node);
+	}
+	if (node->type == PRED_OR) return 1;
+
+	return walkedFraction(relId, numRecords, node->left, withStats) *
+		   walkedFraction(relId, numRecords, node->right, withStats);
+}
+
+// whether every comparison of `node` is on attrName
+static bool onlyOn(PredicateNode *node, char attrName[ATTR_SIZE])
+{
+	if (node == nullptr) return true;
+	if (node->type == PRED_COMPARE) return strcmp(node->attrName, attrName) == 0;
+
+	return onlyOn(node->left, attrName) && onlyOn(node->right, attrName);
+}
+
+//* Estimate the cost of a linear search and of a B+ tree search for the records
+//* of the relation with rel-id `relId` that satisfy `condition` (already resolved
+//* against the relation), and pick the cheaper one
+int AccessPath::estimate(int relId, PredicateNode *condition, AccessPathEstimate *estimate)
+{
+	RelCatEntry relCatEntry;
+	int ret = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	estimate->numRecords = relCatEntry.numRecs;
+
+	// a linear search skips the blocks whose zone cannot match; the records
+	// in the blocks it reads bound the number of matches
+	ZoneMapEntry *zoneMap = ZoneMapTable::getZoneMap(relId);
+	double candidateRecords = relCatEntry.numRecs;
+
+	if (zoneMap == nullptr)
+	{
+		// (without a zone map, the blocks are taken to be full)
+		estimate->numBlocks = ceil((double)relCatEntry.numRecs / relCatEntry.numSlotsPerBlk);
+		estimate->linearCost = estimate->numBlocks;
+	}
+	else
+	{
+		estimate->numBlocks = 0;
+		estimate->linearCost = 0;
+		candidateRecords = 0;
+
+		for (ZoneMapEntry *zone = zoneMap; zone != nullptr; zone = zone->next)
+		{
+			estimate->numBlocks++;
+			if (condition != nullptr && !Predicate::mayMatch(condition, zone)) continue;
+
+			estimate->linearCost++;
+			candidateRecords += zone->numEntries;
+		}
+	}
+
+	estimate->selectivity = condition == nullptr ? 1 : selectivity(relId, relCatEntry.numRecs, condition, true);
+	estimate->numMatches = fmin(estimate->selectivity * relCatEntry.numRecs, candidateRecords);
+	estimate->coveringOffset = -1;
+	estimate->indexOnlyCost = -1;
+	estimate->numWorkers = 1;
+
+	double numCandidates;
+	estimate->indexCost = condition == nullptr ? -1 : indexWalkCost(relId, relCatEntry.numRecs, condition, &numCandidates);
+
+	if (estimate->indexCost >= 0)
+	{
+		// bPlusSearch() returns a single comparison's records in the order of
+		// their values, each from its own block; indexSearch() sorts the
+		// rec-ids of an AND/OR, so no block is read twice
+		numCandidates = fmin(numCandidates, candidateRecords);
+
+		if (condition->type == PRED_COMPARE)
+			estimate->indexCost += numCandidates;
+		else
+			estimate->indexCost += fmin(numCandidates, estimate->numBlocks);
+	}
+
+	estimate->path = (estimate->indexCost >= 0 && estimate->indexCost < estimate->linearCost) ? PATH_BPLUS : PATH_LINEAR;
+
+	return SUCCESS;
+}
+
+//* Estimate the same paths for a query that needs only the attributes `attrNames`
+//* of the records (a nullptr condition selects every record), and an index-only
+//* scan if every one of them and every attribute of the condition is the same
+//* attribute, and it has a B+ tree
+int AccessPath::estimate(int relId, PredicateNode *condition, int numAttrs, char attrNames[][ATTR_SIZE],
+						 AccessPathEstimate *estimate)
+{
+	RelCatEntry relCatEntry;
+	int ret = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	// whether a B+ tree covers the query is known from the catalog alone
+	bool covered = numAttrs >= 1 && onlyOn(condition, attrNames[0]);
+	for (int attrIndex = 1; attrIndex < numAttrs; attrIndex++)
+		if (strcmp(attrNames[attrIndex], attrNames[0]) != 0) covered = false;
+
+	AttrCatEntry attrCatEntry;
+	if (covered && (AttrCacheTable::getAttrCatEntry(relId, attrNames[0], &attrCatEntry) != SUCCESS ||
+					attrCatEntry.rootBlock == -1))
+		covered = false;
+
+	if (covered)
+	{
+		// an index-only scan that beats reading every block on the catalog's
+		// numbers is taken without looking at any statistics
+		double fraction = walkedFraction(relId, relCatEntry.numRecs, condition, false);
+		double indexOnlyCost = treeHeight(relCatEntry.numRecs) + ceil(relCatEntry.numRecs * fraction / MAX_KEYS_LEAF);
+		int numBlocks = ceil((double)relCatEntry.numRecs / relCatEntry.numSlotsPerBlk);
+
+		if (indexOnlyCost < numBlocks)
+		{
+			estimate->path = PATH_INDEX_ONLY;
+			estimate->numRecords = relCatEntry.numRecs;
+			estimate->numBlocks = numBlocks;
+			estimate->selectivity = condition == nullptr ? 1 : selectivity(relId, relCatEntry.numRecs, condition, false);
+			estimate->numMatches = estimate->selectivity * relCatEntry.numRecs;
+			estimate->linearCost = numBlocks;
+			estimate->indexCost = -1;
+			estimate->coveringOffset = attrCatEntry.offset;
+			estimate->indexOnlyCost = indexOnlyCost;
+			estimate->numWorkers = 1;
+			return SUCCESS;
+		}
+	}
+
+	ret = AccessPath::estimate(relId, condition, estimate);
+	if (ret != SUCCESS) return ret;
+
+	if (!covered) return SUCCESS;
+
+	double entriesWalked = estimate->numRecords * walkedFraction(relId, estimate->numRecords, condition, true);
+
+	estimate->coveringOffset = attrCatEntry.offset;
+	estimate->indexOnlyCost = treeHeight(estimate->numRecords) + ceil(entriesWalked / MAX_KEYS_LEAF);
+
+	double bestCost = estimate->path == PATH_BPLUS ? estimate->indexCost : estimate->linearCost;
+	if (estimate->indexOnlyCost < bestCost) estimate->path = PATH_INDEX_ONLY;
+
+	return SUCCESS;
+}
@@ -0,0 +1,81 @@
+#ifndef NITCBASE_ACCESSPATH_H
+#define NITCBASE_ACCESSPATH_H
+
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/AttrStatsTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../Cache/ZoneMapTable.h"
+#include "../define/constants.h"
+#include "Predicate.h"
+
+/*
+    Chooses how the records of an open relation that satisfy a condition are
+    found: by a linear search of its record blocks, or through the B+ trees of
+    the attributes of the condition. A B+ tree is not always the better path:
+    for `!=` or a wide range, walking the leaves and fetching every matching
+    record from its own block costs far more than reading the blocks in order.
+
+    Both paths are costed in blocks read:
+        * a linear search reads every block whose zone (ZoneMapTable) may
+          hold a matching record (every block of the relation, from #Records
+          and #Slots, if it has no complete zone map)
+        * a B+ tree search descends the tree (its height, from #Records),
+          walks one leaf per MAX_KEYS_LEAF matching keys, and fetches every
+          matching record from its block
+    The number of matching records is estimated from #Records in the
+    relation catalog and the statistics of the attributes: 1 / (number of
+    distinct values, AttrStatsTable) of the records for `=`, the position of
+    the value between the smallest and largest value of the attribute (from
+    the zone map) for `<`, `<=`, `>` and `>=` on a NUMBER, and a third of the
+    records for those on a STRING. AND and OR combine the fractions as if the
+    conditions were independent. The statistics are only used if a scan has
+    already built them: estimating never reads a relation, and without them
+    every value is taken to be distinct and a range to match a third of the
+    records.
+
+    A query that reads nothing of the records but the one attribute a B+
+    tree is built on (every attribute it projects and every attribute of its
+    condition) has a third path: an index-only scan, which walks the leaves
+    of that B+ tree between the bounds the condition puts on the attribute
+    and takes the values from the index entries themselves, so it costs the
+    height of the tree plus one block per MAX_KEYS_LEAF entries walked, and
+    no record block at all. Whether a B+ tree covers the query is known from
+    the catalogs alone, and an index-only scan that is cheaper than reading
+    every block of the relation on the catalog's numbers (#Records, #Slots,
+    and every value taken to be distinct) is taken before any statistic is
+    looked at.
+*/
+
+enum AccessPathType {
+  PATH_LINEAR,      // linearSearch(), or a ScanCursor
+  PATH_BPLUS,       // bPlusSearch(), or Predicate::indexSearch() for an AND/OR
+  PATH_INDEX_ONLY   // the leaves of the B+ tree that covers the query (IndexOnlyScanOperator)
+};
+
+typedef struct AccessPathEstimate {
+  int path;             // the cheaper path
+  int numRecords;       // #Records of the relation
+  int numBlocks;        // #Blocks of the relation
+  double selectivity;   // estimated fraction of the records that match
+  double numMatches;    // estimated number of matching records
+  double linearCost;    // blocks read by a linear search
+  double indexCost;     // blocks read through the B+ trees (-1 if they cannot answer the condition, or if
+                        // an index-only scan was taken on the catalog's numbers)
+  int coveringOffset;   // offset of the attribute whose B+ tree covers the query (-1 if none does)
+  double indexOnlyCost; // blocks read by an index-only scan of that B+ tree (-1 if none covers the query)
+  int numWorkers;       // threads a linear search is split over (1 unless the caller runs a ParallelScan)
+} AccessPathEstimate;
+
+class AccessPath {
+ public:
+  // estimate both paths for a (resolved) condition on an open relation
+  // (a nullptr condition selects every record)
+  static int estimate(int relId, PredicateNode *condition, AccessPathEstimate *estimate);
+
+  // the same, for a query that needs only the attributes attrNames of the
+  // records, which may also be answered by an index-only scan
+  static int estimate(int relId, PredicateNode *condition, int numAttrs, char attrNames[][ATTR_SIZE],
+                      AccessPathEstimate *estimate);
+};
+
+#endif  // NITCBASE_ACCESSPATH_H
@@ -53,78 +53,94 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
 
 	RelCatEntry relCatBuffer;
 	RelCacheTable::getRelCatEntry(relId, &relCatBuffer);
-	while (block != -1)
+
+	// get the attribute offset for the attrName attribute from the attribute
+	// cache entry of the relation (AttrCacheTable::getAttrCatEntry()) once,
+	// instead of looking it up again for every record that is checked
+	AttrCatEntry attrCatBuffer;
+	AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatBuffer);
+	int attrOffset = attrCatBuffer.offset;
+
+	// the block the last call stopped in, if it was searched for the same condition
+	SearchBlock searchBlock;
+	RelCacheTable::getSearchBlock(relId, &searchBlock);
+
+	bool resume = prevRecId.block != -1 && searchBlock.block == prevRecId.block
+				  && searchBlock.attrOffset == attrOffset && searchBlock.op == op
+				  && compareAttrs(searchBlock.attrVal, attrVal, attrCatBuffer.attrType) == 0;
+
+	// zone of the current block in the zone map of the relation
+	// (nullptr for the catalogs, which are not zone-mapped, and for a
+	// relation whose zone map is not complete yet): the one kept by
+	// the last call, or the first zone for a new search; the zone map is
+	// only walked to find it if the search resumes without either
+	ZoneMapEntry *zone = nullptr;
+	if (resume)
+		zone = searchBlock.zone;
+	else if (block != -1)
 	{
-		// TODO: create a RecBuffer object for block (use RecBuffer Constructor for existing block)
-		RecBuffer blockBuffer(block);
+		zone = ZoneMapTable::getZoneMap(relId);
+		if (zone != nullptr && zone->block != block) zone = ZoneMapTable::getZoneEntry(relId, block);
+	}
 
-		// TODO: get header of the block using RecBuffer::getHeader() function
-		HeadInfo blockHeader;
-		blockBuffer.getHeader(&blockHeader);
+	while (block != -1)
+	{
+		// skip the block without reading it if its zone cannot satisfy the condition
+		if (zone != nullptr && !ZoneMapTable::mayMatch(zone, attrOffset, attrCatBuffer.attrType, attrVal, op))
+		{
+			zone = zone->next;
+			block = zone == nullptr ? -1 : zone->block, slot = 0;
+			continue;
+		}
 
-		// TODO: get slot map of the block using RecBuffer::getSlotMap() function
-		unsigned char slotMap[blockHeader.numSlots];
-		blockBuffer.getSlotMap(slotMap);
+		// evaluate the condition over every slot of the block at once
+		// (bit i of `selected` is set if slot i is occupied and satisfies it),
+		// unless the last call stopped in this block and already did
+		uint64_t selected[SELECTION_BITMAP_WORDS];
+		int rblock;
 
-		// If slot >= the number of slots per block(i.e. no more slots in this block)
-		if (slot >= relCatBuffer.numSlotsPerBlk)
+		if (resume && searchBlock.block == block)
 		{
-			// TODO: update block = right block of block, update slot = 0
-			block = blockHeader.rblock, slot = 0;
-			continue; // continue to the beginning of this while loop
+			memcpy(selected, searchBlock.selected, sizeof(selected));
+			rblock = searchBlock.rblock;
 		}
-
-		// if slot is free skip the loop
-		// (i.e. check if slot'th entry in slot map of block contains SLOT_UNOCCUPIED)
-		if (slotMap[slot] == SLOT_UNOCCUPIED)
+		else
 		{
-			slot++;
-			continue;
+			int ret = PredicateKernels::filterBlock(block, attrOffset, attrCatBuffer.attrType, attrVal, op,
+													selected, &rblock);
+			if (ret != SUCCESS)
+			{
+				RelCacheTable::resetSearchIndex(relId);
+				return RecId{-1, -1};
+			}
 		}
+		resume = false;
 
-		// TODO: get the record with id (block, slot) using RecBuffer::getRecord()
-		Attribute record[blockHeader.numAttrs];
-		blockBuffer.getRecord(record, slot);
-
-		// TODO: compare record's attribute value to the the given attrVal as below:
-		//* firstly get the attribute offset for the attrName attribute
-		//* from the attribute cache entry of the relation using
-		//* AttrCacheTable::getAttrCatEntry()
-
-		AttrCatEntry attrCatBuffer;
-		AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatBuffer);
-
-		// use the attribute offset to get the value of the attribute from current record
-		int attrOffset = attrCatBuffer.offset;
-
-		// will store the difference between the attributes 
-		// set cmpVal using compareAttrs()
-		int cmpVal = compareAttrs(record[attrOffset], attrVal, attrCatBuffer.attrType); 
-
-		/* 
-		TODO: check whether this record satisfies the given condition.
-		* It is determined based on the output of previous comparison and the op value received.
-		* The following code sets the cond variable if the condition is satisfied.
-		*/
-		if (
-			(op == NE && cmpVal != 0) || // if op is "not equal to"
-			(op == LT && cmpVal < 0) ||	 // if op is "less than"
-			(op == LE && cmpVal <= 0) || // if op is "less than or equal to"
-			(op == EQ && cmpVal == 0) || // if op is "equal to"
-			(op == GT && cmpVal > 0) ||	 // if op is "greater than"
-			(op == GE && cmpVal >= 0)	 // if op is "greater than or equal to"
-		)
+		// the first selected slot from `slot` onwards is the next hit
+		for (; slot < relCatBuffer.numSlotsPerBlk; slot++)
 		{
+			if ((selected[slot / 64] >> (slot % 64) & 1) == 0) continue;
+
 			// TODO: set the search index in the relation cache as
 			// TODO: the record id of the record that satisfies the given condition
 			// (use RelCacheTable::setSearchIndex function)
 			RecId newRecId = {block, slot};
 			RelCacheTable::setSearchIndex(relId, &newRecId);
 
+			// and keep the selection of the block for the next call
+			searchBlock.block = block;
+			searchBlock.attrOffset = attrOffset, searchBlock.op = op, searchBlock.attrVal = attrVal;
+			memcpy(searchBlock.selected, selected, sizeof(selected));
+			searchBlock.rblock = rblock;
+			searchBlock.zone = zone;
+			RelCacheTable::setSearchBlock(relId, &searchBlock);
+
 			return RecId{block, slot};
 		}
 
-		slot++;
+		// (no more hits in this block) update block = right block of block, slot = 0
+		block = rblock, slot = 0;
+		if (zone != nullptr) zone = zone->next;
 	}
 
 	//! no record in the relation with Id relid satisfies the given condition
@@ -601,6 +617,16 @@ int BlockAccess::insert(int relId, Attribute *record) {
 	blockHeader.numEntries++;
 	blockBuffer.setHeader(&blockHeader);
 
+	// widen the zone of the block in the zone map of the relation (if it has
+	// one; the first record of the relation starts it)
+	ZoneMapTable::update(relId, rec_id, record);
+
+	// (a search stopped in the block has to filter it again to see the record)
+	RelCacheTable::resetSearchBlock(relId);
+
+	// and add its values to the statistics of the relation (likewise)
+	AttrStatsTable::update(relId, record);
+
     // Increment the number of records field in the relation cache entry for
     // the relation. (use RelCacheTable::setRelCatEntry function)
 	relCatEntry.numRecs++;
@@ -686,8 +712,42 @@ int BlockAccess::search(int relId, Attribute *record,
     // get rootBlock from the attribute catalog entry
 	int rootBlock = attrCatEntry.rootBlock;
 
+    /* a search already under way goes on the way it started: through the
+       B+ tree if the attribute's search index is set, by a linear search if
+       the relation's is. A new search on an indexed attribute uses the B+
+       tree only if AccessPath estimates it to read fewer blocks than a linear
+       search (it reads every matching record from its own block, which for
+       `!=` or a wide range is far more than the blocks of the relation) */
+	bool useIndex = rootBlock != -1;
+
+	IndexId attrSearchIndex;
+	RecId relSearchIndex;
+	AttrCacheTable::getSearchIndex(relId, attrName, &attrSearchIndex);
+	RelCacheTable::getSearchIndex(relId, &relSearchIndex);
+
+	if (useIndex && attrSearchIndex.block == -1 && attrSearchIndex.index == -1)
+	{
+		if (relSearchIndex != RecId{-1, -1})
+			useIndex = false;
+		else
+		{
+			PredicateNode condition {};
+			condition.type = PRED_COMPARE;
+			strcpy(condition.attrName, attrName);
+			condition.op = op;
+			condition.attrOffset = attrCatEntry.offset;
+			condition.attrType = attrCatEntry.attrType;
+			condition.rootBlock = rootBlock;
+			condition.attrVal = attrVal;
+
+			AccessPathEstimate estimate;
+			if (AccessPath::estimate(relId, &condition, &estimate) == SUCCESS)
+				useIndex = estimate.path == PATH_BPLUS;
+		}
+	}
+
     /* if Index does not exist for the attribute (check rootBlock == -1) */ 
-	if (rootBlock == -1)
+	if (!useIndex)
 	{
         // TODO: search for the record id (recid) corresponding to the attribute with
         // TODO: attribute name attrName, with value attrval and satisfying the
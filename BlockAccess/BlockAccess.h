@@ -4,9 +4,15 @@
 #include "../BPlusTree/BPlusTree.h"
 #include "../Buffer/BlockBuffer.h"
 #include "../Cache/AttrCacheTable.h"
+#include "../Cache/AttrStatsTable.h"
 #include "../Cache/RelCacheTable.h"
+#include "../Cache/ZoneMapTable.h"
 #include "../define/constants.h"
 #include "../define/id.h"
+#include "AccessPath.h"
+#include "Predicate.h"
+#include "PredicateKernels.h"
+#include "ScanCursor.h"
 
 class BlockAccess {
  public:
@@ -0,0 +1,182 @@
+#include "ParallelScan.h"
+
+#include <cstring>
+
+ParallelScan::ParallelScan(int relId, PredicateNode *condition, int numWorkers) : pool(numWorkers)
+{
+	this->relId = relId;
+	this->condition = condition;
+
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	numAttrs = relCatEntry.numAttrs;
+
+	enumerated = false;
+	nextBlock = 0;
+	outputMorsel = 0;
+	outputPosition = 0;
+}
+
+ParallelScan::~ParallelScan()
+{
+}
+
+bool ParallelScan::worthwhile(int relId, int numWorkers)
+{
+	if (numWorkers < 2) return false;
+
+	// (the blocks the records would fill, from the catalog; no block is read)
+	RelCatEntry relCatEntry;
+	if (RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS || relCatEntry.numSlotsPerBlk <= 0)
+		return false;
+
+	int numBlocks = (relCatEntry.numRecs + relCatEntry.numSlotsPerBlk - 1) / relCatEntry.numSlotsPerBlk;
+	return numBlocks >= numWorkers * MORSEL_BLOCKS;
+}
+
+void ParallelScan::reset()
+{
+	// (the blocks are enumerated again, since records may have been inserted)
+	enumerated = false;
+	nextBlock = 0;
+	outputs.clear();
+	statuses.clear();
+	outputMorsel = 0;
+	outputPosition = 0;
+}
+
+// the blocks that can hold a matching record, in rblock order
+void ParallelScan::enumerate()
+{
+	blocks.clear();
+	enumerated = true;
+
+	// a zone map that has been built already also tells which blocks cannot
+	// satisfy the condition
+	ZoneMapEntry *zoneMap = ZoneMapTable::getZoneMap(relId);
+	if (zoneMap != nullptr)
+	{
+		for (ZoneMapEntry *zone = zoneMap; zone != nullptr; zone = zone->next)
+		{
+			if (zone->numEntries == 0) continue;
+			if (condition != nullptr && !Predicate::mayMatch(condition, zone)) continue;
+
+			blocks.push_back(zone->block);
+		}
+		return;
+	}
+
+	// otherwise the blocks are found by following the rblock links of their headers
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+	for (int block = relCatEntry.firstBlk; block != -1; )
+	{
+		RecBuffer blockBuffer (block);
+
+		HeadInfo blockHeader;
+		blockBuffer.getHeader(&blockHeader);
+
+		if (blockHeader.numEntries > 0) blocks.push_back(block);
+		block = blockHeader.rblock;
+	}
+}
+
+// filter the blocks [firstBlock, lastBlock) of `blocks` (run by a worker)
+int ParallelScan::filterMorsel(int firstBlock, int lastBlock, std::vector<Attribute> &output)
+{
+	unsigned char block[BLOCK_SIZE];
+
+	for (int blockIndex = firstBlock; blockIndex < lastBlock; blockIndex++)
+	{
+		int ret = StaticBuffer::copyBlock(blocks[blockIndex], block);
+		if (ret != SUCCESS) return ret;
+
+		HeadInfo blockHeader;
+		memcpy(&blockHeader, block, sizeof(HeadInfo));
+
+		uint64_t selected[SELECTION_BITMAP_WORDS];
+		if (condition != nullptr)
+			Predicate::filterBlock(condition, block, selected);
+		else
+			PredicateKernels::occupiedSlots(block, selected);
+
+		// record at slot s is at HEADER_SIZE + numSlots + s * recordSize
+		int recordSize = blockHeader.numAttrs * ATTR_SIZE;
+		unsigned char *records = block + HEADER_SIZE + blockHeader.numSlots;
+
+		for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+		{
+			for (uint64_t bits = selected[word]; bits != 0; bits &= bits - 1)
+			{
+				int slot = word * 64 + __builtin_ctzll(bits);
+
+				size_t position = output.size();
+				output.resize(position + numAttrs);
+				memcpy(&output[position], records + slot * recordSize, recordSize);
+			}
+		}
+	}
+
+	return SUCCESS;
+}
+
+// filter the morsels of the next wave with the workers
+int ParallelScan::runWave()
+{
+	int waveBlocks = pool.getNumWorkers() * OPERATOR_MEMORY_BLOCKS;
+	int firstBlock = nextBlock;
+	int lastBlock = firstBlock + waveBlocks < (int)blocks.size() ? firstBlock + waveBlocks : blocks.size();
+	int numMorsels = (lastBlock - firstBlock + MORSEL_BLOCKS - 1) / MORSEL_BLOCKS;
+
+	outputs.assign(numMorsels, std::vector<Attribute>());
+	statuses.assign(numMorsels, SUCCESS);
+
+	// (each morsel has its own output, written by the one worker that takes it)
+	pool.run(numMorsels, [&](int morsel, int worker) {
+		int morselFirst = firstBlock + morsel * MORSEL_BLOCKS;
+		int morselLast = morselFirst + MORSEL_BLOCKS < lastBlock ? morselFirst + MORSEL_BLOCKS : lastBlock;
+
+		statuses[morsel] = filterMorsel(morselFirst, morselLast, outputs[morsel]);
+	});
+
+	nextBlock = lastBlock;
+	outputMorsel = 0;
+	outputPosition = 0;
+
+	for (int morsel = 0; morsel < numMorsels; morsel++)
+		if (statuses[morsel] != SUCCESS) return statuses[morsel];
+
+	return SUCCESS;
+}
+
+int ParallelScan::next(Attribute *record)
+{
+	if (!enumerated) enumerate();
+
+	while (true)
+	{
+		// the next record of the current wave
+		while (outputMorsel < (int)outputs.size())
+		{
+			std::vector<Attribute> &output = outputs[outputMorsel];
+
+			if (outputPosition < (int)output.size())
+			{
+				memcpy(record, &output[outputPosition], numAttrs * sizeof(Attribute));
+				outputPosition += numAttrs;
+				return SUCCESS;
+			}
+
+			// (the records of a morsel are dropped as soon as they are handed out)
+			std::vector<Attribute>().swap(output);
+			outputMorsel++;
+			outputPosition = 0;
+		}
+
+		if (nextBlock >= (int)blocks.size()) return E_NOTFOUND;
+
+		int ret = runWave();
+		if (ret != SUCCESS) return ret;
+	}
+}
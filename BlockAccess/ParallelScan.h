@@ -0,0 +1,75 @@
+#ifndef NITCBASE_PARALLELSCAN_H
+#define NITCBASE_PARALLELSCAN_H
+
+#include <vector>
+
+#include "../Buffer/StaticBuffer.h"
+#include "../Cache/RelCacheTable.h"
+#include "../Cache/ZoneMapTable.h"
+#include "../define/constants.h"
+#include "Predicate.h"
+#include "PredicateKernels.h"
+#include "WorkerPool.h"
+
+/*
+    A ParallelScan reads the record blocks of an open relation with several
+    worker threads (a WorkerPool), and hands out the records that satisfy a
+    condition in the same order a ScanCursor would.
+
+    The record blocks are enumerated up front in rblock order, leaving out the
+    empty ones: from the zone map of the relation (ZoneMapTable) if it has
+    been built already, which also leaves out those whose zone cannot satisfy
+    the condition, and otherwise by following the rblock links of their
+    headers (a zone map is never built for this). They are then cut into
+    morsels of MORSEL_BLOCKS blocks, and the morsels are filtered a wave at a
+    time: the pool hands the morsels of a wave out to the workers, each of
+    which copies the blocks of its morsel (StaticBuffer::copyBlock()),
+    evaluates the condition over them (Predicate::filterBlock() on the copy)
+    and appends the records selected to the output buffer of the morsel.
+    next() then hands out the records of the wave in morsel order, and the
+    next wave is started only once they have all been taken, so the caller is
+    free to use the buffer (e.g. to insert the records into a target
+    relation) in between, while no worker runs. A wave has
+    OPERATOR_MEMORY_BLOCKS blocks for each worker, which bounds the records
+    held in memory at once.
+*/
+class ParallelScan {
+ public:
+  // (the condition, if not nullptr, must be resolved against the relation;
+  // the tree is not copied, and must live as long as the scan)
+  ParallelScan(int relId, PredicateNode *condition, int numWorkers);
+  ~ParallelScan();
+
+  // copy the next matching record into `record`; E_NOTFOUND at the end
+  int next(Attribute *record);
+
+  // start again from the first record block of the relation
+  void reset();
+
+  // whether a scan of the relation is worth splitting between the workers:
+  // its records have to fill at least a morsel per worker
+  static bool worthwhile(int relId, int numWorkers);
+
+ private:
+  int relId;
+  int numAttrs;
+  PredicateNode *condition;
+  WorkerPool pool;
+
+  std::vector<int> blocks;  // the blocks to read, in rblock order
+  int nextBlock;            // the first block of the next wave
+  bool enumerated;
+
+  // the records selected from each morsel of the current wave (numAttrs
+  // values each), the status of each morsel, and the next record to hand out
+  std::vector<std::vector<Attribute>> outputs;
+  std::vector<int> statuses;
+  int outputMorsel;
+  int outputPosition;
+
+  void enumerate();
+  int runWave();
+  int filterMorsel(int firstBlock, int lastBlock, std::vector<Attribute> &output);
+};
+
+#endif  // NITCBASE_PARALLELSCAN_H
@@ -0,0 +1,255 @@
+#include "Predicate.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#include "../BPlusTree/BPlusTree.h"
+#include "../Cache/AttrCacheTable.h"
+#include "PredicateKernels.h"
+
+static inline bool operator<(RecId lhs, RecId rhs)
+{
+	return lhs.block < rhs.block || (lhs.block == rhs.block && lhs.slot < rhs.slot);
+}
+
+PredicateNode *Predicate::createCompare(char attrName[ATTR_SIZE], int op, char strVal[ATTR_SIZE])
+{
+	PredicateNode *node = (PredicateNode *)malloc(sizeof(PredicateNode));
+	if (node == nullptr) return nullptr;
+
+	node->type = PRED_COMPARE;
+	strcpy(node->attrName, attrName);
+	node->op = op;
+	strcpy(node->strVal, strVal);
+	node->left = node->right = nullptr;
+
+	return node;
+}
+
+PredicateNode *Predicate::createNode(int type, PredicateNode *left, PredicateNode *right)
+{
+	PredicateNode *node = (PredicateNode *)malloc(sizeof(PredicateNode));
+	if (node == nullptr) return nullptr;
+
+	node->type = type;
+	node->left = left, node->right = right;
+
+	return node;
+}
+
+void Predicate::release(PredicateNode *node)
+{
+	if (node == nullptr) return;
+
+	release(node->left);
+	release(node->right);
+	free(node);
+}
+
+int Predicate::flipOperator(int op)
+{
+	switch (op)
+	{
+		case LT: return GT;
+		case LE: return GE;
+		case GT: return LT;
+		case GE: return LE;
+	}
+
+	return op;
+}
+
+// convert the value of a leaf whose attribute has been looked up to the type of the attribute
+static int resolveValue(PredicateNode *node)
+{
+	if (node->attrType == NUMBER)
+	{
+		// (the whole value, apart from surrounding spaces, must be a number)
+		char *end;
+		node->attrVal.nVal = strtod(node->strVal, &end);
+		while (*end == ' ') end++;
+
+		if (end == node->strVal || *end != '\0') return E_ATTRTYPEMISMATCH;
+	}
+	else
+		strcpy(node->attrVal.sVal, node->strVal);
+
+	return SUCCESS;
+}
+
+/*
+	Looks up every attribute of the tree in the attribute cache of `relId` and
+	converts each value to the type of its attribute.
+	returns E_ATTRNOTEXIST or E_ATTRTYPEMISMATCH on failure
+*/
+int Predicate::resolve(int relId, PredicateNode *node)
+{
+	if (node->type != PRED_COMPARE)
+	{
+		int ret = resolve(relId, node->left);
+		if (ret != SUCCESS) return ret;
+
+		return resolve(relId, node->right);
+	}
+
+	AttrCatEntry attrCatEntry;
+	int ret = AttrCacheTable::getAttrCatEntry(relId, node->attrName, &attrCatEntry);
+	if (ret != SUCCESS) return E_ATTRNOTEXIST;
+
+	node->attrOffset = attrCatEntry.offset;
+	node->attrType = attrCatEntry.attrType;
+	node->rootBlock = attrCatEntry.rootBlock;
+
+	return resolveValue(node);
+}
+
+int Predicate::resolve(int numAttrs, char attrNames[][ATTR_SIZE], int attrTypes[], PredicateNode *node)
+{
+	if (node->type != PRED_COMPARE)
+	{
+		int ret = resolve(numAttrs, attrNames, attrTypes, node->left);
+		if (ret != SUCCESS) return ret;
+
+		return resolve(numAttrs, attrNames, attrTypes, node->right);
+	}
+
+	int attrOffset = 0;
+	while (attrOffset < numAttrs && strcmp(attrNames[attrOffset], node->attrName) != 0)
+		attrOffset++;
+
+	if (attrOffset == numAttrs) return E_ATTRNOTEXIST;
+
+	node->attrOffset = attrOffset;
+	node->attrType = attrTypes[attrOffset];
+	node->rootBlock = -1;
+
+	return resolveValue(node);
+}
+
+bool Predicate::evaluate(PredicateNode *node, union Attribute *record)
+{
+	if (node->type == PRED_AND) return evaluate(node->left, record) && evaluate(node->right, record);
+	if (node->type == PRED_OR) return evaluate(node->left, record) || evaluate(node->right, record);
+
+	int cmpVal = compareAttrs(record[node->attrOffset], node->attrVal, node->attrType);
+	int op = node->op;
+
+	return (op == NE && cmpVal != 0) ||
+		   (op == LT && cmpVal < 0) ||
+		   (op == LE && cmpVal <= 0) ||
+		   (op == EQ && cmpVal == 0) ||
+		   (op == GT && cmpVal > 0) ||
+		   (op == GE && cmpVal >= 0);
+}
+
+/*
+	Sets `bitmap` to the occupied slots of `blockNum` that satisfy the tree:
+	every leaf is evaluated over the whole block by PredicateKernels, and the
+	bitmaps of the children of AND/OR nodes are combined a word at a time.
+*/
+int Predicate::filterBlock(PredicateNode *node, int blockNum, uint64_t bitmap[SELECTION_BITMAP_WORDS], int *rblock)
+{
+	if (node->type == PRED_COMPARE)
+		return PredicateKernels::filterBlock(blockNum, node->attrOffset, node->attrType, node->attrVal, node->op,
+											 bitmap, rblock);
+
+	uint64_t rightBitmap[SELECTION_BITMAP_WORDS];
+
+	int ret = filterBlock(node->left, blockNum, bitmap, rblock);
+	if (ret != SUCCESS) return ret;
+
+	ret = filterBlock(node->right, blockNum, rightBitmap, rblock);
+	if (ret != SUCCESS) return ret;
+
+	for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+		bitmap[word] = node->type == PRED_AND ? bitmap[word] & rightBitmap[word] : bitmap[word] | rightBitmap[word];
+
+	return SUCCESS;
+}
+
+// the same, over a copy of the block (see PredicateKernels)
+void Predicate::filterBlock(PredicateNode *node, const unsigned char *block, uint64_t bitmap[SELECTION_BITMAP_WORDS])
+{
+	if (node->type == PRED_COMPARE)
+	{
+		PredicateKernels::filterBlock(block, node->attrOffset, node->attrType, node->attrVal, node->op, bitmap);
+		return;
+	}
+
+	uint64_t rightBitmap[SELECTION_BITMAP_WORDS];
+
+	filterBlock(node->left, block, bitmap);
+	filterBlock(node->right, block, rightBitmap);
+
+	for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+		bitmap[word] = node->type == PRED_AND ? bitmap[word] & rightBitmap[word] : bitmap[word] | rightBitmap[word];
+}
+
+// false only if no record in the zone can satisfy the tree
+bool Predicate::mayMatch(PredicateNode *node, ZoneMapEntry *zone)
+{
+	if (node->type == PRED_AND) return mayMatch(node->left, zone) && mayMatch(node->right, zone);
+	if (node->type == PRED_OR) return mayMatch(node->left, zone) || mayMatch(node->right, zone);
+
+	return ZoneMapTable::mayMatch(zone, node->attrOffset, node->attrType, node->attrVal, node->op);
+}
+
+/*
+	Collects in `recIds` the rec-ids of the records that may satisfy the tree,
+	using only the B+ trees of its attributes:
+		* a leaf on an indexed attribute is answered by bPlusSearch() (a `!=`
+		  leaf is not; it would match nearly the whole index)
+		* AND intersects the sets of its children, or keeps the set of the one
+		  child that has an index (the other child is checked on the records)
+		* OR unions the sets of its children, and needs both to have one
+	The sets of AND/OR nodes are sorted on rec-id, so the records are fetched
+	block by block. Returns false if the tree cannot be answered this way.
+*/
+bool Predicate::indexSearch(int relId, PredicateNode *node, std::vector<RecId> &recIds)
+{
+	// (checked before any B+ tree is searched, so that an OR with one side
+	// that has no index does not walk the index of the other side for nothing)
+	if (!canIndexSearch(node)) return false;
+
+	if (node->type == PRED_COMPARE)
+	{
+		AttrCacheTable::resetSearchIndex(relId, node->attrName);
+
+		RecId recId;
+		while ((recId = BPlusTree::bPlusSearch(relId, node->attrName, node->attrVal, node->op)).block != -1)
+			recIds.push_back(recId);
+
+		return true;
+	}
+
+	std::vector<RecId> leftIds, rightIds;
+	bool leftIndexed = indexSearch(relId, node->left, leftIds);
+	bool rightIndexed = indexSearch(relId, node->right, rightIds);
+
+	std::sort(leftIds.begin(), leftIds.end());
+	std::sort(rightIds.begin(), rightIds.end());
+
+	if (node->type == PRED_AND && !rightIndexed) recIds.swap(leftIds);
+	else if (node->type == PRED_AND && !leftIndexed) recIds.swap(rightIds);
+	else if (node->type == PRED_AND)
+		std::set_intersection(leftIds.begin(), leftIds.end(), rightIds.begin(), rightIds.end(),
+							  std::back_inserter(recIds));
+	else
+		std::set_union(leftIds.begin(), leftIds.end(), rightIds.begin(), rightIds.end(),
+					   std::back_inserter(recIds));
+
+	return true;
+}
+
+// whether indexSearch() can answer the tree (by the rules above it)
+bool Predicate::canIndexSearch(PredicateNode *node)
+{
+	if (node->type == PRED_COMPARE) return node->rootBlock != -1 && node->op != NE;
+
+	bool leftIndexed = canIndexSearch(node->left);
+	bool rightIndexed = canIndexSearch(node->right);
+
+	return node->type == PRED_AND ? leftIndexed || rightIndexed : leftIndexed && rightIndexed;
+}
@@ -0,0 +1,77 @@
+#ifndef NITCBASE_PREDICATE_H
+#define NITCBASE_PREDICATE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Cache/ZoneMapTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+/*
+	A WHERE clause such as `a > 5 AND (b = x OR c != 3)` is held as a tree of
+	PredicateNodes: every leaf is a single `attr op value` comparison and every
+	inner node combines its two children with AND or OR.
+
+	The parser fills in attrName, op and strVal of the leaves; the offset, type
+	and value of each leaf are filled in once, by resolve(), before the tree is
+	evaluated against a relation.
+*/
+
+enum PredicateNodeType {
+  PRED_COMPARE,  // attrName op strVal
+  PRED_AND,      // left AND right
+  PRED_OR        // left OR right
+};
+
+typedef struct PredicateNode
+{
+	int type;
+
+	// (PRED_COMPARE) as parsed
+	char attrName[ATTR_SIZE];
+	int op;
+	char strVal[ATTR_SIZE];
+
+	// (PRED_COMPARE) as resolved against the relation
+	int attrOffset;
+	int attrType;
+	int rootBlock;
+	Attribute attrVal;
+
+	// (PRED_AND, PRED_OR)
+	struct PredicateNode *left;
+	struct PredicateNode *right;
+} PredicateNode;
+
+class Predicate
+{
+public:
+	// building the tree
+	static PredicateNode *createCompare(char attrName[ATTR_SIZE], int op, char strVal[ATTR_SIZE]);
+	static PredicateNode *createNode(int type, PredicateNode *left, PredicateNode *right);
+	static void release(PredicateNode *node);
+
+	// the operator op' for which `b op' a` holds exactly when `a op b` does
+	static int flipOperator(int op);
+
+	// fills in attrOffset, attrType, rootBlock and attrVal of every leaf
+	static int resolve(int relId, PredicateNode *node);
+
+	// the same, against records with the given attributes that are not
+	// (necessarily) those of a relation, e.g. the output of an operator
+	static int resolve(int numAttrs, char attrNames[][ATTR_SIZE], int attrTypes[], PredicateNode *node);
+
+	// evaluating the tree
+	static bool evaluate(PredicateNode *node, union Attribute *record);
+	static int filterBlock(PredicateNode *node, int blockNum, uint64_t bitmap[SELECTION_BITMAP_WORDS], int *rblock);
+	static void filterBlock(PredicateNode *node, const unsigned char *block, uint64_t bitmap[SELECTION_BITMAP_WORDS]);
+	static bool mayMatch(PredicateNode *node, ZoneMapEntry *zone);
+
+	// answering the tree from the B+ trees of its attributes
+	static bool canIndexSearch(PredicateNode *node);
+	static bool indexSearch(int relId, PredicateNode *node, std::vector<RecId> &recIds);
+};
+
+#endif // NITCBASE_PREDICATE_H
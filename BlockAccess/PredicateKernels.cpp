@@ -0,0 +1,322 @@
+#include "PredicateKernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define NITCBASE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+int PredicateKernels::mode = PredicateKernels::bestMode();
+
+int PredicateKernels::bestMode()
+{
+#ifdef NITCBASE_X86_KERNELS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+	return KERNEL_SSE2;
+#else
+	return KERNEL_SCALAR;
+#endif
+}
+
+int PredicateKernels::getMode()
+{
+	return mode;
+}
+
+void PredicateKernels::setMode(int newMode)
+{
+	// never use an instruction set that the CPU does not have
+	mode = newMode < bestMode() ? newMode : bestMode();
+}
+
+static inline void setBit(uint64_t *bitmap, int index)
+{
+	bitmap[index / 64] |= (uint64_t)1 << (index % 64);
+}
+
+/* ---------------------------------------------------------------------------
+   NUMBER keys
+   ------------------------------------------------------------------------- */
+
+// (the op is a template argument so that the compare is chosen once, not once per key)
+template <int OP>
+static inline bool satisfies(double key, double value)
+{
+	switch (OP)
+	{
+		case EQ: return key == value;
+		case LE: return key <= value;
+		case LT: return key < value;
+		case GE: return key >= value;
+		case GT: return key > value;
+		case NE: return key != value;
+	}
+	return false;
+}
+
+template <int OP>
+static void filterNumbersScalar(const double *keys, int from, int numKeys, double value, uint64_t *bitmap)
+{
+	for (int i = from; i < numKeys; i++)
+		if (satisfies<OP>(keys[i], value)) setBit(bitmap, i);
+}
+
+#ifdef NITCBASE_X86_KERNELS
+template <int OP>
+static inline __m128d compareSSE2(__m128d keys, __m128d value)
+{
+	switch (OP)
+	{
+		case EQ: return _mm_cmpeq_pd(keys, value);
+		case LE: return _mm_cmple_pd(keys, value);
+		case LT: return _mm_cmplt_pd(keys, value);
+		case GE: return _mm_cmpge_pd(keys, value);
+		case GT: return _mm_cmpgt_pd(keys, value);
+		default: return _mm_cmpneq_pd(keys, value);
+	}
+}
+
+template <int OP>
+static void filterNumbersSSE2(const double *keys, int numKeys, double value, uint64_t *bitmap)
+{
+	__m128d valueVector = _mm_set1_pd(value);
+
+	int i = 0;
+	for (; i + 2 <= numKeys; i += 2)
+	{
+		int mask = _mm_movemask_pd(compareSSE2<OP>(_mm_loadu_pd(keys + i), valueVector));
+
+		// (i is even, so the 2 bits never cross a word of the bitmap)
+		bitmap[i / 64] |= (uint64_t)mask << (i % 64);
+	}
+
+	filterNumbersScalar<OP>(keys, i, numKeys, value, bitmap);
+}
+
+// (_mm256_cmp_pd() takes the predicate as an immediate, hence one call per op)
+template <int OP>
+__attribute__((target("avx2")))
+static inline __m256d compareAVX2(__m256d keys, __m256d value)
+{
+	switch (OP)
+	{
+		case EQ: return _mm256_cmp_pd(keys, value, _CMP_EQ_OQ);
+		case LE: return _mm256_cmp_pd(keys, value, _CMP_LE_OQ);
+		case LT: return _mm256_cmp_pd(keys, value, _CMP_LT_OQ);
+		case GE: return _mm256_cmp_pd(keys, value, _CMP_GE_OQ);
+		case GT: return _mm256_cmp_pd(keys, value, _CMP_GT_OQ);
+		default: return _mm256_cmp_pd(keys, value, _CMP_NEQ_UQ);
+	}
+}
+
+template <int OP>
+__attribute__((target("avx2")))
+static void filterNumbersAVX2(const double *keys, int numKeys, double value, uint64_t *bitmap)
+{
+	__m256d valueVector = _mm256_set1_pd(value);
+
+	int i = 0;
+	for (; i + 4 <= numKeys; i += 4)
+	{
+		int mask = _mm256_movemask_pd(compareAVX2<OP>(_mm256_loadu_pd(keys + i), valueVector));
+
+		// (i is a multiple of 4, so the 4 bits never cross a word of the bitmap)
+		bitmap[i / 64] |= (uint64_t)mask << (i % 64);
+	}
+
+	filterNumbersScalar<OP>(keys, i, numKeys, value, bitmap);
+}
+#endif
+
+template <int OP>
+static void filterNumbersWithMode(int mode, const double *keys, int numKeys, double value, uint64_t *bitmap)
+{
+#ifdef NITCBASE_X86_KERNELS
+	if (mode == KERNEL_AVX2) return filterNumbersAVX2<OP>(keys, numKeys, value, bitmap);
+	if (mode == KERNEL_SSE2) return filterNumbersSSE2<OP>(keys, numKeys, value, bitmap);
+#endif
+	filterNumbersScalar<OP>(keys, 0, numKeys, value, bitmap);
+}
+
+void PredicateKernels::filterNumbers(const double *keys, int numKeys, double value, int op, uint64_t *bitmap)
+{
+	switch (op)
+	{
+		case EQ: return filterNumbersWithMode<EQ>(mode, keys, numKeys, value, bitmap);
+		case LE: return filterNumbersWithMode<LE>(mode, keys, numKeys, value, bitmap);
+		case LT: return filterNumbersWithMode<LT>(mode, keys, numKeys, value, bitmap);
+		case GE: return filterNumbersWithMode<GE>(mode, keys, numKeys, value, bitmap);
+		case GT: return filterNumbersWithMode<GT>(mode, keys, numKeys, value, bitmap);
+		case NE: return filterNumbersWithMode<NE>(mode, keys, numKeys, value, bitmap);
+	}
+}
+
+/* ---------------------------------------------------------------------------
+   STRING keys
+   ------------------------------------------------------------------------- */
+
+static inline bool satisfiesOp(int cmpVal, int op)
+{
+	switch (op)
+	{
+		case EQ: return cmpVal == 0;
+		case LE: return cmpVal <= 0;
+		case LT: return cmpVal < 0;
+		case GE: return cmpVal >= 0;
+		case GT: return cmpVal > 0;
+		case NE: return cmpVal != 0;
+	}
+	return false;
+}
+
+// strcmp() limited to ATTR_SIZE bytes (a key that fills all 16 bytes has no '\0')
+static inline int compareString(const char *key, const char *value)
+{
+	for (int i = 0; i < ATTR_SIZE; i++)
+	{
+		if (key[i] != value[i]) return (unsigned char)key[i] - (unsigned char)value[i];
+		if (key[i] == '\0') return 0;
+	}
+	return 0;
+}
+
+#ifdef NITCBASE_X86_KERNELS
+static inline int compareStringSSE2(const char *key, __m128i keyVector, __m128i valueVector, const char *value)
+{
+	// bytes where the key differs from the value, or where the key ends
+	int differ = ~_mm_movemask_epi8(_mm_cmpeq_epi8(keyVector, valueVector)) & 0xFFFF;
+	int ended = _mm_movemask_epi8(_mm_cmpeq_epi8(keyVector, _mm_setzero_si128()));
+	int stop = differ | ended;
+
+	if (stop == 0) return 0;
+
+	// the first such byte decides the result, exactly like strcmp()
+	int i = __builtin_ctz(stop);
+	return (unsigned char)key[i] - (unsigned char)value[i];
+}
+#endif
+
+void PredicateKernels::filterStrings(const char (*keys)[ATTR_SIZE], int numKeys, const char value[ATTR_SIZE], int op,
+									 uint64_t *bitmap)
+{
+#ifdef NITCBASE_X86_KERNELS
+	if (mode != KERNEL_SCALAR)
+	{
+		__m128i valueVector = _mm_loadu_si128((const __m128i *)value);
+
+		for (int i = 0; i < numKeys; i++)
+		{
+			__m128i keyVector = _mm_loadu_si128((const __m128i *)keys[i]);
+			if (satisfiesOp(compareStringSSE2(keys[i], keyVector, valueVector, value), op)) setBit(bitmap, i);
+		}
+		return;
+	}
+#endif
+
+	for (int i = 0; i < numKeys; i++)
+		if (satisfiesOp(compareString(keys[i], value), op)) setBit(bitmap, i);
+}
+
+/* ---------------------------------------------------------------------------
+   record blocks
+   ------------------------------------------------------------------------- */
+
+static void selectOccupied(const unsigned char *slotMap, int numSlots, uint64_t *bitmap)
+{
+	memset(bitmap, 0, SELECTION_BITMAP_WORDS * sizeof(uint64_t));
+
+	int slot = 0;
+#ifdef NITCBASE_X86_KERNELS
+	__m128i occupied = _mm_set1_epi8(SLOT_OCCUPIED);
+	for (; PredicateKernels::getMode() != KERNEL_SCALAR && slot + 16 <= numSlots; slot += 16)
+	{
+		uint64_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(slotMap + slot)), occupied));
+
+		// (slot is a multiple of 16, so the 16 bits never cross a word of the bitmap)
+		bitmap[slot / 64] |= mask << (slot % 64);
+	}
+#endif
+	for (; slot < numSlots; slot++)
+		if (slotMap[slot] == SLOT_OCCUPIED) setBit(bitmap, slot);
+}
+
+int PredicateKernels::occupiedSlots(int blockNum, uint64_t bitmap[SELECTION_BITMAP_WORDS], int *rblock)
+{
+	RecBuffer blockBuffer (blockNum);
+
+	unsigned char *bufferPtr;
+	int ret = blockBuffer.loadBlockAndGetBufferPtr(&bufferPtr);
+	if (ret != SUCCESS) return ret;
+
+	HeadInfo blockHeader;
+	memcpy(&blockHeader, bufferPtr, sizeof(HeadInfo));
+	*rblock = blockHeader.rblock;
+
+	occupiedSlots(bufferPtr, bitmap);
+	return SUCCESS;
+}
+
+void PredicateKernels::occupiedSlots(const unsigned char *block, uint64_t bitmap[SELECTION_BITMAP_WORDS])
+{
+	HeadInfo blockHeader;
+	memcpy(&blockHeader, block, sizeof(HeadInfo));
+
+	selectOccupied(block + HEADER_SIZE, blockHeader.numSlots, bitmap);
+}
+
+int PredicateKernels::filterBlock(int blockNum, int attrOffset, int attrType, Attribute attrVal, int op,
+								  uint64_t bitmap[SELECTION_BITMAP_WORDS], int *rblock)
+{
+	RecBuffer blockBuffer (blockNum);
+
+	unsigned char *bufferPtr;
+	int ret = blockBuffer.loadBlockAndGetBufferPtr(&bufferPtr);
+	if (ret != SUCCESS) return ret;
+
+	HeadInfo blockHeader;
+	memcpy(&blockHeader, bufferPtr, sizeof(HeadInfo));
+	*rblock = blockHeader.rblock;
+
+	filterBlock(bufferPtr, attrOffset, attrType, attrVal, op, bitmap);
+	return SUCCESS;
+}
+
+void PredicateKernels::filterBlock(const unsigned char *block, int attrOffset, int attrType, Attribute attrVal, int op,
+								   uint64_t bitmap[SELECTION_BITMAP_WORDS])
+{
+	HeadInfo blockHeader;
+	memcpy(&blockHeader, block, sizeof(HeadInfo));
+
+	int numSlots = blockHeader.numSlots;
+	int recordSize = blockHeader.numAttrs * ATTR_SIZE;
+
+	// the condition attribute of slot 0; slot i is recordSize bytes further
+	const unsigned char *attrPtr = block + HEADER_SIZE + numSlots + attrOffset * ATTR_SIZE;
+
+	// gather the attribute of every slot into a contiguous array and filter it
+	uint64_t selected[SELECTION_BITMAP_WORDS] = {0};
+
+	if (attrType == NUMBER)
+	{
+		double keys[MAX_SLOTS_PER_BLOCK];
+		for (int slot = 0; slot < numSlots; slot++)
+			memcpy(&keys[slot], attrPtr + slot * recordSize, sizeof(double));
+
+		filterNumbers(keys, numSlots, attrVal.nVal, op, selected);
+	}
+	else
+	{
+		char keys[MAX_SLOTS_PER_BLOCK][ATTR_SIZE];
+		for (int slot = 0; slot < numSlots; slot++)
+			memcpy(keys[slot], attrPtr + slot * recordSize, ATTR_SIZE);
+
+		filterStrings(keys, numSlots, attrVal.sVal, op, selected);
+	}
+
+	// a free slot can hold stale data, so only occupied slots are kept
+	selectOccupied(block + HEADER_SIZE, numSlots, bitmap);
+	for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+		bitmap[word] &= selected[word];
+}
@@ -0,0 +1,60 @@
+#ifndef NITCBASE_PREDICATEKERNELS_H
+#define NITCBASE_PREDICATEKERNELS_H
+
+#include <cstdint>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../define/constants.h"
+
+/*
+    Block-at-a-time filter kernels.
+
+    Instead of fetching one record at a time and calling compareAttrs(), the
+    condition attribute of every slot of a record block is gathered into a
+    contiguous array, and the whole array is compared against the value in one
+    loop. The result is a selection bitmap with one bit per slot of the block
+    (bit `slot` of word `slot / 64`), ANDed with the occupancy of the slot map.
+
+    NUMBER keys are compared with AVX2 (4 doubles at a time) or SSE2 (2 at a
+    time); STRING keys are compared 16 bytes at a time with SSE2, which gives
+    the same result as strcmp(). The SIMD version is picked at runtime from
+    what the CPU supports, and the scalar version is used everywhere else.
+*/
+
+enum KernelMode {
+  KERNEL_SCALAR,  // plain loops
+  KERNEL_SSE2,    // 128-bit compares
+  KERNEL_AVX2     // 256-bit compares for NUMBER keys
+};
+
+class PredicateKernels {
+ public:
+  // selects every occupied slot of `blockNum` that satisfies `attrVal op`
+  // on the attribute at `attrOffset`; stores the rblock in *rblock
+  static int filterBlock(int blockNum, int attrOffset, int attrType, Attribute attrVal, int op,
+                         uint64_t bitmap[SELECTION_BITMAP_WORDS], int *rblock);
+
+  // selects every occupied slot of `blockNum`; stores the rblock in *rblock
+  static int occupiedSlots(int blockNum, uint64_t bitmap[SELECTION_BITMAP_WORDS], int *rblock);
+
+  // the same, over a copy of a record block (StaticBuffer::copyBlock()); they
+  // touch nothing but `block` and `bitmap`, so any thread may call them
+  static void filterBlock(const unsigned char *block, int attrOffset, int attrType, Attribute attrVal, int op,
+                          uint64_t bitmap[SELECTION_BITMAP_WORDS]);
+  static void occupiedSlots(const unsigned char *block, uint64_t bitmap[SELECTION_BITMAP_WORDS]);
+
+  // the kernels themselves, over an already gathered array of keys
+  static void filterNumbers(const double *keys, int numKeys, double value, int op, uint64_t *bitmap);
+  static void filterStrings(const char (*keys)[ATTR_SIZE], int numKeys, const char value[ATTR_SIZE], int op,
+                            uint64_t *bitmap);
+
+  // the best mode supported by this CPU, and the mode currently in use
+  static int bestMode();
+  static int getMode();
+  static void setMode(int mode);
+
+ private:
+  static int mode;
+};
+
+#endif  // NITCBASE_PREDICATEKERNELS_H
@@ -0,0 +1,171 @@
+#include "ScanCursor.h"
+
+#include <cstring>
+
+ScanCursor::ScanCursor(int relId)
+{
+	this->relId = relId;
+
+	// get the layout of the relation from the relation cache once
+	RelCatEntry relCatEntry;
+	if (RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS)
+	{
+		// (relation is not open; the cursor will not return any record)
+		this->numAttrs = 0;
+		this->firstBlock = -1;
+	}
+	else
+	{
+		this->numAttrs = relCatEntry.numAttrs;
+		this->firstBlock = relCatEntry.firstBlk;
+	}
+
+	this->condition = nullptr;
+	reset();
+}
+
+int ScanCursor::setPredicate(char attrName[ATTR_SIZE], Attribute attrVal, int op)
+{
+	// resolve the offset and type of the attribute once for the whole scan
+	AttrCatEntry attrCatEntry;
+	int ret = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	leaf.type = PRED_COMPARE;
+	strcpy(leaf.attrName, attrName);
+	leaf.op = op;
+	leaf.attrOffset = attrCatEntry.offset;
+	leaf.attrType = attrCatEntry.attrType;
+	leaf.rootBlock = attrCatEntry.rootBlock;
+	leaf.attrVal = attrVal;
+	leaf.left = leaf.right = nullptr;
+
+	setPredicate(&leaf);
+	return SUCCESS;
+}
+
+void ScanCursor::setPredicate(PredicateNode *condition)
+{
+	this->condition = condition;
+	reset();
+}
+
+void ScanCursor::reset()
+{
+	block = -1, nextBlock = firstBlock, slot = -1;
+	for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) selected[word] = 0;
+
+	// with a predicate, the blocks are visited in the order of the zone map,
+	// if the relation has a complete one
+	zone = condition != nullptr ? ZoneMapTable::getZoneMap(relId) : nullptr;
+	useZoneMap = zone != nullptr;
+}
+
+RecId ScanCursor::getRecId()
+{
+	if (block == -1 || slot == -1) return RecId{-1, -1};
+	return RecId{block, slot};
+}
+
+/*
+    Loads `blockNum` and sets `selected` to the slots of the block that are
+    occupied and satisfy the predicate (if any). The block also goes into the
+    zone map and the statistics of the relation, if this scan is the one
+    building them.
+*/
+int ScanCursor::loadBlock(int blockNum)
+{
+	int rblock, ret;
+	if (condition != nullptr)
+		ret = Predicate::filterBlock(condition, blockNum, selected, &rblock);
+	else
+		ret = PredicateKernels::occupiedSlots(blockNum, selected, &rblock);
+
+	if (ret != SUCCESS) return ret;
+
+	ZoneMapTable::addBlock(relId, blockNum);
+	AttrStatsTable::addBlock(relId, blockNum);
+
+	block = blockNum, nextBlock = rblock, slot = -1;
+	return SUCCESS;
+}
+
+// index of the first bit set in `bitmap` after `from`, or -1
+static int nextSelected(const uint64_t bitmap[SELECTION_BITMAP_WORDS], int from)
+{
+	for (int index = from + 1; index < SELECTION_BITMAP_WORDS * 64; )
+	{
+		uint64_t word = bitmap[index / 64] >> (index % 64);
+		if (word != 0) return index + __builtin_ctzll(word);
+
+		index = (index / 64 + 1) * 64;
+	}
+	return -1;
+}
+
+/*
+    Moves on to the next block (after the current one) that has at least one
+    selected slot, skipping the blocks whose zone cannot satisfy the predicate.
+*/
+int ScanCursor::advance()
+{
+	while (true)
+	{
+		// skip every block whose zone cannot satisfy the predicate
+		if (useZoneMap)
+		{
+			while (zone != nullptr && !Predicate::mayMatch(condition, zone))
+				zone = zone->next;
+
+			nextBlock = zone == nullptr ? -1 : zone->block;
+			if (zone != nullptr) zone = zone->next;
+		}
+
+		if (nextBlock == -1)
+		{
+			// (all the record blocks of the relation have been scanned)
+			block = -1, slot = -1;
+			return E_NOTFOUND;
+		}
+
+		int ret = loadBlock(nextBlock);
+		if (ret != SUCCESS) return ret;
+
+		if (nextSelected(selected, -1) != -1) return SUCCESS;
+	}
+}
+
+int ScanCursor::next(Attribute *record)
+{
+	// move forward until a block with at least one remaining hit is found
+	int hit = block == -1 ? -1 : nextSelected(selected, slot);
+	if (hit == -1)
+	{
+		int ret = advance();
+		if (ret != SUCCESS) return ret;
+
+		hit = nextSelected(selected, -1);
+	}
+	slot = hit;
+
+	// the block may have been evicted since it was loaded (the caller is free
+	// to insert into other relations between calls), so fetch the record
+	// through RecBuffer which brings the block back if needed
+	RecBuffer blockBuffer (block);
+	blockBuffer.getRecord(record, slot);
+
+	return SUCCESS;
+}
+
+int ScanCursor::nextSelectedBlock(int *blockNum, uint64_t bitmap[SELECTION_BITMAP_WORDS])
+{
+	int ret = advance();
+	if (ret != SUCCESS) return ret;
+
+	*blockNum = block;
+	for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) bitmap[word] = selected[word];
+
+	// (every hit of the block has now been handed out)
+	slot = SELECTION_BITMAP_WORDS * 64 - 1;
+	return SUCCESS;
+}
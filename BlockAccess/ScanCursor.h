@@ -0,0 +1,77 @@
+#ifndef NITCBASE_SCANCURSOR_H
+#define NITCBASE_SCANCURSOR_H
+
+#include <cstdint>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/AttrStatsTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../Cache/ZoneMapTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+#include "Predicate.h"
+#include "PredicateKernels.h"
+
+/*
+    A ScanCursor walks the record blocks of an open relation one block at a
+    time. The attribute catalog entry of the condition attribute is looked up
+    once (in setPredicate()), and the condition is evaluated over every slot of
+    a block by PredicateKernels::filterBlock() when the block is loaded. next()
+    then simply hands out the records selected in the block's bitmap. With a
+    predicate, blocks whose zone (ZoneMapTable) cannot satisfy it are skipped
+    without being read; a relation without a complete zone map (and
+    statistics, AttrStatsTable) yet gets them from the first scan that reads
+    all of its blocks.
+
+    Unlike BlockAccess::linearSearch(), the cursor keeps its position in the
+    object itself and does not touch the search index in the relation cache, so
+    any number of cursors can be open on the same relation at once.
+*/
+class ScanCursor {
+ public:
+  ScanCursor(int relId);
+
+  // restrict the scan to records satisfying `attrName op attrVal`
+  int setPredicate(char attrName[ATTR_SIZE], Attribute attrVal, int op);
+
+  // restrict the scan to records satisfying a (resolved) predicate tree;
+  // the tree is not copied, and must live as long as the cursor uses it
+  void setPredicate(PredicateNode *condition);
+
+  // copy the next matching record into `record`; E_NOTFOUND at the end
+  int next(Attribute *record);
+
+  // move to the next block with at least one matching record, and copy
+  // its number and selection bitmap (for operators that read a block at a
+  // time; not to be mixed with next() on the same block)
+  int nextSelectedBlock(int *blockNum, uint64_t bitmap[SELECTION_BITMAP_WORDS]);
+
+  // rec-id of the record last returned by next()
+  RecId getRecId();
+
+  // start again from the first record block of the relation
+  void reset();
+
+ private:
+  int relId;
+  int numAttrs;
+  int firstBlock;
+
+  // predicate, resolved once (`leaf` holds a single `attr op value`)
+  PredicateNode *condition;
+  PredicateNode leaf;
+
+  // position
+  int block;
+  int nextBlock;
+  bool useZoneMap;
+  ZoneMapEntry *zone;  // zone of nextBlock, when useZoneMap
+  int slot;
+  uint64_t selected[SELECTION_BITMAP_WORDS];
+
+  int loadBlock(int blockNum);
+  int advance();
+};
+
+#endif  // NITCBASE_SCANCURSOR_H
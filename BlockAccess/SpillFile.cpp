@@ -0,0 +1,123 @@
+#include "SpillFile.h"
+
+#include <cmath>
+
+SpillFile::SpillFile(int numAttrs)
+{
+	// same number of slots per block as a relation with numAttrs attributes
+	this->numAttrs = numAttrs;
+	this->numSlots = floor((2016*1.00) / (16*numAttrs + 1));
+
+	firstBlock = lastBlock = -1;
+	lastBlockEntries = 0;
+	numRecords = 0;
+
+	rewind();
+}
+
+int SpillFile::append(Attribute *record)
+{
+	// if the last block is full (or there is none), link a new one at the end
+	if (lastBlock == -1 || lastBlockEntries == numSlots)
+	{
+		RecBuffer blockBuffer;
+		int blockNum = blockBuffer.getBlockNum();
+		if (blockNum < 0 || blockNum >= DISK_BLOCKS) return E_DISKFULL;
+
+		HeadInfo blockHeader;
+		blockHeader.blockType = REC;
+		blockHeader.lblock = lastBlock, blockHeader.rblock = blockHeader.pblock = -1;
+		blockHeader.numAttrs = numAttrs, blockHeader.numSlots = numSlots, blockHeader.numEntries = 0;
+		blockBuffer.setHeader(&blockHeader);
+
+		unsigned char slotMap [numSlots];
+		for (int slotIndex = 0; slotIndex < numSlots; slotIndex++)
+			slotMap[slotIndex] = SLOT_UNOCCUPIED;
+		blockBuffer.setSlotMap(slotMap);
+
+		if (lastBlock != -1)
+		{
+			RecBuffer prevBlockBuffer (lastBlock);
+
+			HeadInfo prevBlockHeader;
+			prevBlockBuffer.getHeader(&prevBlockHeader);
+			prevBlockHeader.rblock = blockNum;
+			prevBlockBuffer.setHeader(&prevBlockHeader);
+		}
+		else
+			firstBlock = blockNum;
+
+		// (a file that has not been read from yet is read from its first block)
+		if (block == -1 && slot == 0) block = firstBlock;
+
+		lastBlock = blockNum;
+		lastBlockEntries = 0;
+	}
+
+	RecBuffer blockBuffer (lastBlock);
+	int ret = blockBuffer.setRecord(record, lastBlockEntries);
+	if (ret != SUCCESS) return ret;
+
+	unsigned char slotMap [numSlots];
+	blockBuffer.getSlotMap(slotMap);
+	slotMap[lastBlockEntries] = SLOT_OCCUPIED;
+	blockBuffer.setSlotMap(slotMap);
+
+	HeadInfo blockHeader;
+	blockBuffer.getHeader(&blockHeader);
+	blockHeader.numEntries = ++lastBlockEntries;
+	blockBuffer.setHeader(&blockHeader);
+
+	numRecords++;
+	return SUCCESS;
+}
+
+void SpillFile::rewind()
+{
+	block = firstBlock, slot = 0;
+}
+
+int SpillFile::next(Attribute *record)
+{
+	while (block != -1)
+	{
+		RecBuffer blockBuffer (block);
+
+		HeadInfo blockHeader;
+		blockBuffer.getHeader(&blockHeader);
+
+		// (the slots of a block are filled in order, so the first
+		// numEntries slots are exactly the records of the block)
+		if (slot < blockHeader.numEntries)
+			return blockBuffer.getRecord(record, slot++);
+
+		block = blockHeader.rblock, slot = 0;
+	}
+
+	return E_NOTFOUND;
+}
+
+int SpillFile::getNumRecords()
+{
+	return numRecords;
+}
+
+void SpillFile::release()
+{
+	for (int blockNum = firstBlock; blockNum != -1; )
+	{
+		RecBuffer blockBuffer (blockNum);
+
+		HeadInfo blockHeader;
+		blockBuffer.getHeader(&blockHeader);
+		blockBuffer.releaseBlock();
+
+		blockNum = blockHeader.rblock;
+	}
+
+	firstBlock = lastBlock = -1;
+	lastBlockEntries = 0;
+	numRecords = 0;
+
+	rewind();
+}
@@ -0,0 +1,49 @@
+#ifndef NITCBASE_SPILLFILE_H
+#define NITCBASE_SPILLFILE_H
+
+#include "../Buffer/BlockBuffer.h"
+#include "../define/constants.h"
+
+/*
+    A SpillFile is a run of temporary record blocks that an operator writes
+    records to when its input does not fit in its memory budget (e.g. the
+    partitions of a grace hash join). The blocks are laid out like the record
+    blocks of a relation (header, slotmap, records) and linked through
+    lblock/rblock, but they belong to no relation: they are not in the catalogs
+    and must be given back with release() once the operator is done with them.
+
+    Records are only ever appended, so every block except the last is full and
+    the records are read back, by next(), in the order they were written.
+*/
+class SpillFile {
+ public:
+  SpillFile(int numAttrs);
+
+  // append `record` at the end of the file; E_DISKFULL if no block is free
+  int append(Attribute *record);
+
+  // copy the next record into `record`; E_NOTFOUND at the end
+  int next(Attribute *record);
+
+  // start reading again from the first record
+  void rewind();
+
+  int getNumRecords();
+
+  // free every block of the file (the file is empty afterwards)
+  void release();
+
+ private:
+  int numAttrs;
+  int numSlots;
+  int firstBlock;
+  int lastBlock;
+  int lastBlockEntries;
+  int numRecords;
+
+  // read position
+  int block;
+  int slot;
+};
+
+#endif  // NITCBASE_SPILLFILE_H
@@ -0,0 +1,140 @@
+#include "WorkerPool.h"
+
+int WorkerPool::defaultWorkers = 0;
+
+WorkerPool::WorkerPool(int numWorkers)
+{
+	if (numWorkers < 1) numWorkers = 1;
+	if (numWorkers > MAX_WORKERS) numWorkers = MAX_WORKERS;
+
+	this->numWorkers = numWorkers;
+	ranges.reset(new Range[numWorkers]);
+	generation = 0;
+	busy = 0;
+	stopping = false;
+
+	// (worker 0 is the thread that calls run())
+	for (int worker = 1; worker < numWorkers; worker++)
+		threads.emplace_back(&WorkerPool::work, this, worker);
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> guard (lock);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (std::thread &thread : threads) thread.join();
+}
+
+int WorkerPool::getNumWorkers()
+{
+	return numWorkers;
+}
+
+int WorkerPool::getDefaultWorkers()
+{
+	if (defaultWorkers > 0) return defaultWorkers;
+
+	int hardwareThreads = std::thread::hardware_concurrency();
+	if (hardwareThreads < 1) return 1;
+	return hardwareThreads < MAX_WORKERS ? hardwareThreads : MAX_WORKERS;
+}
+
+void WorkerPool::setDefaultWorkers(int numWorkers)
+{
+	defaultWorkers = numWorkers < 0 ? 0 : numWorkers > MAX_WORKERS ? MAX_WORKERS : numWorkers;
+}
+
+void WorkerPool::run(int numItems, std::function<void(int item, int worker)> task)
+{
+	if (numItems <= 0) return;
+
+	// deal out the items as contiguous ranges, so that a worker's items are
+	// next to each other (and to the blocks it has just read)
+	for (int worker = 0; worker < numWorkers; worker++)
+	{
+		std::lock_guard<std::mutex> guard (ranges[worker].lock);
+		ranges[worker].front = (long long)numItems * worker / numWorkers;
+		ranges[worker].back = (long long)numItems * (worker + 1) / numWorkers;
+	}
+
+	this->task = task;
+
+	{
+		std::lock_guard<std::mutex> guard (lock);
+		busy = threads.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	drain(0);
+
+	std::unique_lock<std::mutex> guard (lock);
+	done.wait(guard, [this] { return busy == 0; });
+}
+
+// the loop of the threads (workers 1..numWorkers-1)
+void WorkerPool::work(int worker)
+{
+	int seen = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> guard (lock);
+			wake.wait(guard, [this, seen] { return stopping || generation != seen; });
+			if (stopping) return;
+			seen = generation;
+		}
+
+		drain(worker);
+
+		std::lock_guard<std::mutex> guard (lock);
+		if (--busy == 0) done.notify_one();
+	}
+}
+
+// run items until there are none left to take or steal
+void WorkerPool::drain(int worker)
+{
+	int item;
+	while (take(worker, &item)) task(item, worker);
+}
+
+bool WorkerPool::take(int worker, int *item)
+{
+	{
+		std::lock_guard<std::mutex> guard (ranges[worker].lock);
+		if (ranges[worker].front < ranges[worker].back)
+		{
+			*item = ranges[worker].front++;
+			return true;
+		}
+	}
+
+	// steal from the back of the range with the most items left (looking
+	// again if another worker emptied it first)
+	while (true)
+	{
+		int victim = -1, mostLeft = 0;
+		for (int other = 0; other < numWorkers; other++)
+		{
+			std::lock_guard<std::mutex> guard (ranges[other].lock);
+
+			int left = ranges[other].back - ranges[other].front;
+			if (left > mostLeft) victim = other, mostLeft = left;
+		}
+
+		if (victim == -1) return false;
+
+		std::lock_guard<std::mutex> guard (ranges[victim].lock);
+		if (ranges[victim].front < ranges[victim].back)
+		{
+			*item = --ranges[victim].back;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#ifndef NITCBASE_WORKERPOOL_H
+#define NITCBASE_WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../define/constants.h"
+
+/*
+    A work-stealing pool of worker threads for the parallel operations (e.g.
+    ParallelScan). run() splits the items 0..numItems-1 into one contiguous
+    range per worker; each worker takes the items of its own range from the
+    front, and once it runs out, steals from the back of the range with the
+    most items left, so a worker held up by slow items is helped by the others
+    instead of holding up the whole run.
+
+    The thread that calls run() works as worker 0, and the other workers are
+    threads started once, by the constructor, which sleep between runs. The
+    tasks must not use the buffer or the caches (except to read what nothing
+    changes during the run): nothing in those layers is thread-safe.
+*/
+class WorkerPool {
+ public:
+  WorkerPool(int numWorkers);
+  ~WorkerPool();
+
+  int getNumWorkers();
+
+  // call task(item, worker) for every item in [0, numItems), and return once
+  // all of them are done (worker is the index of the worker that ran it)
+  void run(int numItems, std::function<void(int item, int worker)> task);
+
+  // the number of workers a parallel operation uses: the one set with
+  // setDefaultWorkers(), or, if that is 0, the number of hardware threads
+  static int getDefaultWorkers();
+  static void setDefaultWorkers(int numWorkers);
+
+ private:
+  // the items of a worker not taken yet: [front, back)
+  struct Range {
+    std::mutex lock;
+    int front, back;
+  };
+
+  int numWorkers;
+  std::unique_ptr<Range[]> ranges;
+  std::vector<std::thread> threads;
+
+  // a run: the threads wait on `wake` for a new generation, and the last one
+  // to finish it signals `done`
+  std::mutex lock;
+  std::condition_variable wake, done;
+  int generation;
+  int busy;
+  bool stopping;
+  std::function<void(int, int)> task;
+
+  static int defaultWorkers;
+
+  void work(int worker);
+  void drain(int worker);
+  bool take(int worker, int *item);
+};
+
+#endif  // NITCBASE_WORKERPOOL_H
@@ -165,6 +165,47 @@ int RecBuffer::getRecord(union Attribute *record, int slotNum)
 	return SUCCESS;
 }
 
+//* copy the records of the slots set in `selected` into columns, one per attribute:
+//  attribute i of the k-th selected record goes to index `row + k` of columns[i],
+//  as a double if attrTypes[i] is NUMBER and as ATTR_SIZE chars if it is STRING
+//  (*numRecords is set to the number of records copied)
+int RecBuffer::getColumns(const uint64_t selected[SELECTION_BITMAP_WORDS], const int attrTypes[],
+						  unsigned char *columns[], int row, int *numRecords)
+{
+	HeadInfo head;
+	BlockBuffer::getHeader(&head);
+
+	unsigned char *buffer;
+	int ret = loadBlockAndGetBufferPtr(&buffer);
+	if (ret != SUCCESS)
+		return ret;
+
+	// the same layout as in getRecord(): slot k is at HEADER_SIZE + slotMapSize + (recordSize * k)
+	int recordSize = head.numAttrs * ATTR_SIZE;
+	unsigned char *firstRecord = buffer + (32 + head.numSlots);
+
+	int count = 0;
+	for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+	{
+		for (uint64_t bits = selected[word]; bits != 0; bits &= bits - 1)
+		{
+			int slotNum = word * 64 + __builtin_ctzll(bits);
+			unsigned char *slotPointer = firstRecord + recordSize * slotNum;
+
+			for (int attrOffset = 0; attrOffset < head.numAttrs; attrOffset++)
+			{
+				int width = attrTypes[attrOffset] == NUMBER ? sizeof(double) : ATTR_SIZE;
+				memcpy(columns[attrOffset] + (row + count) * width, slotPointer + attrOffset * ATTR_SIZE, width);
+			}
+
+			count++;
+		}
+	}
+
+	*numRecords = count;
+	return SUCCESS;
+}
+
 //* load the record at slotNum into the argument pointer
 int RecBuffer::setRecord(union Attribute *record, int slotNum)
 {
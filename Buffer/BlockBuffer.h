@@ -44,6 +44,8 @@ struct Index
 
 class BlockBuffer
 {
+	friend class PredicateKernels;
+
 protected:
 	// field
 	int blockNum;
@@ -72,6 +74,8 @@ public:
 	int setSlotMap(unsigned char *slotMap);
 	int getRecord(union Attribute *rec, int slotNum);
 	int setRecord(union Attribute *rec, int slotNum);
+	int getColumns(const uint64_t selected[SELECTION_BITMAP_WORDS], const int attrTypes[], unsigned char *columns[],
+				   int row, int *numRecords);
 };
 
 class IndBuffer : public BlockBuffer
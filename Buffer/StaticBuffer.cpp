@@ -1,5 +1,6 @@
 #include "StaticBuffer.h"
 #include <stdio.h>
+#include <string.h>
 
 // the declarations for this class can be found at "StaticBuffer.h"
 
@@ -161,4 +162,17 @@ int StaticBuffer::getStaticBlockType(int blockNum){
     // Access the entry in block allocation map corresponding to the blockNum argument
     // and return the block type after type casting to integer.
 	return (int)blockAllocMap[blockNum];
-}
\ No newline at end of file
+}
+
+int StaticBuffer::copyBlock(int blockNum, unsigned char *block) {
+	int bufferNum = getBufferNum(blockNum);
+	if (bufferNum == E_OUTOFBOUND) return E_OUTOFBOUND;
+
+	// (a block in the buffer may be newer than its copy on the disk)
+	if (bufferNum != E_BLOCKNOTINBUFFER) {
+		memcpy(block, blocks[bufferNum], BLOCK_SIZE);
+		return SUCCESS;
+	}
+
+	return Disk::readBlock(block, blockNum);
+}
@@ -30,6 +30,13 @@ public:
 	// methods
 	static int getStaticBlockType(int blockNum);
 	static int setDirtyBit(int blockNum);
+
+	// copy the current contents of a block (from the buffer if it is there,
+	// and from the disk otherwise) without loading it into the buffer; this
+	// changes nothing in the buffer, so several threads may call it at once as
+	// long as no other thread uses the buffer meanwhile
+	static int copyBlock(int blockNum, unsigned char *block);
+
 	StaticBuffer();
 	~StaticBuffer();
 };
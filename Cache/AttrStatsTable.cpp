@@ -0,0 +1,217 @@
+#include "AttrStatsTable.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "AttrCacheTable.h"
+#include "RelCacheTable.h"
+
+AttrStats *AttrStatsTable::attrStats[MAX_OPEN];
+
+// 64-bit hash of an attribute value (FNV-1a, with the bits mixed at the end
+// so that the first bits alone are as good as the whole hash)
+static uint64_t hashValue(Attribute attrVal, int attrType)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	if (attrType == NUMBER)
+	{
+		// (0.0 and -0.0 are the same value)
+		double nVal = attrVal.nVal == 0 ? 0 : attrVal.nVal;
+
+		unsigned char bytes[sizeof(double)];
+		memcpy(bytes, &nVal, sizeof(double));
+
+		for (int byteIndex = 0; byteIndex < (int)sizeof(double); byteIndex++)
+			hash = (hash ^ bytes[byteIndex]) * 1099511628211ull;
+	}
+	else
+	{
+		for (int charIndex = 0; charIndex < ATTR_SIZE && attrVal.sVal[charIndex] != '\0'; charIndex++)
+			hash = (hash ^ (unsigned char)attrVal.sVal[charIndex]) * 1099511628211ull;
+	}
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+
+	return hash;
+}
+
+// add the values of `record` to the sketches
+static void addRecord(AttrStats *stats, union Attribute *record)
+{
+	for (int attrOffset = 0; attrOffset < stats->numAttrs; attrOffset++)
+	{
+		uint64_t hash = hashValue(record[attrOffset], stats->attrTypes[attrOffset]);
+
+		// the first 8 bits pick the register (DISTINCT_SKETCH_REGISTERS = 2^8),
+		// and the register keeps the position of the first 1 bit in the rest
+		int registerIndex = hash >> 56;
+		uint64_t rest = hash << 8;
+		unsigned char position = rest == 0 ? 57 : __builtin_clzll(rest) + 1;
+
+		unsigned char *registers = stats->registers + attrOffset * DISTINCT_SKETCH_REGISTERS;
+		if (position > registers[registerIndex]) registers[registerIndex] = position;
+	}
+}
+
+//* Get the estimated number of distinct values of the attribute at `attrOffset`
+//* in the relation with rel-id `relId` (E_NOTFOUND if its sketches are not complete yet)
+int AttrStatsTable::getNumDistinct(int relId, int attrOffset, double *numDistinct)
+{
+	// the catalogs have no statistics
+	if (relId <= ATTRCAT_RELID || relId >= MAX_OPEN) return E_OUTOFBOUND;
+
+	AttrStats *stats = attrStats[relId];
+	if (stats == nullptr || !stats->complete) return E_NOTFOUND;
+
+	if (attrOffset < 0 || attrOffset >= stats->numAttrs) return E_OUTOFBOUND;
+
+	unsigned char *registers = stats->registers + attrOffset * DISTINCT_SKETCH_REGISTERS;
+
+	double sum = 0;
+	int numZero = 0;
+	for (int registerIndex = 0; registerIndex < DISTINCT_SKETCH_REGISTERS; registerIndex++)
+	{
+		sum += ldexp(1.0, -registers[registerIndex]);
+		if (registers[registerIndex] == 0) numZero++;
+	}
+
+	double m = DISTINCT_SKETCH_REGISTERS;
+	double estimate = (0.7213 / (1 + 1.079 / m)) * m * m / sum;
+
+	// (for small counts, the number of registers still unset is more accurate)
+	if (estimate <= 2.5 * m && numZero > 0)
+		estimate = m * log(m / numZero);
+
+	// there cannot be more distinct values than records, nor fewer than one
+	// if there is a record at all
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+	if (estimate > relCatEntry.numRecs) estimate = relCatEntry.numRecs;
+	if (estimate < 1 && relCatEntry.numRecs > 0) estimate = 1;
+
+	*numDistinct = estimate;
+	return SUCCESS;
+}
+
+//* Add the values of `record` to the sketches of the relation (called after a record is inserted)
+int AttrStatsTable::update(int relId, union Attribute *record)
+{
+	if (relId < 0 || relId >= MAX_OPEN) return E_OUTOFBOUND;
+
+	// the first record of a relation starts its sketches, complete (there is
+	// no other record to read); otherwise there is nothing to do if they have
+	// not been started, they will be built by a scan
+	if (attrStats[relId] == nullptr)
+	{
+		RelCatEntry relCatEntry;
+		if (relId <= ATTRCAT_RELID || RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS ||
+			relCatEntry.numRecs != 0)
+			return SUCCESS;
+
+		int ret = create(relId);
+		if (ret != SUCCESS) return ret;
+
+		attrStats[relId]->complete = true;
+	}
+
+	// (while a scan is building the sketches, the record may be added again
+	// when the scan reaches it, which leaves the sketches as they are)
+	addRecord(attrStats[relId], record);
+	return SUCCESS;
+}
+
+// start empty sketches for the relation, to be built from its first block
+int AttrStatsTable::create(int relId)
+{
+	RelCatEntry relCatEntry;
+	int ret = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	AttrStats *stats = (AttrStats *)malloc(sizeof(AttrStats));
+	if (stats == nullptr) return FAILURE;
+
+	stats->numAttrs = relCatEntry.numAttrs;
+	stats->attrTypes = (int *)malloc(relCatEntry.numAttrs * sizeof(int));
+	stats->registers = (unsigned char *)calloc(relCatEntry.numAttrs * DISTINCT_SKETCH_REGISTERS, 1);
+	stats->complete = false;
+	stats->nextBlock = relCatEntry.firstBlk;
+	attrStats[relId] = stats;
+
+	if (stats->attrTypes == nullptr || stats->registers == nullptr)
+	{
+		release(relId);
+		return FAILURE;
+	}
+
+	for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+	{
+		AttrCatEntry attrCatEntry;
+		AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+		stats->attrTypes[attrOffset] = attrCatEntry.attrType;
+	}
+
+	return SUCCESS;
+}
+
+/*
+	Adds the records of `block`, which a scan has just read, to the sketches
+	of the relation if they are being built and the block is the one they
+	need next (see ZoneMapTable::addBlock(), which builds the zone map from
+	the same scan the same way).
+*/
+void AttrStatsTable::addBlock(int relId, int block)
+{
+	if (relId <= ATTRCAT_RELID || relId >= MAX_OPEN) return;
+	if (attrStats[relId] != nullptr && attrStats[relId]->complete) return;
+
+	RelCatEntry relCatEntry;
+	if (RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS) return;
+
+	if (block == relCatEntry.firstBlk)
+	{
+		release(relId);
+		if (create(relId) != SUCCESS) return;
+	}
+
+	AttrStats *stats = attrStats[relId];
+	if (stats == nullptr || block != stats->nextBlock) return;
+
+	RecBuffer blockBuffer (block);
+
+	HeadInfo blockHeader;
+	blockBuffer.getHeader(&blockHeader);
+
+	unsigned char slotMap[blockHeader.numSlots];
+	blockBuffer.getSlotMap(slotMap);
+
+	Attribute record[relCatEntry.numAttrs];
+	for (int slot = 0; slot < blockHeader.numSlots; slot++)
+	{
+		if (slotMap[slot] == SLOT_UNOCCUPIED) continue;
+
+		blockBuffer.getRecord(record, slot);
+		addRecord(stats, record);
+	}
+
+	stats->nextBlock = blockHeader.rblock;
+	stats->complete = blockHeader.rblock == -1;
+}
+
+// free the sketches of the relation (called when the relation is closed)
+void AttrStatsTable::release(int relId)
+{
+	if (relId < 0 || relId >= MAX_OPEN || attrStats[relId] == nullptr) return;
+
+	free(attrStats[relId]->attrTypes);
+	free(attrStats[relId]->registers);
+	free(attrStats[relId]);
+	attrStats[relId] = nullptr;
+}
@@ -0,0 +1,58 @@
+#ifndef NITCBASE_ATTRSTATSTABLE_H
+#define NITCBASE_ATTRSTATSTABLE_H
+
+#include "../Buffer/BlockBuffer.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+/*
+	Statistics on the attributes of an open relation, for the query optimizer:
+	an estimate of the number of distinct values of every attribute (together
+	with #Records from the relation catalog, this gives the selectivity of an
+	`=` condition on the attribute).
+
+	The number of distinct values is estimated with a HyperLogLog sketch of
+	DISTINCT_SKETCH_REGISTERS registers per attribute: the hash of every value
+	picks a register with its first bits, and the register keeps the largest
+	position of the first 1 bit seen in the rest of the hash. Equal values set
+	the same register to the same position, so duplicates do not change the
+	sketch, and a few hundred bytes give an estimate within a few percent of
+	the true count.
+
+	Like the zone map (ZoneMapTable), the sketches of a relation are built by
+	the first scan that reads all of its blocks in rblock order, and used only
+	once they are complete (they are never built just to be asked for); a
+	relation that is empty when its first record is inserted starts out with
+	complete ones. They are kept up to date by BlockAccess::insert() while the
+	relation is open, and dropped when the relation is closed.
+*/
+
+typedef struct AttrStats
+{
+	int numAttrs;
+	int *attrTypes;
+	unsigned char *registers;	// DISTINCT_SKETCH_REGISTERS registers per attribute
+	bool complete;				// whether every record has been added
+	int nextBlock;				// while not complete, the block to add next
+} AttrStats;
+
+class AttrStatsTable
+{
+	friend class OpenRelTable;
+
+public:
+	// methods
+	static int getNumDistinct(int relId, int attrOffset, double *numDistinct);
+	static void addBlock(int relId, int block);
+	static int update(int relId, union Attribute *record);
+
+private:
+	// field
+	static AttrStats *attrStats[MAX_OPEN];
+
+	// methods
+	static int create(int relId);
+	static void release(int relId);
+};
+
+#endif // NITCBASE_ATTRSTATSTABLE_H
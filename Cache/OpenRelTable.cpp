@@ -60,6 +60,7 @@ OpenRelTable::OpenRelTable()
 		relCacheEntry->recId.slot = relId;
 
 		relCacheEntry->searchIndex = {-1, -1};
+		relCacheEntry->searchBlock.block = -1;
 
 		RelCacheTable::relCache[relId] = relCacheEntry;
 	}
@@ -281,6 +282,10 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE])
 	// update the recId field of this Relation Cache entry to relcatRecId.
 	relCacheBuffer->recId.block = relcatRecId.block;
 	relCacheBuffer->recId.slot = relcatRecId.slot;
+
+	// no search of the relation has been made yet
+	relCacheBuffer->searchIndex = {-1, -1};
+	relCacheBuffer->searchBlock.block = -1;
 	
 	// use the Relation Cache entry to set the relId-th entry of the RelCacheTable.
 	RelCacheTable::relCache[relId] = relCacheBuffer;	
@@ -400,6 +405,12 @@ int OpenRelTable::closeRel(int relId) {
 		next = next->next;
 	}
 
+	// free the zone map of the relation (if one was built)
+	ZoneMapTable::release(relId);
+
+	// and its statistics
+	AttrStatsTable::release(relId);
+
 	// update `tableMetaInfo` to set `relId` as a free slot
 	// update `relCache` and `attrCache` to set the entry at `relId` to nullptr
 	tableMetaInfo[relId].free = true;
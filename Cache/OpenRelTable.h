@@ -5,7 +5,9 @@
 #include "../Buffer/BlockBuffer.h"
 #include "../define/constants.h"
 #include "AttrCacheTable.h"
+#include "AttrStatsTable.h"
 #include "RelCacheTable.h"
+#include "ZoneMapTable.h"
 
 typedef struct OpenRelTableMetaInfo
 {
@@ -117,5 +117,49 @@ int RelCacheTable::resetSearchIndex(int relId)
 		
 	// use setSearchIndex to set the search index to {-1, -1}
 	RelCacheTable::relCache[relId]->searchIndex = {-1, -1};
+
+	// (a new search does not resume in the block of the last one)
+	RelCacheTable::relCache[relId]->searchBlock.block = -1;
+	return SUCCESS;
+}
+
+//* will return the block the linear search of the relation corresponding to `relId` stopped in
+int RelCacheTable::getSearchBlock(int relId, SearchBlock *searchBlock)
+{
+	if (relId < 0 || relId >= MAX_OPEN)
+		return E_OUTOFBOUND;
+
+	if (RelCacheTable::relCache[relId] == nullptr)
+		return E_RELNOTOPEN;
+
+	*searchBlock = relCache[relId]->searchBlock;
+	return SUCCESS;
+}
+
+//* sets the block the linear search of the relation corresponding to `relId` stopped in
+int RelCacheTable::setSearchBlock(int relId, SearchBlock *searchBlock)
+{
+	if (relId < 0 || relId >= MAX_OPEN)
+		return E_OUTOFBOUND;
+
+	if (RelCacheTable::relCache[relId] == nullptr)
+		return E_RELNOTOPEN;
+
+	relCache[relId]->searchBlock = *searchBlock;
+	return SUCCESS;
+}
+
+//* forgets the block the linear search stopped in (e.g. after a record is inserted
+//* into the relation, which may change the selection of the block), but not the
+//* search index, so the search still resumes where it was
+int RelCacheTable::resetSearchBlock(int relId)
+{
+	if (relId < 0 || relId >= MAX_OPEN)
+		return E_OUTOFBOUND;
+
+	if (RelCacheTable::relCache[relId] == nullptr)
+		return E_RELNOTOPEN;
+
+	relCache[relId]->searchBlock.block = -1;
 	return SUCCESS;
 }
\ No newline at end of file
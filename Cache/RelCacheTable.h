@@ -16,12 +16,30 @@ typedef struct RelCatEntry
 
 } RelCatEntry;
 
+struct ZoneMapEntry;
+
+// the block a linear search of the relation stopped in, filtered on the
+// condition of the search, so that the next call resumes in it without
+// evaluating the condition over the block again (or looking up its zone)
+typedef struct SearchBlock
+{
+	int block;			// -1 if there is none
+	int attrOffset;		// the condition: attribute, operator and value
+	int op;
+	Attribute attrVal;
+	uint64_t selected[SELECTION_BITMAP_WORDS];	// bit i is set if slot i satisfies it
+	int rblock;
+	struct ZoneMapEntry *zone;	// its zone (nullptr if the relation has no zone map)
+
+} SearchBlock;
+
 typedef struct RelCacheEntry
 {
 	RelCatEntry relCatEntry;
 	bool dirty;
 	RecId recId;
 	RecId searchIndex;
+	SearchBlock searchBlock;
 
 } RelCacheEntry;
 
@@ -36,6 +54,9 @@ public:
 	static int getSearchIndex(int relId, RecId *searchIndex);
 	static int setSearchIndex(int relId, RecId *searchIndex);
 	static int resetSearchIndex(int relId);
+	static int getSearchBlock(int relId, SearchBlock *searchBlock);
+	static int setSearchBlock(int relId, SearchBlock *searchBlock);
+	static int resetSearchBlock(int relId);
 
 private:
 	// field
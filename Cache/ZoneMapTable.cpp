@@ -0,0 +1,257 @@
+#include "ZoneMapTable.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "AttrCacheTable.h"
+#include "RelCacheTable.h"
+
+ZoneMap *ZoneMapTable::zoneMaps[MAX_OPEN];
+
+//* Get the zone map entry of the first record block of the relation with rel-id `relId`
+//* (nullptr if the relation has none, or it has not been completed yet)
+ZoneMapEntry *ZoneMapTable::getZoneMap(int relId)
+{
+	// the catalogs are never zone-mapped
+	if (relId <= ATTRCAT_RELID || relId >= MAX_OPEN) return nullptr;
+
+	ZoneMap *zoneMap = zoneMaps[relId];
+	return zoneMap != nullptr && zoneMap->complete ? zoneMap->head : nullptr;
+}
+
+//* Get the zone map entry of `block`, a record block of the relation with rel-id `relId`
+ZoneMapEntry *ZoneMapTable::getZoneEntry(int relId, int block)
+{
+	ZoneMapEntry *entry = getZoneMap(relId);
+
+	while (entry != nullptr && entry->block != block)
+		entry = entry->next;
+
+	return entry;
+}
+
+//* Returns false only if no record of the block can satisfy `attr op attrVal`
+bool ZoneMapTable::mayMatch(ZoneMapEntry *entry, int attrOffset, int attrType, Attribute attrVal, int op)
+{
+	// (an empty block has nothing to offer)
+	if (entry->numEntries == 0) return false;
+
+	int cmpMin = compareAttrs(entry->minVal[attrOffset], attrVal, attrType);
+	int cmpMax = compareAttrs(entry->maxVal[attrOffset], attrVal, attrType);
+
+	switch (op)
+	{
+		case EQ: return cmpMin <= 0 && cmpMax >= 0;
+		case LE: return cmpMin <= 0;
+		case LT: return cmpMin < 0;
+		case GE: return cmpMax >= 0;
+		case GT: return cmpMax > 0;
+		case NE: return !(cmpMin == 0 && cmpMax == 0);
+	}
+
+	return true;
+}
+
+// widen the zone of `entry` to include `record`
+static void widenZone(ZoneMap *zoneMap, ZoneMapEntry *entry, union Attribute *record)
+{
+	for (int attrOffset = 0; attrOffset < zoneMap->numAttrs; attrOffset++)
+	{
+		int attrType = zoneMap->attrTypes[attrOffset];
+
+		if (entry->numEntries == 0 || compareAttrs(record[attrOffset], entry->minVal[attrOffset], attrType) < 0)
+			entry->minVal[attrOffset] = record[attrOffset];
+
+		if (entry->numEntries == 0 || compareAttrs(record[attrOffset], entry->maxVal[attrOffset], attrType) > 0)
+			entry->maxVal[attrOffset] = record[attrOffset];
+	}
+
+	entry->numEntries++;
+}
+
+//* Widen the zone of recId.block to include `record` (called after a record is inserted)
+int ZoneMapTable::update(int relId, RecId recId, union Attribute *record)
+{
+	if (relId < 0 || relId >= MAX_OPEN) return E_OUTOFBOUND;
+
+	// the first record of a relation starts its zone map, complete (there
+	// is no other record to read); otherwise there is nothing to do if the
+	// zone map has not been started, it will be built by a scan
+	ZoneMap *zoneMap = zoneMaps[relId];
+	if (zoneMap == nullptr)
+	{
+		RelCatEntry relCatEntry;
+		if (relId <= ATTRCAT_RELID || RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS ||
+			relCatEntry.numRecs != 0)
+			return SUCCESS;
+
+		int ret = create(relId);
+		if (ret != SUCCESS) return ret;
+
+		zoneMap = zoneMaps[relId];
+		zoneMap->complete = true;
+	}
+
+	// a new record block is always linked at the end of the relation
+	ZoneMapEntry *entry = zoneMap->tail;
+	if (entry == nullptr || entry->block != recId.block)
+	{
+		entry = zoneMap->head;
+		while (entry != nullptr && entry->block != recId.block)
+			entry = entry->next;
+	}
+
+	// (while a scan is building the zone map, a block it has not reached yet
+	// is left to it; it will read the record along with the others)
+	if (entry == nullptr && !zoneMap->complete) return SUCCESS;
+	if (entry == nullptr) entry = createEntry(zoneMap, recId.block);
+
+	// if the entry could not be allocated, drop the whole zone map so that
+	// no block is ever skipped on the basis of a stale zone
+	if (entry == nullptr)
+	{
+		release(relId);
+		return FAILURE;
+	}
+
+	widenZone(zoneMap, entry, record);
+	return SUCCESS;
+}
+
+// append an empty zone for `block` at the end of the zone map
+ZoneMapEntry *ZoneMapTable::createEntry(ZoneMap *zoneMap, int block)
+{
+	ZoneMapEntry *entry = (ZoneMapEntry *)malloc(sizeof(ZoneMapEntry));
+	if (entry == nullptr) return nullptr;
+
+	entry->minVal = (Attribute *)malloc(zoneMap->numAttrs * sizeof(Attribute));
+	entry->maxVal = (Attribute *)malloc(zoneMap->numAttrs * sizeof(Attribute));
+	if (entry->minVal == nullptr || entry->maxVal == nullptr)
+	{
+		free(entry->minVal);
+		free(entry->maxVal);
+		free(entry);
+		return nullptr;
+	}
+
+	entry->block = block;
+	entry->numEntries = 0;
+	entry->next = nullptr;
+
+	if (zoneMap->tail == nullptr) zoneMap->head = entry;
+	else zoneMap->tail->next = entry;
+	zoneMap->tail = entry;
+
+	return entry;
+}
+
+// start an empty zone map for the relation, to be built from its first block
+int ZoneMapTable::create(int relId)
+{
+	RelCatEntry relCatEntry;
+	int ret = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	if (ret != SUCCESS) return ret;
+
+	ZoneMap *zoneMap = (ZoneMap *)malloc(sizeof(ZoneMap));
+	if (zoneMap == nullptr) return FAILURE;
+
+	zoneMap->numAttrs = relCatEntry.numAttrs;
+	zoneMap->head = zoneMap->tail = nullptr;
+	zoneMap->complete = false;
+	zoneMap->nextBlock = relCatEntry.firstBlk;
+	zoneMap->attrTypes = (int *)malloc(relCatEntry.numAttrs * sizeof(int));
+	zoneMaps[relId] = zoneMap;
+
+	if (zoneMap->attrTypes == nullptr)
+	{
+		release(relId);
+		return FAILURE;
+	}
+
+	for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+	{
+		AttrCatEntry attrCatEntry;
+		AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+		zoneMap->attrTypes[attrOffset] = attrCatEntry.attrType;
+	}
+
+	return SUCCESS;
+}
+
+/*
+	Adds the zone of `block`, which a scan has just read, to the zone map of
+	the relation if the zone map is being built and the block is the one it
+	needs next. The zone map is built from the blocks of a scan that reads
+	them all in rblock order, starting from the first one (a scan starting
+	over from the first block starts it over), and is complete once the last
+	block has been added. Any other block is ignored.
+*/
+void ZoneMapTable::addBlock(int relId, int block)
+{
+	if (relId <= ATTRCAT_RELID || relId >= MAX_OPEN) return;
+	if (zoneMaps[relId] != nullptr && zoneMaps[relId]->complete) return;
+
+	RelCatEntry relCatEntry;
+	if (RelCacheTable::getRelCatEntry(relId, &relCatEntry) != SUCCESS) return;
+
+	if (block == relCatEntry.firstBlk)
+	{
+		release(relId);
+		if (create(relId) != SUCCESS) return;
+	}
+
+	ZoneMap *zoneMap = zoneMaps[relId];
+	if (zoneMap == nullptr || block != zoneMap->nextBlock) return;
+
+	RecBuffer blockBuffer (block);
+
+	HeadInfo blockHeader;
+	blockBuffer.getHeader(&blockHeader);
+
+	unsigned char slotMap[blockHeader.numSlots];
+	blockBuffer.getSlotMap(slotMap);
+
+	ZoneMapEntry *entry = createEntry(zoneMap, block);
+	if (entry == nullptr)
+	{
+		release(relId);
+		return;
+	}
+
+	Attribute record[relCatEntry.numAttrs];
+	for (int slot = 0; slot < blockHeader.numSlots; slot++)
+	{
+		if (slotMap[slot] == SLOT_UNOCCUPIED) continue;
+
+		blockBuffer.getRecord(record, slot);
+		widenZone(zoneMap, entry, record);
+	}
+
+	zoneMap->nextBlock = blockHeader.rblock;
+	zoneMap->complete = blockHeader.rblock == -1;
+}
+
+// free the zone map of the relation (called when the relation is closed)
+void ZoneMapTable::release(int relId)
+{
+	if (relId < 0 || relId >= MAX_OPEN || zoneMaps[relId] == nullptr) return;
+
+	ZoneMapEntry *entry = zoneMaps[relId]->head;
+	while (entry != nullptr)
+	{
+		ZoneMapEntry *next = entry->next;
+
+		free(entry->minVal);
+		free(entry->maxVal);
+		free(entry);
+
+		entry = next;
+	}
+
+	free(zoneMaps[relId]->attrTypes);
+	free(zoneMaps[relId]);
+	zoneMaps[relId] = nullptr;
+
+	// (a linear search stopped in the relation must not resume from a zone freed here)
+	RelCacheTable::resetSearchBlock(relId);
+}
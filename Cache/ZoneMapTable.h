@@ -0,0 +1,65 @@
+#ifndef NITCBASE_ZONEMAPTABLE_H
+#define NITCBASE_ZONEMAPTABLE_H
+
+#include "../Buffer/BlockBuffer.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+/*
+	A zone map keeps, for every record block of an open relation, the smallest
+	and largest value of each attribute stored in the block. A scan can then
+	skip a whole block without reading it when no value in [min, max] can
+	satisfy its condition. This helps most on append-ordered data such as ids
+	and timestamps, where each block covers a narrow range.
+
+	The zone map of a relation is built by the first scan (ScanCursor) that
+	reads all of its blocks in rblock order, from the blocks the scan reads
+	anyway, and used only once it is complete; a relation that is empty when
+	its first record is inserted starts out with a complete one. It is kept
+	up to date by BlockAccess::insert() while the relation is open, and
+	dropped when the relation is closed. The catalogs are not zone-mapped,
+	since their records are also modified in place.
+*/
+
+typedef struct ZoneMapEntry
+{
+	int block;
+	int numEntries;			// number of occupied slots in the block
+	Attribute *minVal;		// smallest value of each attribute (numAttrs values)
+	Attribute *maxVal;		// largest value of each attribute (numAttrs values)
+	struct ZoneMapEntry *next;	// entry of the next block in the relation (rblock)
+} ZoneMapEntry;
+
+typedef struct ZoneMap
+{
+	int numAttrs;
+	int *attrTypes;			// type of each attribute, to compare values
+	ZoneMapEntry *head;
+	ZoneMapEntry *tail;
+	bool complete;			// whether every record block has its zone
+	int nextBlock;			// while not complete, the block whose zone comes next
+} ZoneMap;
+
+class ZoneMapTable
+{
+	friend class OpenRelTable;
+
+public:
+	// methods
+	static ZoneMapEntry *getZoneMap(int relId);
+	static ZoneMapEntry *getZoneEntry(int relId, int block);
+	static bool mayMatch(ZoneMapEntry *entry, int attrOffset, int attrType, Attribute attrVal, int op);
+	static void addBlock(int relId, int block);
+	static int update(int relId, RecId recId, union Attribute *record);
+
+private:
+	// field
+	static ZoneMap *zoneMaps[MAX_OPEN];
+
+	// methods
+	static int create(int relId);
+	static void release(int relId);
+	static ZoneMapEntry *createEntry(ZoneMap *zoneMap, int block);
+};
+
+#endif // NITCBASE_ZONEMAPTABLE_H
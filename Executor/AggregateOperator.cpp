@@ -0,0 +1,390 @@
+#include "AggregateOperator.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "../BPlusTree/BPlusTree.h"
+#include "ScanOperator.h"
+
+AggregateOperator::AggregateOperator(Operator *child, char groupAttr[ATTR_SIZE], int numAggs, int funcs[],
+									 char aggAttrs[][ATTR_SIZE])
+{
+	this->child = child;
+	position = 0;
+
+	status = child->getStatus();
+
+	groupOffset = -1;
+	if (groupAttr != nullptr)
+	{
+		groupOffset = child->getAttrOffset(groupAttr);
+		if (groupOffset < 0 && status == SUCCESS) status = E_ATTRNOTEXIST;
+		if (groupOffset >= 0) attrs.push_back(*child->getAttr(groupOffset));
+	}
+
+	static const char *funcNames[] = {"COUNT", "SUM", "MIN", "MAX", "AVG"};
+
+	for (int aggIndex = 0; aggIndex < numAggs; aggIndex++)
+	{
+		int func = funcs[aggIndex];
+		int aggOffset = -1;
+		OperatorAttr attr;
+
+		if (func == AGG_COUNT && strcmp(aggAttrs[aggIndex], "*") == 0)
+		{
+			strcpy(attr.attrName, funcNames[func]);
+		}
+		else
+		{
+			aggOffset = child->getAttrOffset(aggAttrs[aggIndex]);
+			if (aggOffset < 0)
+			{
+				if (status == SUCCESS) status = E_ATTRNOTEXIST;
+				continue;
+			}
+
+			int attrType = child->getAttr(aggOffset)->attrType;
+			if ((func == AGG_SUM || func == AGG_AVG) && attrType != NUMBER && status == SUCCESS)
+				status = E_ATTRTYPEMISMATCH;
+
+			snprintf(attr.attrName, ATTR_SIZE, "%s_%s", funcNames[func], aggAttrs[aggIndex]);
+		}
+
+		attr.attrType = (func == AGG_MIN || func == AGG_MAX) && aggOffset >= 0 ? child->getAttr(aggOffset)->attrType
+																			  : NUMBER;
+		attrs.push_back(attr);
+
+		this->funcs.push_back(func);
+		aggOffsets.push_back(aggOffset);
+	}
+
+	// (without a group attribute, the single group has a key of 0)
+	int groupType = groupOffset == -1 ? NUMBER : attrs[0].attrType;
+	groups = new HashTable(1, &groupType, child->getNumAttrs(), getMaxGroups(numAggs));
+}
+
+AggregateOperator::~AggregateOperator()
+{
+	close();
+	delete groups;
+	delete child;
+}
+
+int AggregateOperator::getMaxGroups(int numAggs)
+{
+	// (a group takes its value in the table, and the states of its aggregates)
+	return HashTable::getMaxKeys(1, numAggs * sizeof(AggState));
+}
+
+// the (empty) states of the aggregates of a new group
+void AggregateOperator::addStates()
+{
+	AggState state;
+	state.count = state.sum = 0;
+	memset(&state.min, 0, sizeof(Attribute));
+	memset(&state.max, 0, sizeof(Attribute));
+	states.insert(states.end(), funcs.size(), state);
+}
+
+void AggregateOperator::accumulate(int group, Attribute *record)
+{
+	for (int aggIndex = 0; aggIndex < (int)funcs.size(); aggIndex++)
+	{
+		AggState &state = states[group * funcs.size() + aggIndex];
+		int aggOffset = aggOffsets[aggIndex];
+
+		if (aggOffset != -1)
+		{
+			Attribute attrVal = record[aggOffset];
+			int attrType = attrs[(groupOffset == -1 ? 0 : 1) + aggIndex].attrType;
+
+			if (funcs[aggIndex] == AGG_SUM || funcs[aggIndex] == AGG_AVG) state.sum += attrVal.nVal;
+			if (state.count == 0 || compareAttrs(attrVal, state.min, attrType) < 0) state.min = attrVal;
+			if (state.count == 0 || compareAttrs(attrVal, state.max, attrType) > 0) state.max = attrVal;
+		}
+
+		state.count++;
+	}
+}
+
+// the result record of a group: its value, then the aggregates
+void AggregateOperator::output(int group, Attribute groupVal, Attribute *record)
+{
+	int attrIndex = 0;
+
+	if (groupOffset != -1) record[attrIndex++] = groupVal;
+
+	for (int aggIndex = 0; aggIndex < (int)funcs.size(); aggIndex++, attrIndex++)
+	{
+		AggState &state = states[group * funcs.size() + aggIndex];
+
+		switch (funcs[aggIndex])
+		{
+			case AGG_COUNT: record[attrIndex].nVal = state.count; break;
+			case AGG_SUM: record[attrIndex].nVal = state.sum; break;
+			case AGG_AVG: record[attrIndex].nVal = state.count == 0 ? 0 : state.sum / state.count; break;
+			case AGG_MIN: record[attrIndex] = state.min; break;
+			case AGG_MAX: record[attrIndex] = state.max; break;
+		}
+	}
+}
+
+/*
+	Accumulates the record into its group, adding the group to the table if
+	it is not there yet; if there is no room for it, the record is spilled to
+	its partition instead.
+*/
+int AggregateOperator::addRecord(Attribute *record)
+{
+	Attribute *groupVal = &record[groupOffset];
+	uint32_t hash = groups->hash(groupVal);
+
+	int group = groups->find(groupVal, hash);
+	if (group == -1)
+	{
+		if (!groups->hasRoom()) return groups->spill(record, hash);
+
+		group = groups->add(groupVal, hash);
+		addStates();
+	}
+
+	accumulate(group, record);
+	return SUCCESS;
+}
+
+int AggregateOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+
+	// (without a group attribute, the single group is there from the start)
+	Attribute noGroup;
+	memset(&noGroup, 0, sizeof(Attribute));
+	if (groupOffset == -1)
+	{
+		groups->add(&noGroup, groups->hash(&noGroup));
+		addStates();
+	}
+
+	int ret = child->open();
+
+	Attribute record[child->getNumAttrs()];
+	while (ret == SUCCESS && (ret = child->next(record)) == SUCCESS)
+	{
+		if (groupOffset == -1)
+			accumulate(0, record);
+		else
+			ret = addRecord(record);
+	}
+
+	child->close();
+
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+// aggregates the records of the partition the table has moved on to
+int AggregateOperator::aggregatePartition()
+{
+	states.clear();
+	position = 0;
+
+	Attribute record[child->getNumAttrs()];
+
+	int ret;
+	while ((ret = groups->nextSpilled(record)) == SUCCESS)
+	{
+		ret = addRecord(record);
+		if (ret != SUCCESS) return ret;
+	}
+
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+int AggregateOperator::next(Attribute *record)
+{
+	while (position >= groups->getNumKeys())
+	{
+		int ret = groups->nextPartition();
+		if (ret != SUCCESS) return ret;
+
+		ret = aggregatePartition();
+		if (ret != SUCCESS) return ret;
+	}
+
+	int group = position++;
+	output(group, *groups->getKey(group), record);
+
+	return SUCCESS;
+}
+
+void AggregateOperator::close()
+{
+	groups->clear();
+	states.clear();
+	position = 0;
+}
+
+SortAggregateOperator::SortAggregateOperator(Operator *child, char groupAttr[ATTR_SIZE], int numAggs, int funcs[],
+											 char aggAttrs[][ATTR_SIZE])
+	: AggregateOperator(child, groupAttr, numAggs, funcs, aggAttrs)
+{
+	pending = nullptr;
+	hasPending = false;
+
+	// (the records have to be in order of something)
+	if (groupAttr == nullptr && status == SUCCESS) status = E_INVALID;
+}
+
+SortAggregateOperator::~SortAggregateOperator()
+{
+	close();
+}
+
+int SortAggregateOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+	pending = new Attribute[child->getNumAttrs()];
+	addStates();
+
+	int ret = child->open();
+	if (ret != SUCCESS) return ret;
+
+	ret = child->next(pending);
+	hasPending = ret == SUCCESS;
+
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+int SortAggregateOperator::next(Attribute *record)
+{
+	if (!hasPending) return E_NOTFOUND;
+
+	// the records up to the first one with another group value make up the group
+	Attribute groupVal = pending[groupOffset];
+
+	states.clear();
+	addStates();
+
+	int ret;
+	do
+	{
+		accumulate(0, pending);
+		ret = child->next(pending);
+	} while (ret == SUCCESS && compareAttrs(pending[groupOffset], groupVal, attrs[0].attrType) == 0);
+
+	hasPending = ret == SUCCESS;
+	if (ret != SUCCESS && ret != E_NOTFOUND) return ret;
+
+	output(0, groupVal, record);
+	return SUCCESS;
+}
+
+void SortAggregateOperator::close()
+{
+	if (pending != nullptr) child->close();
+
+	delete[] pending;
+	pending = nullptr;
+	hasPending = false;
+	states.clear();
+}
+
+// (the scan is never opened; it only gives the attributes of the relation)
+IndexAggregateOperator::IndexAggregateOperator(int relId, int numAggs, int funcs[], char aggAttrs[][ATTR_SIZE],
+											   PredicateNode *condition)
+	: AggregateOperator(new ScanOperator(relId), nullptr, numAggs, funcs, aggAttrs)
+{
+	this->relId = relId;
+	this->condition = condition;
+	done = true;
+}
+
+bool IndexAggregateOperator::canAnswer(int relId, int numAggs, int funcs[], char aggAttrs[][ATTR_SIZE],
+									   PredicateNode *condition)
+{
+	// (bPlusCount() counts a single comparison)
+	if (condition != nullptr && (condition->type != PRED_COMPARE || condition->rootBlock == -1)) return false;
+
+	for (int aggIndex = 0; aggIndex < numAggs; aggIndex++)
+	{
+		if (funcs[aggIndex] == AGG_COUNT) continue;
+		if (funcs[aggIndex] != AGG_MIN && funcs[aggIndex] != AGG_MAX) return false;
+
+		// (the first and last entries are those of the whole relation)
+		AttrCatEntry attrCatEntry;
+		if (condition != nullptr || AttrCacheTable::getAttrCatEntry(relId, aggAttrs[aggIndex], &attrCatEntry) != SUCCESS ||
+			attrCatEntry.rootBlock == -1)
+			return false;
+	}
+
+	return true;
+}
+
+int IndexAggregateOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+	addStates();
+
+	for (int aggIndex = 0; aggIndex < (int)funcs.size(); aggIndex++)
+	{
+		AggState &state = states[aggIndex];
+
+		if (funcs[aggIndex] == AGG_COUNT)
+		{
+			int count;
+			if (condition == nullptr)
+			{
+				RelCatEntry relCatEntry;
+				RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+				count = relCatEntry.numRecs;
+			}
+			else
+			{
+				int ret = BPlusTree::bPlusCount(relId, condition->attrName, condition->attrVal, condition->op, &count);
+				if (ret != SUCCESS) return ret;
+			}
+
+			state.count = count;
+			continue;
+		}
+
+		// MIN or MAX (left 0 or "" if the relation is empty)
+		AttrCatEntry attrCatEntry;
+		AttrCacheTable::getAttrCatEntry(relId, aggOffsets[aggIndex], &attrCatEntry);
+
+		Index entry;
+		int ret = funcs[aggIndex] == AGG_MIN ? BPlusTree::getFirstEntry(attrCatEntry.rootBlock, &entry)
+											 : BPlusTree::getLastEntry(attrCatEntry.rootBlock, &entry);
+		if (ret == E_NOTFOUND) continue;
+		if (ret != SUCCESS) return ret;
+
+		state.min = state.max = entry.attrVal;
+		state.count = 1;
+	}
+
+	done = false;
+	return SUCCESS;
+}
+
+int IndexAggregateOperator::next(Attribute *record)
+{
+	if (done) return E_NOTFOUND;
+	done = true;
+
+	Attribute noGroup;
+	memset(&noGroup, 0, sizeof(Attribute));
+	output(0, noGroup, record);
+
+	return SUCCESS;
+}
+
+void IndexAggregateOperator::close()
+{
+	states.clear();
+	done = true;
+}
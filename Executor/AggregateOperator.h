@@ -0,0 +1,135 @@
+#ifndef NITCBASE_AGGREGATEOPERATOR_H
+#define NITCBASE_AGGREGATEOPERATOR_H
+
+#include <cstdint>
+
+#include "../BlockAccess/Predicate.h"
+#include "HashTable.h"
+#include "Operator.h"
+
+enum AggregateFunction {
+  AGG_NONE = -1,  // (in a select list) the group attribute itself
+  AGG_COUNT,
+  AGG_SUM,
+  AGG_MIN,
+  AGG_MAX,
+  AGG_AVG
+};
+
+/*
+    Groups the records of the child on the value of one attribute and
+    computes aggregates (COUNT, SUM, MIN, MAX, AVG) of other attributes over
+    every group. A record of the result holds the value of the group
+    attribute followed by the aggregates, each named FUNC_attr (e.g.
+    SUM_marks; COUNT of `*` is just COUNT), one record per group.
+
+    The groups are kept in a HashTable on the group attribute, filled when
+    the operator is opened. The table holds at most as many groups as fit in
+    OPERATOR_MEMORY_BLOCKS (getMaxGroups()); once it is full, the records of
+    groups that are not in it are spilled to its partitions, so that all the
+    records of a group land in the same partition. The groups in the table
+    are handed out first, in the order they first appeared, and then those of
+    each partition, aggregated in the emptied table one partition at a time
+    (the records of a partition with too many groups are spilled again, and
+    split further, the same way).
+
+    Without a group attribute all the records form a single group, which is
+    there even if the child produced no record (COUNT and SUM are then 0, and
+    MIN, MAX and AVG, which have no value, are 0 or an empty string).
+*/
+class AggregateOperator : public Operator {
+ public:
+  // (groupAttr may be nullptr; SUM and AVG need NUMBER attributes)
+  AggregateOperator(Operator *child, char groupAttr[ATTR_SIZE], int numAggs, int funcs[],
+                    char aggAttrs[][ATTR_SIZE]);
+  ~AggregateOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+  // the number of groups with numAggs aggregates each the hash table holds
+  static int getMaxGroups(int numAggs);
+
+ protected:
+  typedef struct AggState {
+    double count;
+    double sum;
+    Attribute min;
+    Attribute max;
+  } AggState;
+
+  Operator *child;
+  int groupOffset;  // -1 without a group attribute
+  std::vector<int> funcs;
+  std::vector<int> aggOffsets;  // -1 for COUNT(*)
+  std::vector<AggState> states;  // numAggs states per group
+
+  void addStates();
+  void accumulate(int group, Attribute *record);
+  void output(int group, Attribute groupVal, Attribute *record);
+
+ private:
+  // the groups in memory (and the records of those that did not fit), and
+  // the next one to hand out
+  HashTable *groups;
+  int position;
+
+  int addRecord(Attribute *record);
+  int aggregatePartition();
+};
+
+/*
+    The same aggregates, over a child that produces its records in order of
+    the group attribute (e.g. an IndexOrderScanOperator, which reads them off
+    the B+ tree of the attribute): the records of a group come one after the
+    other, so a group is handed out as soon as a record of the next group is
+    read, and only the group being aggregated is held in memory. The groups
+    come out in the order of the group attribute.
+*/
+class SortAggregateOperator : public AggregateOperator {
+ public:
+  SortAggregateOperator(Operator *child, char groupAttr[ATTR_SIZE], int numAggs, int funcs[],
+                        char aggAttrs[][ATTR_SIZE]);
+  ~SortAggregateOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  // the first record of the next group (read ahead), if there is one
+  Attribute *pending;
+  bool hasPending;
+};
+
+/*
+    The aggregates of all the records of a relation (or of those that satisfy
+    a single comparison on an indexed attribute), answered without reading a
+    record block: COUNT(*) of the whole relation is #Records in the relation
+    catalog, COUNT under a comparison is a count of the leaf entries of its
+    B+ tree (BPlusTree::bPlusCount()), and MIN and MAX of an indexed attribute
+    are the first and last entries of its B+ tree. The result is a single
+    record, as for an AggregateOperator without a group attribute.
+*/
+class IndexAggregateOperator : public AggregateOperator {
+ public:
+  // (the condition, if any, must have been resolved against the relation)
+  IndexAggregateOperator(int relId, int numAggs, int funcs[], char aggAttrs[][ATTR_SIZE],
+                         PredicateNode *condition);
+
+  // whether all the aggregates can be answered this way
+  static bool canAnswer(int relId, int numAggs, int funcs[], char aggAttrs[][ATTR_SIZE],
+                        PredicateNode *condition);
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  int relId;
+  PredicateNode *condition;
+  bool done;
+};
+
+#endif  // NITCBASE_AGGREGATEOPERATOR_H
@@ -0,0 +1,110 @@
+#include "Batch.h"
+
+#include <cstdlib>
+#include <cstring>
+
+Batch::Batch(std::vector<OperatorAttr> &attrs)
+{
+	for (int attrOffset = 0; attrOffset < (int)attrs.size(); attrOffset++)
+	{
+		int attrType = attrs[attrOffset].attrType;
+		int width = attrType == NUMBER ? sizeof(double) : ATTR_SIZE;
+
+		// (aligned, so that the loops over a column can use aligned loads)
+		attrTypes.push_back(attrType);
+		data.push_back((unsigned char *)aligned_alloc(64, BATCH_SIZE * width));
+	}
+
+	clear();
+}
+
+Batch::~Batch()
+{
+	for (int attrOffset = 0; attrOffset < (int)data.size(); attrOffset++)
+		free(data[attrOffset]);
+}
+
+int Batch::getNumAttrs()
+{
+	return attrTypes.size();
+}
+
+int Batch::getAttrType(int attrOffset)
+{
+	return attrTypes[attrOffset];
+}
+
+double *Batch::numbers(int attrOffset)
+{
+	return (double *)data[attrOffset];
+}
+
+char (*Batch::strings(int attrOffset))[ATTR_SIZE]
+{
+	return (char (*)[ATTR_SIZE])data[attrOffset];
+}
+
+unsigned char **Batch::columns()
+{
+	return data.data();
+}
+
+void Batch::clear()
+{
+	numRows = numSelected = 0;
+}
+
+void Batch::selectAll()
+{
+	for (int row = 0; row < numRows; row++) selection[row] = row;
+	numSelected = numRows;
+}
+
+void Batch::getRow(int row, Attribute *record)
+{
+	for (int attrOffset = 0; attrOffset < (int)attrTypes.size(); attrOffset++)
+	{
+		if (attrTypes[attrOffset] == NUMBER)
+			record[attrOffset].nVal = numbers(attrOffset)[row];
+		else
+			memcpy(record[attrOffset].sVal, strings(attrOffset)[row], ATTR_SIZE);
+	}
+}
+
+void Batch::setRow(int row, Attribute *record)
+{
+	for (int attrOffset = 0; attrOffset < (int)attrTypes.size(); attrOffset++)
+	{
+		if (attrTypes[attrOffset] == NUMBER)
+			numbers(attrOffset)[row] = record[attrOffset].nVal;
+		else
+			memcpy(strings(attrOffset)[row], record[attrOffset].sVal, ATTR_SIZE);
+	}
+}
+
+BatchOperator::~BatchOperator()
+{
+	delete rows;
+}
+
+void BatchOperator::resetRows()
+{
+	if (rows != nullptr) rows->clear();
+	rowPosition = 0;
+}
+
+int BatchOperator::next(Attribute *record)
+{
+	if (rows == nullptr) rows = new Batch(attrs);
+
+	while (rowPosition >= rows->numSelected)
+	{
+		int ret = nextBatch(rows);
+		if (ret != SUCCESS) return ret;
+
+		rowPosition = 0;
+	}
+
+	rows->getRow(rows->selection[rowPosition++], record);
+	return SUCCESS;
+}
@@ -0,0 +1,79 @@
+#ifndef NITCBASE_BATCH_H
+#define NITCBASE_BATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Operator.h"
+
+/*
+    The vectorized engine: instead of one record per call to next(), batch
+    operators hand each other up to BATCH_SIZE records at a time, stored as
+    columns (a column of doubles for a NUMBER attribute, and one of ATTR_SIZE
+    chars for a STRING attribute). A filter does not move any data; it only
+    narrows the batch's selection vector, the positions of the rows that are
+    still part of the result. The work on a batch is then a few tight loops
+    over whole columns, which the compiler can turn into SIMD instructions,
+    rather than one call per record.
+*/
+
+#define BATCH_BITMAP_WORDS (BATCH_SIZE / 64)
+
+class Batch {
+ public:
+  Batch(std::vector<OperatorAttr> &attrs);
+  ~Batch();
+
+  int getNumAttrs();
+  int getAttrType(int attrOffset);
+
+  // the columns (numRows values each)
+  double *numbers(int attrOffset);
+  char (*strings(int attrOffset))[ATTR_SIZE];
+  unsigned char **columns();
+
+  int numRows;
+  int numSelected;
+  uint16_t selection[BATCH_SIZE];  // the selected rows, in ascending order
+
+  // empty the batch
+  void clear();
+
+  // select all the numRows rows
+  void selectAll();
+
+  // row `row` as a record, and back
+  void getRow(int row, Attribute *record);
+  void setRow(int row, Attribute *record);
+
+ private:
+  std::vector<int> attrTypes;
+  std::vector<unsigned char *> data;
+};
+
+/*
+    A batch operator produces its records with nextBatch(). It is also an
+    Operator: next() hands out the selected rows of its batches one at a time,
+    so a batch plan can be run by Executor::materialize() like any other.
+*/
+class BatchOperator : public Operator {
+ public:
+  ~BatchOperator();
+
+  // fill `batch` (which has the attributes of the operator) with the next
+  // records; E_NOTFOUND at the end. A batch may come back with no row
+  // selected, if a filter rejected all of them.
+  virtual int nextBatch(Batch *batch) = 0;
+
+  int next(Attribute *record);
+
+ protected:
+  // forget the rows next() has not handed out yet (called by open())
+  void resetRows();
+
+ private:
+  Batch *rows = nullptr;
+  int rowPosition = 0;
+};
+
+#endif  // NITCBASE_BATCH_H
@@ -0,0 +1,444 @@
+#include "BatchOperators.h"
+
+#include <cstring>
+
+#include "../Algebra/Join.h"
+#include "../BlockAccess/PredicateKernels.h"
+
+// the names and types of the attributes of an operator, for Predicate::resolve()
+static void copyAttrs(Operator *child, std::vector<OperatorAttr> &attrs, char attrNames[][ATTR_SIZE], int attrTypes[])
+{
+	for (int attrOffset = 0; attrOffset < child->getNumAttrs(); attrOffset++)
+	{
+		OperatorAttr *attr = child->getAttr(attrOffset);
+		strcpy(attrNames[attrOffset], attr->attrName);
+		attrTypes[attrOffset] = attr->attrType;
+		attrs.push_back(*attr);
+	}
+}
+
+BatchFilterOperator::BatchFilterOperator(BatchOperator *child, PredicateNode *condition)
+{
+	this->child = child;
+	this->condition = condition;
+
+	int numAttrs = child->getNumAttrs();
+	char attrNames[numAttrs][ATTR_SIZE];
+	int attrTypes[numAttrs];
+	copyAttrs(child, attrs, attrNames, attrTypes);
+
+	status = child->getStatus();
+	if (status == SUCCESS) status = Predicate::resolve(numAttrs, attrNames, attrTypes, condition);
+}
+
+BatchFilterOperator::~BatchFilterOperator()
+{
+	delete child;
+}
+
+int BatchFilterOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	resetRows();
+	return child->open();
+}
+
+// sets bit `row` of `bitmap` for every row of the batch that satisfies the tree
+static void filterColumns(PredicateNode *node, Batch *batch, uint64_t bitmap[BATCH_BITMAP_WORDS])
+{
+	if (node->type == PRED_COMPARE)
+	{
+		for (int word = 0; word < BATCH_BITMAP_WORDS; word++) bitmap[word] = 0;
+
+		if (node->attrType == NUMBER)
+			PredicateKernels::filterNumbers(batch->numbers(node->attrOffset), batch->numRows, node->attrVal.nVal,
+											node->op, bitmap);
+		else
+			PredicateKernels::filterStrings(batch->strings(node->attrOffset), batch->numRows, node->attrVal.sVal,
+											node->op, bitmap);
+		return;
+	}
+
+	uint64_t rightBitmap[BATCH_BITMAP_WORDS];
+	filterColumns(node->left, batch, bitmap);
+	filterColumns(node->right, batch, rightBitmap);
+
+	for (int word = 0; word < BATCH_BITMAP_WORDS; word++)
+		bitmap[word] = node->type == PRED_AND ? bitmap[word] & rightBitmap[word] : bitmap[word] | rightBitmap[word];
+}
+
+int BatchFilterOperator::nextBatch(Batch *batch)
+{
+	int ret = child->nextBatch(batch);
+	if (ret != SUCCESS) return ret;
+
+	// (every row is compared, selected or not: a dense loop is cheaper than
+	// following the selection vector)
+	uint64_t bitmap[BATCH_BITMAP_WORDS];
+	filterColumns(condition, batch, bitmap);
+
+	// keep the selected rows whose bit is set, without a branch per row
+	int numSelected = 0;
+	for (int index = 0; index < batch->numSelected; index++)
+	{
+		int row = batch->selection[index];
+		batch->selection[numSelected] = row;
+		numSelected += (bitmap[row / 64] >> (row % 64)) & 1;
+	}
+	batch->numSelected = numSelected;
+
+	return SUCCESS;
+}
+
+void BatchFilterOperator::close()
+{
+	child->close();
+}
+
+BatchProjectOperator::BatchProjectOperator(BatchOperator *child, int numAttrs, char attrNames[][ATTR_SIZE])
+{
+	this->child = child;
+	input = nullptr;
+
+	status = child->getStatus();
+
+	for (int attrIndex = 0; attrIndex < numAttrs; attrIndex++)
+	{
+		int attrOffset = child->getAttrOffset(attrNames[attrIndex]);
+		if (attrOffset < 0)
+		{
+			if (status == SUCCESS) status = E_ATTRNOTEXIST;
+			continue;
+		}
+
+		srcOffsets.push_back(attrOffset);
+		attrs.push_back(*child->getAttr(attrOffset));
+	}
+}
+
+BatchProjectOperator::~BatchProjectOperator()
+{
+	delete input;
+	delete child;
+}
+
+int BatchProjectOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	if (input == nullptr)
+	{
+		std::vector<OperatorAttr> childAttrs;
+		for (int attrOffset = 0; attrOffset < child->getNumAttrs(); attrOffset++)
+			childAttrs.push_back(*child->getAttr(attrOffset));
+
+		input = new Batch(childAttrs);
+	}
+
+	resetRows();
+	return child->open();
+}
+
+int BatchProjectOperator::nextBatch(Batch *batch)
+{
+	int ret = child->nextBatch(input);
+	if (ret != SUCCESS) return ret;
+
+	int numSelected = input->numSelected;
+	uint16_t *selection = input->selection;
+
+	for (int attrIndex = 0; attrIndex < (int)srcOffsets.size(); attrIndex++)
+	{
+		int srcOffset = srcOffsets[attrIndex];
+
+		if (attrs[attrIndex].attrType == NUMBER)
+		{
+			double *src = input->numbers(srcOffset), *dst = batch->numbers(attrIndex);
+			for (int index = 0; index < numSelected; index++) dst[index] = src[selection[index]];
+		}
+		else
+		{
+			char (*src)[ATTR_SIZE] = input->strings(srcOffset), (*dst)[ATTR_SIZE] = batch->strings(attrIndex);
+			for (int index = 0; index < numSelected; index++) memcpy(dst[index], src[selection[index]], ATTR_SIZE);
+		}
+	}
+
+	batch->numRows = numSelected;
+	batch->selectAll();
+
+	return SUCCESS;
+}
+
+void BatchProjectOperator::close()
+{
+	child->close();
+}
+
+// the hash of the attribute at attrOffset of every row of the batch
+static void hashColumn(Batch *batch, int attrOffset, uint32_t hashes[BATCH_SIZE])
+{
+	if (batch->getAttrType(attrOffset) == NUMBER)
+	{
+		double *keys = batch->numbers(attrOffset);
+		for (int row = 0; row < batch->numRows; row++)
+		{
+			// (0.0 and -0.0 are equal, so they must hash the same)
+			double key = keys[row] == 0 ? 0 : keys[row];
+
+			uint64_t bits;
+			memcpy(&bits, &key, sizeof(double));
+			hashes[row] = (uint32_t)((bits * 0x9e3779b97f4a7c15ull) >> 32);
+		}
+		return;
+	}
+
+	char (*keys)[ATTR_SIZE] = batch->strings(attrOffset);
+	for (int row = 0; row < batch->numRows; row++)
+	{
+		Attribute key;
+		memcpy(key.sVal, keys[row], ATTR_SIZE);
+		hashes[row] = Join::hashAttr(key, STRING);
+	}
+}
+
+BatchHashJoinOperator::BatchHashJoinOperator(BatchOperator *left, BatchOperator *right, char attrOne[ATTR_SIZE],
+											 char attrTwo[ATTR_SIZE])
+{
+	this->left = left;
+	this->right = right;
+	numLeftAttrs = left->getNumAttrs();
+	numRightAttrs = right->getNumAttrs();
+
+	leftBatch = rightBatch = nullptr;
+	leftOpen = rightOpen = false;
+
+	for (int attrOffset = 0; attrOffset < numLeftAttrs; attrOffset++)
+		attrs.push_back(*left->getAttr(attrOffset));
+	for (int attrOffset = 0; attrOffset < numRightAttrs; attrOffset++)
+		attrs.push_back(*right->getAttr(attrOffset));
+
+	status = left->getStatus();
+	if (status == SUCCESS) status = right->getStatus();
+
+	leftOffset = left->getAttrOffset(attrOne);
+	rightOffset = right->getAttrOffset(attrTwo);
+
+	if (status == SUCCESS && (leftOffset < 0 || rightOffset < 0))
+		status = E_ATTRNOTEXIST;
+	else if (status == SUCCESS && left->getAttr(leftOffset)->attrType != right->getAttr(rightOffset)->attrType)
+		status = E_ATTRTYPEMISMATCH;
+
+	attrType = status == SUCCESS ? left->getAttr(leftOffset)->attrType : NUMBER;
+}
+
+BatchHashJoinOperator::~BatchHashJoinOperator()
+{
+	close();
+	delete left;
+	delete right;
+}
+
+int BatchHashJoinOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+	resetRows();
+
+	std::vector<OperatorAttr> leftAttrs(attrs.begin(), attrs.begin() + numLeftAttrs);
+	std::vector<OperatorAttr> rightAttrs(attrs.begin() + numLeftAttrs, attrs.end());
+	leftBatch = new Batch(leftAttrs);
+	rightBatch = new Batch(rightAttrs);
+
+	rightDone = probing = false;
+	rightPosition = 0;
+
+	int ret = right->open();
+	rightOpen = ret == SUCCESS;
+
+	return ret;
+}
+
+int BatchHashJoinOperator::getChunkRecords(int numAttrs)
+{
+	return (OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE) / (numAttrs * ATTR_SIZE + 2 * sizeof(int));
+}
+
+// puts the next records of the right child in the hash table, as many as fit
+// in OPERATOR_MEMORY_BLOCKS; E_NOTFOUND once the right child has none left
+int BatchHashJoinOperator::fillChunk()
+{
+	int capacity = getChunkRecords(numRightAttrs);
+
+	buildColumns.assign(numRightAttrs, std::vector<Attribute>());
+	buildHashes.clear();
+
+	while ((int)buildHashes.size() < capacity)
+	{
+		if (rightPosition >= rightBatch->numSelected)
+		{
+			if (rightDone) break;
+
+			int ret = right->nextBatch(rightBatch);
+			if (ret == E_NOTFOUND)
+			{
+				rightDone = true;
+				break;
+			}
+			if (ret != SUCCESS) return ret;
+
+			hashColumn(rightBatch, rightOffset, rightHashes);
+			rightPosition = 0;
+			continue;
+		}
+
+		int row = rightBatch->selection[rightPosition++];
+
+		Attribute record[numRightAttrs];
+		rightBatch->getRow(row, record);
+
+		for (int attrOffset = 0; attrOffset < numRightAttrs; attrOffset++)
+			buildColumns[attrOffset].push_back(record[attrOffset]);
+		buildHashes.push_back(rightHashes[row]);
+	}
+
+	int numRecords = buildHashes.size();
+	if (numRecords == 0) return E_NOTFOUND;
+
+	// chain the records of every bucket in the order they were read
+	int numBuckets = 1;
+	while (numBuckets < numRecords) numBuckets *= 2;
+
+	buckets.assign(numBuckets, -1);
+	buildNext.assign(numRecords, -1);
+
+	for (int record = numRecords - 1; record >= 0; record--)
+	{
+		int bucket = buildHashes[record] & (numBuckets - 1);
+		buildNext[record] = buckets[bucket];
+		buckets[bucket] = record;
+	}
+
+	return SUCCESS;
+}
+
+int BatchHashJoinOperator::nextBatch(Batch *batch)
+{
+	// the (left row, right record) pairs that go into this batch
+	uint16_t matchLeft[BATCH_SIZE];
+	int matchRight[BATCH_SIZE];
+	int numMatches = 0;
+
+	while (numMatches < BATCH_SIZE)
+	{
+		// hash the next chunk of the right child, and start reading the left
+		// child through again
+		if (!probing)
+		{
+			int ret = fillChunk();
+			if (ret == E_NOTFOUND) break;
+			if (ret != SUCCESS) return ret;
+
+			ret = left->open();
+			if (ret != SUCCESS) return ret;
+
+			leftOpen = probing = true;
+			leftBatch->clear();
+			probePosition = 0;
+		}
+
+		if (probePosition >= leftBatch->numSelected)
+		{
+			// (the pairs refer to the rows of leftBatch, so they are gathered
+			// before the batch is overwritten)
+			if (numMatches > 0) break;
+
+			int ret = left->nextBatch(leftBatch);
+			if (ret == E_NOTFOUND)
+			{
+				left->close();
+				leftOpen = probing = false;
+				continue;
+			}
+			if (ret != SUCCESS) return ret;
+
+			hashColumn(leftBatch, leftOffset, leftHashes);
+			probePosition = 0, chain = -2;
+			continue;
+		}
+
+		int row = leftBatch->selection[probePosition];
+		uint32_t hash = leftHashes[row];
+
+		Attribute key;
+		if (attrType == NUMBER)
+			key.nVal = leftBatch->numbers(leftOffset)[row];
+		else
+			memcpy(key.sVal, leftBatch->strings(leftOffset)[row], ATTR_SIZE);
+
+		if (chain == -2) chain = buckets[hash & (buckets.size() - 1)];
+
+		for (; chain != -1 && numMatches < BATCH_SIZE; chain = buildNext[chain])
+		{
+			if (buildHashes[chain] != hash || compareAttrs(buildColumns[rightOffset][chain], key, attrType) != 0)
+				continue;
+
+			matchLeft[numMatches] = row, matchRight[numMatches] = chain;
+			numMatches++;
+		}
+
+		if (chain == -1) probePosition++, chain = -2;
+	}
+
+	if (numMatches == 0) return E_NOTFOUND;
+
+	// gather every output column from the pairs
+	for (int attrOffset = 0; attrOffset < numLeftAttrs; attrOffset++)
+	{
+		if (attrs[attrOffset].attrType == NUMBER)
+		{
+			double *src = leftBatch->numbers(attrOffset), *dst = batch->numbers(attrOffset);
+			for (int index = 0; index < numMatches; index++) dst[index] = src[matchLeft[index]];
+		}
+		else
+		{
+			char (*src)[ATTR_SIZE] = leftBatch->strings(attrOffset), (*dst)[ATTR_SIZE] = batch->strings(attrOffset);
+			for (int index = 0; index < numMatches; index++) memcpy(dst[index], src[matchLeft[index]], ATTR_SIZE);
+		}
+	}
+
+	for (int attrOffset = 0; attrOffset < numRightAttrs; attrOffset++)
+	{
+		Attribute *src = buildColumns[attrOffset].data();
+
+		if (attrs[numLeftAttrs + attrOffset].attrType == NUMBER)
+		{
+			double *dst = batch->numbers(numLeftAttrs + attrOffset);
+			for (int index = 0; index < numMatches; index++) dst[index] = src[matchRight[index]].nVal;
+		}
+		else
+		{
+			char (*dst)[ATTR_SIZE] = batch->strings(numLeftAttrs + attrOffset);
+			for (int index = 0; index < numMatches; index++) memcpy(dst[index], src[matchRight[index]].sVal, ATTR_SIZE);
+		}
+	}
+
+	batch->numRows = numMatches;
+	batch->selectAll();
+
+	return SUCCESS;
+}
+
+void BatchHashJoinOperator::close()
+{
+	if (leftOpen) left->close();
+	if (rightOpen) right->close();
+	leftOpen = rightOpen = probing = false;
+
+	delete leftBatch;
+	delete rightBatch;
+	leftBatch = rightBatch = nullptr;
+
+	buildColumns.clear(), buildHashes.clear(), buildNext.clear(), buckets.clear();
+}
@@ -0,0 +1,97 @@
+#ifndef NITCBASE_BATCHOPERATORS_H
+#define NITCBASE_BATCHOPERATORS_H
+
+#include "../BlockAccess/Predicate.h"
+#include "Batch.h"
+
+/*
+    Operators of the vectorized engine that work on the batches of their
+    children (the batch scan is BatchScanOperator, next to the other scans).
+*/
+
+// the rows of the child's batches that satisfy a condition on its attributes:
+// every comparison is run over a whole column by PredicateKernels, AND/OR
+// combine the resulting bitmaps a word at a time, and the selection vector
+// keeps the rows whose bit is set
+class BatchFilterOperator : public BatchOperator {
+ public:
+  // (the tree is resolved against the attributes of the child here; it is
+  // not copied, and must live as long as the operator)
+  BatchFilterOperator(BatchOperator *child, PredicateNode *condition);
+  ~BatchFilterOperator();
+
+  int open();
+  int nextBatch(Batch *batch);
+  void close();
+
+ private:
+  BatchOperator *child;
+  PredicateNode *condition;
+};
+
+// the selected rows of the child's batches, with only the attributes asked
+// for: each output column is gathered from the selected rows of a column of
+// the child, so the batches it hands out have every row selected
+class BatchProjectOperator : public BatchOperator {
+ public:
+  BatchProjectOperator(BatchOperator *child, int numAttrs, char attrNames[][ATTR_SIZE]);
+  ~BatchProjectOperator();
+
+  int open();
+  int nextBatch(Batch *batch);
+  void close();
+
+ private:
+  BatchOperator *child;
+  std::vector<int> srcOffsets;
+  Batch *input;
+};
+
+/*
+    The join of the records of two batch operators on
+    `left.attrOne = right.attrTwo`. A record of the join is a record of the
+    left child followed by one of the right child.
+
+    The records of the right child are put in a hash table, as many as fit in
+    OPERATOR_MEMORY_BLOCKS at a time; the left child is then read through once
+    per such chunk, and probed a batch at a time: the join attribute of the
+    whole batch is hashed in one loop, the (left row, right record) pairs that
+    match are collected, and every output column is gathered from them in one
+    more loop.
+*/
+class BatchHashJoinOperator : public BatchOperator {
+ public:
+  BatchHashJoinOperator(BatchOperator *left, BatchOperator *right, char attrOne[ATTR_SIZE], char attrTwo[ATTR_SIZE]);
+  ~BatchHashJoinOperator();
+
+  int open();
+  int nextBatch(Batch *batch);
+  void close();
+
+  // how many records of a right child with numAttrs attributes go into the
+  // hash table at a time
+  static int getChunkRecords(int numAttrs);
+
+ private:
+  BatchOperator *left;
+  BatchOperator *right;
+  int leftOffset, rightOffset, attrType;
+  int numLeftAttrs, numRightAttrs;
+
+  // the chunk of the right child in the hash table, a column per attribute
+  std::vector<std::vector<Attribute>> buildColumns;
+  std::vector<uint32_t> buildHashes;
+  std::vector<int> buildNext;
+  std::vector<int> buckets;
+
+  Batch *leftBatch, *rightBatch;
+  uint32_t leftHashes[BATCH_SIZE], rightHashes[BATCH_SIZE];
+  bool leftOpen, rightOpen, rightDone, probing;
+  int rightPosition;  // next selected row of rightBatch to put in the table
+  int probePosition;  // selected row of leftBatch being probed
+  int chain;          // next record of its chain to look at (-2: not looked up yet)
+
+  int fillChunk();
+};
+
+#endif  // NITCBASE_BATCHOPERATORS_H
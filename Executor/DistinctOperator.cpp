@@ -0,0 +1,169 @@
+#include "DistinctOperator.h"
+
+#include <cstring>
+
+DistinctOperator::DistinctOperator(Operator *child)
+{
+	this->child = child;
+	numAttrs = child->getNumAttrs();
+	childOpen = readingBack = false;
+
+	status = child->getStatus();
+
+	int attrTypes[numAttrs];
+	for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+	{
+		attrs.push_back(*child->getAttr(attrOffset));
+		attrTypes[attrOffset] = attrs[attrOffset].attrType;
+	}
+
+	records = new HashTable(numAttrs, attrTypes, numAttrs, getMaxRecords(numAttrs));
+}
+
+DistinctOperator::~DistinctOperator()
+{
+	close();
+	delete records;
+	delete child;
+}
+
+int DistinctOperator::getMaxRecords(int numAttrs)
+{
+	return HashTable::getMaxKeys(numAttrs, 0);
+}
+
+/*
+	Adds the record to the table, unless it is there already (isNew is set
+	to whether it was added); if there is no room for it, it is spilled to its
+	partition instead.
+*/
+int DistinctOperator::admit(Attribute *record, bool *isNew)
+{
+	uint32_t hash = records->hash(record);
+	*isNew = false;
+
+	if (records->find(record, hash) != -1) return SUCCESS;
+
+	if (!records->hasRoom()) return records->spill(record, hash);
+
+	records->add(record, hash);
+	*isNew = true;
+	return SUCCESS;
+}
+
+int DistinctOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+
+	int ret = child->open();
+	childOpen = ret == SUCCESS;
+
+	return ret;
+}
+
+int DistinctOperator::next(Attribute *record)
+{
+	bool isNew;
+
+	// while the child is read, a record not in the table is handed out and
+	// added, as long as there is room for it
+	while (!readingBack)
+	{
+		int ret = child->next(record);
+		if (ret == E_NOTFOUND)
+		{
+			child->close();
+			childOpen = false;
+			readingBack = true;
+			break;
+		}
+		if (ret != SUCCESS) return ret;
+
+		ret = admit(record, &isNew);
+		if (ret != SUCCESS) return ret;
+		if (isNew) return SUCCESS;
+	}
+
+	// then the same for the records of each partition, read back into the
+	// emptied table
+	while (true)
+	{
+		int ret = records->nextSpilled(record);
+		if (ret == E_NOTFOUND)
+		{
+			ret = records->nextPartition();
+			if (ret != SUCCESS) return ret;
+			continue;
+		}
+		if (ret != SUCCESS) return ret;
+
+		ret = admit(record, &isNew);
+		if (ret != SUCCESS) return ret;
+		if (isNew) return SUCCESS;
+	}
+}
+
+void DistinctOperator::close()
+{
+	if (childOpen) child->close();
+	childOpen = readingBack = false;
+
+	records->clear();
+}
+
+SortDistinctOperator::SortDistinctOperator(Operator *child)
+{
+	this->child = child;
+	hasLast = false;
+
+	status = child->getStatus();
+
+	for (int attrOffset = 0; attrOffset < child->getNumAttrs(); attrOffset++)
+		attrs.push_back(*child->getAttr(attrOffset));
+
+	last.resize(attrs.size());
+}
+
+SortDistinctOperator::~SortDistinctOperator()
+{
+	delete child;
+}
+
+bool SortDistinctOperator::equalsLast(Attribute *record)
+{
+	for (int attrOffset = 0; attrOffset < (int)attrs.size(); attrOffset++)
+		if (compareAttrs(last[attrOffset], record[attrOffset], attrs[attrOffset].attrType) != 0) return false;
+
+	return true;
+}
+
+int SortDistinctOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	hasLast = false;
+	return child->open();
+}
+
+int SortDistinctOperator::next(Attribute *record)
+{
+	int ret;
+	while ((ret = child->next(record)) == SUCCESS)
+	{
+		if (hasLast && equalsLast(record)) continue;
+
+		std::copy(record, record + attrs.size(), last.begin());
+		hasLast = true;
+		return SUCCESS;
+	}
+
+	return ret;
+}
+
+void SortDistinctOperator::close()
+{
+	child->close();
+	hasLast = false;
+}
@@ -0,0 +1,68 @@
+#ifndef NITCBASE_DISTINCTOPERATOR_H
+#define NITCBASE_DISTINCTOPERATOR_H
+
+#include "HashTable.h"
+#include "Operator.h"
+
+/*
+    The records of the child with the duplicates left out (two records are
+    duplicates if they agree on every attribute), each handed out the first
+    time it is read.
+
+    The records seen so far are kept in a HashTable, which holds at most as
+    many as fit in OPERATOR_MEMORY_BLOCKS (getMaxRecords()). Once it is full,
+    a record that is not in it is spilled to its partitions, so that all the
+    copies of a record land in the same partition; when the child is done,
+    each partition is read back into the emptied table in turn (and spilled
+    again, split further, if its records still do not fit), the way
+    AggregateOperator spills its groups.
+*/
+class DistinctOperator : public Operator {
+ public:
+  DistinctOperator(Operator *child);
+  ~DistinctOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+  // the number of records with numAttrs attributes the hash table holds
+  static int getMaxRecords(int numAttrs);
+
+ private:
+  Operator *child;
+  int numAttrs;
+
+  // the records in memory (and those that did not fit)
+  HashTable *records;
+  bool childOpen;
+  bool readingBack;  // (the child is done, and the partitions are read back)
+
+  int admit(Attribute *record, bool *isNew);
+};
+
+/*
+    The same, over a child that produces its records in order (e.g. the
+    values of an attribute read off the leaves of its B+ tree by an
+    IndexOnlyScanOperator): the copies of a record come one after the
+    other, so only the last record handed out is kept, and the runs of
+    records equal to it are skipped.
+*/
+class SortDistinctOperator : public Operator {
+ public:
+  SortDistinctOperator(Operator *child);
+  ~SortDistinctOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  std::vector<Attribute> last;
+  bool hasLast;
+
+  bool equalsLast(Attribute *record);
+};
+
+#endif  // NITCBASE_DISTINCTOPERATOR_H
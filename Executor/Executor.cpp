@@ -0,0 +1,54 @@
+#include "Executor.h"
+
+#include <cstring>
+
+#include "../BlockAccess/BlockAccess.h"
+#include "../Cache/OpenRelTable.h"
+#include "../Schema/Schema.h"
+
+int Executor::materialize(Operator *plan, char targetRel[ATTR_SIZE])
+{
+	// (errors found while building the plan are reported before anything is created)
+	int ret = plan->getStatus();
+	if (ret != SUCCESS) return ret;
+
+	int numAttrs = plan->getNumAttrs();
+
+	char attrNames[numAttrs][ATTR_SIZE];
+	int attrTypes[numAttrs];
+
+	for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+	{
+		strcpy(attrNames[attrOffset], plan->getAttr(attrOffset)->attrName);
+		attrTypes[attrOffset] = plan->getAttr(attrOffset)->attrType;
+	}
+
+	ret = Schema::createRel(targetRel, numAttrs, attrNames, attrTypes);
+	if (ret != SUCCESS) return ret;
+
+	int targetRelId = OpenRelTable::openRel(targetRel);
+	if (targetRelId < 0 || targetRelId >= MAX_OPEN)
+	{
+		Schema::deleteRel(targetRel);
+		return targetRelId;
+	}
+
+	Attribute record[numAttrs];
+
+	ret = plan->open();
+	while (ret == SUCCESS && (ret = plan->next(record)) == SUCCESS)
+		ret = BlockAccess::insert(targetRelId, record);
+
+	plan->close();
+
+	// (running out of records is how the plan ends)
+	if (ret != E_NOTFOUND)
+	{
+		Schema::closeRel(targetRel);
+		Schema::deleteRel(targetRel);
+		return ret;
+	}
+
+	Schema::closeRel(targetRel);
+	return SUCCESS;
+}
@@ -0,0 +1,31 @@
+#ifndef NITCBASE_EXECUTOR_H
+#define NITCBASE_EXECUTOR_H
+
+#include "AggregateOperator.h"
+#include "BatchOperators.h"
+#include "DistinctOperator.h"
+#include "Operator.h"
+#include "ScanOperator.h"
+#include "SemiJoinOperator.h"
+#include "SetOperator.h"
+#include "SortOperator.h"
+#include "TupleOperators.h"
+
+/*
+    Runs a plan (a tree of Operators) to the end. A plan is built bottom up
+    from the relations it reads, e.g. for
+        SELECT name FROM S WHERE marks > 50 INTO T
+    it is
+        ProjectOperator(ScanOperator(S, `marks > 50`), {name})
+    and Executor::materialize() then pulls its records into T. The batch
+    operators of the vectorized engine (Batch.h) plug into the same plans.
+*/
+class Executor {
+ public:
+  // creates targetRel with the attributes of the plan and inserts every
+  // record the plan produces into it; if the plan fails part way, targetRel
+  // is deleted and the error is returned
+  static int materialize(Operator *plan, char targetRel[ATTR_SIZE]);
+};
+
+#endif  // NITCBASE_EXECUTOR_H
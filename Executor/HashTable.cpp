@@ -0,0 +1,169 @@
+#include "HashTable.h"
+
+#include "../Algebra/Join.h"
+
+// (past this, hash / divisor is 0 for every hash, and there is nothing left to split on)
+static const uint64_t MAX_DIVISOR = (uint64_t)1 << 32;
+
+HashTable::HashTable(int numKeyAttrs, int keyTypes[], int numRecordAttrs, int maxKeys)
+{
+	this->numKeyAttrs = numKeyAttrs;
+	this->keyTypes.assign(keyTypes, keyTypes + numKeyAttrs);
+	this->numRecordAttrs = numRecordAttrs;
+	this->maxKeys = maxKeys;
+	divisor = 1;
+	partition = -1;
+
+	buckets.assign(64, -1);
+}
+
+int HashTable::getMaxKeys(int numKeyAttrs, int entrySize)
+{
+	// (a key takes its values, hash, chain and bucket)
+	int keySize = numKeyAttrs * sizeof(Attribute) + sizeof(uint32_t) + 2 * sizeof(int) + entrySize;
+	return (OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE) / keySize;
+}
+
+uint32_t HashTable::hash(Attribute *key)
+{
+	uint32_t hash = 0;
+	for (int attrOffset = 0; attrOffset < numKeyAttrs; attrOffset++)
+		hash = hash * 16777619u ^ Join::hashAttr(key[attrOffset], keyTypes[attrOffset]);
+
+	return hash;
+}
+
+int HashTable::find(Attribute *key, uint32_t hash)
+{
+	for (int stored = buckets[(hash / divisor) % buckets.size()]; stored != -1; stored = chainNext[stored])
+	{
+		if (hashes[stored] != hash) continue;
+
+		int attrOffset = 0;
+		while (attrOffset < numKeyAttrs &&
+			   compareAttrs(keys[stored * numKeyAttrs + attrOffset], key[attrOffset], keyTypes[attrOffset]) == 0)
+			attrOffset++;
+
+		if (attrOffset == numKeyAttrs) return stored;
+	}
+
+	return -1;
+}
+
+bool HashTable::hasRoom()
+{
+	return (int)hashes.size() < maxKeys || divisor * OPERATOR_MEMORY_BLOCKS > MAX_DIVISOR;
+}
+
+int HashTable::add(Attribute *key, uint32_t hash)
+{
+	int stored = hashes.size();
+	keys.insert(keys.end(), key, key + numKeyAttrs);
+	hashes.push_back(hash);
+	chainNext.push_back(-1);
+
+	// keep the chains short by doubling the buckets as the table grows
+	if (hashes.size() > buckets.size())
+	{
+		buckets.assign(buckets.size() * 2, -1);
+		for (int chained = 0; chained < (int)hashes.size(); chained++)
+		{
+			int bucket = (hashes[chained] / divisor) % buckets.size();
+			chainNext[chained] = buckets[bucket];
+			buckets[bucket] = chained;
+		}
+	}
+	else
+	{
+		int bucket = (hash / divisor) % buckets.size();
+		chainNext[stored] = buckets[bucket];
+		buckets[bucket] = stored;
+	}
+
+	return stored;
+}
+
+int HashTable::getNumKeys()
+{
+	return hashes.size();
+}
+
+Attribute *HashTable::getKey(int position)
+{
+	return keys.data() + position * numKeyAttrs;
+}
+
+int HashTable::spill(Attribute *record, uint32_t hash)
+{
+	if (spilled.empty())
+		spilled.assign(OPERATOR_MEMORY_BLOCKS, SpillFile(numRecordAttrs));
+
+	return spilled[(hash / divisor) % spilled.size()].append(record);
+}
+
+int HashTable::nextPartition()
+{
+	if (partition != -1) partitions[partition].release();
+
+	// the records spilled from the partition just done are read back next,
+	// before the partitions that were already waiting
+	int position = partition + 1;
+	for (SpillFile &file : spilled)
+	{
+		partitions.insert(partitions.begin() + position, file);
+		divisors.insert(divisors.begin() + position, divisor * OPERATOR_MEMORY_BLOCKS);
+		position++;
+	}
+	spilled.clear();
+
+	// (the partitions that turn out to hold no record are skipped)
+	partition++;
+	while (partition < (int)partitions.size() && partitions[partition].getNumRecords() == 0)
+		partitions[partition++].release();
+
+	clearKeys();
+
+	if (partition >= (int)partitions.size())
+	{
+		partitions.clear();
+		divisors.clear();
+		partition = -1;
+		divisor = 1;
+		return E_NOTFOUND;
+	}
+
+	divisor = divisors[partition];
+	return SUCCESS;
+}
+
+int HashTable::nextSpilled(Attribute *record)
+{
+	if (partition == -1) return E_NOTFOUND;
+
+	return partitions[partition].next(record);
+}
+
+void HashTable::clearKeys()
+{
+	keys.clear();
+	hashes.clear();
+	chainNext.clear();
+	buckets.assign(64, -1);
+}
+
+void HashTable::clear()
+{
+	clearKeys();
+
+	for (SpillFile &file : spilled)
+		file.release();
+	spilled.clear();
+
+	// (the partitions before `partition` have been released already)
+	for (int waiting = partition == -1 ? 0 : partition; waiting < (int)partitions.size(); waiting++)
+		partitions[waiting].release();
+	partitions.clear();
+	divisors.clear();
+	partition = -1;
+	divisor = 1;
+}
@@ -0,0 +1,90 @@
+#ifndef NITCBASE_HASHTABLE_H
+#define NITCBASE_HASHTABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../BlockAccess/SpillFile.h"
+#include "../define/constants.h"
+
+/*
+    The in-memory hash table of the operators that look records up by value
+    (AggregateOperator, DistinctOperator, HashSetOperator, SemiJoinOperator).
+    It holds keys of numKeyAttrs attributes each, chained in buckets that are
+    doubled as the table grows; an operator keeps whatever else it needs per
+    key (e.g. the states of its aggregates) by the position of the key.
+
+    An operator may also hold the table to a budget of getMaxKeys() keys: once
+    hasRoom() says it is full, the records whose keys are not in it are
+    written by spill() to one of OPERATOR_MEMORY_BLOCKS partitions (SpillFiles)
+    on their hash, so that all the records with the same key land in the same
+    partition. When the operator is done with the keys in memory,
+    nextPartition() empties the table and moves on to the next partition,
+    whose records it reads back with nextSpilled() and looks up again the
+    same way. The keys of a partition that still do not fit are spilled in
+    turn, into partitions split on the next bits of the hash, which are read
+    back right after it; a table with no bits of the hash left to split on
+    just grows past its budget.
+*/
+class HashTable {
+ public:
+  HashTable(int numKeyAttrs, int keyTypes[], int numRecordAttrs, int maxKeys);
+
+  // the number of keys of numKeyAttrs attributes that fit in
+  // OPERATOR_MEMORY_BLOCKS, with entrySize more bytes per key for the operator
+  static int getMaxKeys(int numKeyAttrs, int entrySize);
+
+  uint32_t hash(Attribute *key);
+
+  // the position of `key` in the table; -1 if it is not there
+  int find(Attribute *key, uint32_t hash);
+
+  // whether a key that is not in the table may be added to it
+  bool hasRoom();
+
+  // add `key`, which is not in the table, and return its position
+  int add(Attribute *key, uint32_t hash);
+
+  int getNumKeys();
+  Attribute *getKey(int position);
+
+  // write `record` (of numRecordAttrs attributes), whose key is not in the
+  // table and has no room, to its partition; E_DISKFULL if no block is free
+  int spill(Attribute *record, uint32_t hash);
+
+  // empty the table and move on to the next partition; E_NOTFOUND if none is left
+  int nextPartition();
+
+  // copy the next record of the partition into `record`; E_NOTFOUND at its end
+  int nextSpilled(Attribute *record);
+
+  // empty the table and release every partition
+  void clear();
+
+ private:
+  int numKeyAttrs;
+  std::vector<int> keyTypes;
+  int numRecordAttrs;
+  int maxKeys;
+
+  std::vector<Attribute> keys;  // numKeyAttrs values per key
+  std::vector<uint32_t> hashes;
+  std::vector<int> chainNext;
+  std::vector<int> buckets;
+
+  // the records in the table agree on hash % divisor (their buckets are
+  // chosen on hash / divisor), and those spilled from it are split on
+  // (hash / divisor) % OPERATOR_MEMORY_BLOCKS
+  uint64_t divisor;
+  std::vector<SpillFile> spilled;
+
+  // the partitions left to read back (and the divisor of each), and the one
+  // being read back (-1 while the table holds the records of the input)
+  std::vector<SpillFile> partitions;
+  std::vector<uint64_t> divisors;
+  int partition;
+
+  void clearKeys();
+};
+
+#endif  // NITCBASE_HASHTABLE_H
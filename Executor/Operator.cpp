@@ -0,0 +1,28 @@
+#include "Operator.h"
+
+#include <cstring>
+
+int Operator::getStatus()
+{
+	return status;
+}
+
+int Operator::getNumAttrs()
+{
+	return attrs.size();
+}
+
+OperatorAttr *Operator::getAttr(int attrOffset)
+{
+	if (attrOffset < 0 || attrOffset >= (int)attrs.size()) return nullptr;
+
+	return &attrs[attrOffset];
+}
+
+int Operator::getAttrOffset(char attrName[ATTR_SIZE])
+{
+	for (int attrOffset = 0; attrOffset < (int)attrs.size(); attrOffset++)
+		if (strcmp(attrs[attrOffset].attrName, attrName) == 0) return attrOffset;
+
+	return E_ATTRNOTEXIST;
+}
@@ -0,0 +1,58 @@
+#ifndef NITCBASE_OPERATOR_H
+#define NITCBASE_OPERATOR_H
+
+#include <vector>
+
+#include "../define/constants.h"
+#include "../define/id.h"
+#include "../Buffer/BlockBuffer.h"
+
+/*
+    The operators of a query plan, executed Volcano style: a plan is a tree
+    of operators, and every operator hands out its records one at a time, as
+    its parent asks for them, pulling records from its own children as it
+    needs them. Only the operator at the root decides where the records end
+    up (e.g. Executor::materialize() inserts them into a target relation), so
+    any plan runs as a single pipeline without intermediate relations.
+
+        * open() gets the operator (and its children) ready to produce records
+        * next() copies the next record into `record`; E_NOTFOUND at the end
+        * close() releases whatever open() and next() acquired
+
+    The attributes of the records an operator produces are known as soon as
+    it is constructed, so plans are built bottom up. An error found while
+    building an operator (an attribute that does not exist, a type mismatch)
+    is kept as its status: getStatus() reports it (or that of a child) before
+    anything is created for the plan, and open() returns it.
+
+    An operator owns its children, and deletes them when it is deleted.
+*/
+
+typedef struct OperatorAttr {
+  char attrName[ATTR_SIZE];
+  int attrType;
+} OperatorAttr;
+
+class Operator {
+ public:
+  virtual ~Operator() {}
+
+  virtual int open() = 0;
+  virtual int next(Attribute *record) = 0;
+  virtual void close() = 0;
+
+  int getStatus();
+
+  // the attributes of the records the operator produces
+  int getNumAttrs();
+  OperatorAttr *getAttr(int attrOffset);
+
+  // offset of the (first) attribute named attrName; E_ATTRNOTEXIST if none
+  int getAttrOffset(char attrName[ATTR_SIZE]);
+
+ protected:
+  int status = SUCCESS;
+  std::vector<OperatorAttr> attrs;
+};
+
+#endif  // NITCBASE_OPERATOR_H
@@ -0,0 +1,409 @@
+#include "ScanOperator.h"
+
+#include <cstring>
+
+#include "../BPlusTree/BPlusTree.h"
+
+// the attributes of a relation, in the order they are stored in its records
+static void relationAttrs(int relId, std::vector<OperatorAttr> &attrs)
+{
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+	for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+	{
+		AttrCatEntry attrCatEntry;
+		AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+
+		OperatorAttr attr;
+		strcpy(attr.attrName, attrCatEntry.attrName);
+		attr.attrType = attrCatEntry.attrType;
+		attrs.push_back(attr);
+	}
+}
+
+ScanOperator::ScanOperator(int relId, PredicateNode *condition)
+{
+	this->relId = relId;
+	this->condition = condition;
+	cursor = nullptr;
+
+	relationAttrs(relId, attrs);
+
+	if (condition != nullptr) status = Predicate::resolve(relId, condition);
+}
+
+ScanOperator::~ScanOperator()
+{
+	delete cursor;
+}
+
+int ScanOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	if (cursor == nullptr)
+	{
+		cursor = new ScanCursor(relId);
+		if (condition != nullptr) cursor->setPredicate(condition);
+	}
+
+	cursor->reset();
+	return SUCCESS;
+}
+
+int ScanOperator::next(Attribute *record)
+{
+	return cursor->next(record);
+}
+
+void ScanOperator::close()
+{
+	delete cursor;
+	cursor = nullptr;
+}
+
+IndexScanOperator::IndexScanOperator(int relId, PredicateNode *condition)
+{
+	this->relId = relId;
+	this->condition = condition;
+	position = 0;
+
+	relationAttrs(relId, attrs);
+
+	status = Predicate::resolve(relId, condition);
+	if (status == SUCCESS && !Predicate::canIndexSearch(condition)) status = E_NOINDEX;
+}
+
+int IndexScanOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	recIds.clear();
+	position = 0;
+
+	// a single comparison is searched for as next() goes (which uses the
+	// search index of the attribute in the attribute cache, so no other
+	// search on the attribute may run at the same time); anything else is
+	// answered up front
+	if (condition->type == PRED_COMPARE)
+		AttrCacheTable::resetSearchIndex(relId, condition->attrName);
+	else
+		Predicate::indexSearch(relId, condition, recIds);
+
+	return SUCCESS;
+}
+
+int IndexScanOperator::next(Attribute *record)
+{
+	while (true)
+	{
+		RecId recId;
+
+		if (condition->type == PRED_COMPARE)
+			recId = BPlusTree::bPlusSearch(relId, condition->attrName, condition->attrVal, condition->op);
+		else
+			recId = position < (int)recIds.size() ? recIds[position++] : RecId {-1, -1};
+
+		if (recId.block == -1) return E_NOTFOUND;
+
+		RecBuffer blockBuffer (recId.block);
+		blockBuffer.getRecord(record, recId.slot);
+
+		// (an AND may have been answered from the B+ tree of one side only)
+		if (Predicate::evaluate(condition, record)) return SUCCESS;
+	}
+}
+
+void IndexScanOperator::close()
+{
+	recIds.clear();
+}
+
+IndexOrderScanOperator::IndexOrderScanOperator(int relId, char attrName[ATTR_SIZE])
+{
+	this->relId = relId;
+	cursor = nullptr;
+	rootBlock = -1;
+
+	relationAttrs(relId, attrs);
+
+	AttrCatEntry attrCatEntry;
+	status = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+	if (status == SUCCESS) rootBlock = attrCatEntry.rootBlock;
+	if (status == SUCCESS && rootBlock == -1) status = E_NOINDEX;
+}
+
+IndexOrderScanOperator::~IndexOrderScanOperator()
+{
+	close();
+}
+
+int IndexOrderScanOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+	cursor = new LeafCursor(rootBlock);
+
+	return SUCCESS;
+}
+
+int IndexOrderScanOperator::next(Attribute *record)
+{
+	Index entry;
+	int ret = cursor->next(&entry);
+	if (ret != SUCCESS) return ret;
+
+	RecBuffer blockBuffer (entry.block);
+	return blockBuffer.getRecord(record, entry.slot);
+}
+
+void IndexOrderScanOperator::close()
+{
+	delete cursor;
+	cursor = nullptr;
+}
+
+// the comparisons ANDed together at the top of `node` that bound its values
+// from below and from above
+static void collectBounds(PredicateNode *node, std::vector<PredicateNode *> &lowerBounds,
+						  std::vector<PredicateNode *> &upperBounds)
+{
+	if (node == nullptr || node->type == PRED_OR) return;
+
+	if (node->type == PRED_AND)
+	{
+		collectBounds(node->left, lowerBounds, upperBounds);
+		collectBounds(node->right, lowerBounds, upperBounds);
+		return;
+	}
+
+	if (node->op == EQ || node->op == GE || node->op == GT) lowerBounds.push_back(node);
+	if (node->op == EQ || node->op == LE || node->op == LT) upperBounds.push_back(node);
+}
+
+IndexOnlyScanOperator::IndexOnlyScanOperator(int relId, char attrName[ATTR_SIZE], PredicateNode *condition)
+{
+	this->condition = condition;
+	cursor = nullptr;
+	rootBlock = -1;
+	attrOffset = 0;
+
+	AttrCatEntry attrCatEntry;
+	status = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+	if (status != SUCCESS) return;
+
+	OperatorAttr attr;
+	strcpy(attr.attrName, attrCatEntry.attrName);
+	attr.attrType = attrCatEntry.attrType;
+	attrs.push_back(attr);
+
+	rootBlock = attrCatEntry.rootBlock;
+	attrOffset = attrCatEntry.offset;
+	if (rootBlock == -1)
+	{
+		status = E_NOINDEX;
+		return;
+	}
+
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	keyRecord.resize(relCatEntry.numAttrs);
+
+	if (condition != nullptr) status = Predicate::resolve(relId, condition);
+	collectBounds(condition, lowerBounds, upperBounds);
+}
+
+IndexOnlyScanOperator::~IndexOnlyScanOperator()
+{
+	close();
+}
+
+int IndexOnlyScanOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+
+	// start from the largest lower bound (or from the leftmost leaf)
+	PredicateNode *start = nullptr;
+	for (PredicateNode *bound : lowerBounds)
+		if (start == nullptr || compareAttrs(bound->attrVal, start->attrVal, bound->attrType) > 0) start = bound;
+
+	if (start == nullptr)
+		cursor = new LeafCursor(rootBlock);
+	else
+		cursor = new LeafCursor(rootBlock, start->attrVal, start->attrType, start->op);
+
+	return SUCCESS;
+}
+
+int IndexOnlyScanOperator::next(Attribute *record)
+{
+	Index entry;
+	while (cursor->next(&entry) == SUCCESS)
+	{
+		keyRecord[attrOffset] = entry.attrVal;
+
+		// (the entries come in ascending order, so none after one that is
+		// past an upper bound is within it)
+		for (PredicateNode *bound : upperBounds)
+		{
+			int cmpVal = compareAttrs(entry.attrVal, bound->attrVal, bound->attrType);
+			if (bound->op == LT ? cmpVal >= 0 : cmpVal > 0) return E_NOTFOUND;
+		}
+
+		if (condition != nullptr && !Predicate::evaluate(condition, keyRecord.data())) continue;
+
+		record[0] = entry.attrVal;
+		return SUCCESS;
+	}
+
+	return E_NOTFOUND;
+}
+
+void IndexOnlyScanOperator::close()
+{
+	delete cursor;
+	cursor = nullptr;
+}
+
+BatchScanOperator::BatchScanOperator(int relId, PredicateNode *condition)
+{
+	this->relId = relId;
+	this->condition = condition;
+	cursor = nullptr;
+	pendingBlock = -1;
+
+	relationAttrs(relId, attrs);
+	for (int attrOffset = 0; attrOffset < (int)attrs.size(); attrOffset++)
+		attrTypes.push_back(attrs[attrOffset].attrType);
+
+	if (condition != nullptr) status = Predicate::resolve(relId, condition);
+}
+
+BatchScanOperator::~BatchScanOperator()
+{
+	delete cursor;
+}
+
+int BatchScanOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	if (cursor == nullptr)
+	{
+		cursor = new ScanCursor(relId);
+		if (condition != nullptr) cursor->setPredicate(condition);
+	}
+
+	cursor->reset();
+	pendingBlock = -1;
+	resetRows();
+
+	return SUCCESS;
+}
+
+int BatchScanOperator::nextBatch(Batch *batch)
+{
+	batch->clear();
+
+	// take whole blocks until the next one does not fit
+	// (a block has at most MAX_SLOTS_PER_BLOCK records, fewer than BATCH_SIZE)
+	while (true)
+	{
+		if (pendingBlock == -1)
+		{
+			int ret = cursor->nextSelectedBlock(&pendingBlock, pendingBitmap);
+			if (ret == E_NOTFOUND)
+			{
+				pendingBlock = -1;
+				break;
+			}
+			if (ret != SUCCESS) return ret;
+		}
+
+		int numHits = 0;
+		for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) numHits += __builtin_popcountll(pendingBitmap[word]);
+
+		if (batch->numRows + numHits > BATCH_SIZE) break;
+
+		RecBuffer blockBuffer (pendingBlock);
+
+		int numRecords;
+		int ret = blockBuffer.getColumns(pendingBitmap, attrTypes.data(), batch->columns(), batch->numRows, &numRecords);
+		if (ret != SUCCESS) return ret;
+
+		batch->numRows += numRecords;
+		pendingBlock = -1;
+	}
+
+	if (batch->numRows == 0) return E_NOTFOUND;
+
+	batch->selectAll();
+	return SUCCESS;
+}
+
+void BatchScanOperator::close()
+{
+	delete cursor;
+	cursor = nullptr;
+	pendingBlock = -1;
+}
+
+ParallelScanOperator::ParallelScanOperator(int relId, PredicateNode *condition, int numWorkers)
+{
+	this->relId = relId;
+	this->condition = condition;
+	this->numWorkers = numWorkers;
+	scan = nullptr;
+
+	relationAttrs(relId, attrs);
+
+	if (condition != nullptr) status = Predicate::resolve(relId, condition);
+}
+
+ParallelScanOperator::~ParallelScanOperator()
+{
+	delete scan;
+}
+
+int ParallelScanOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	// (the worker threads are started once, and kept until the operator is closed)
+	if (scan == nullptr) scan = new ParallelScan(relId, condition, numWorkers);
+
+	scan->reset();
+	resetRows();
+
+	return SUCCESS;
+}
+
+int ParallelScanOperator::nextBatch(Batch *batch)
+{
+	batch->clear();
+
+	Attribute record[attrs.size()];
+	while (batch->numRows < BATCH_SIZE)
+	{
+		int ret = scan->next(record);
+		if (ret == E_NOTFOUND) break;
+		if (ret != SUCCESS) return ret;
+
+		batch->setRow(batch->numRows++, record);
+	}
+
+	if (batch->numRows == 0) return E_NOTFOUND;
+
+	batch->selectAll();
+	return SUCCESS;
+}
+
+void ParallelScanOperator::close()
+{
+	delete scan;
+	scan = nullptr;
+}
@@ -0,0 +1,139 @@
+#ifndef NITCBASE_SCANOPERATOR_H
+#define NITCBASE_SCANOPERATOR_H
+
+#include "../BPlusTree/LeafCursor.h"
+#include "../BlockAccess/ParallelScan.h"
+#include "../BlockAccess/Predicate.h"
+#include "../BlockAccess/ScanCursor.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "Batch.h"
+#include "Operator.h"
+
+// every record of an open relation, or those that satisfy a condition,
+// read a block at a time with a ScanCursor (which skips the blocks whose zone
+// cannot satisfy the condition)
+class ScanOperator : public Operator {
+ public:
+  // (the condition, if any, is resolved against the relation here; the tree
+  // is not copied, and must live as long as the operator)
+  ScanOperator(int relId, PredicateNode *condition = nullptr);
+  ~ScanOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  int relId;
+  PredicateNode *condition;
+  ScanCursor *cursor;
+};
+
+// the records of an open relation that satisfy a condition, looked up in the
+// B+ trees of the attributes of the condition: a single `attr op value` is
+// read off its B+ tree as the search goes, and an AND/OR of several is
+// answered by intersecting/uniting the rec-ids found in each B+ tree (see
+// Predicate::indexSearch())
+class IndexScanOperator : public Operator {
+ public:
+  IndexScanOperator(int relId, PredicateNode *condition);
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  int relId;
+  PredicateNode *condition;
+  std::vector<RecId> recIds;
+  int position;
+};
+
+// every record of an open relation, in ascending order of an attribute with
+// a B+ tree: the leaves of the tree are walked with a LeafCursor, and each
+// record is fetched from its block as its index entry comes up
+class IndexOrderScanOperator : public Operator {
+ public:
+  // (E_NOINDEX if the attribute has no B+ tree)
+  IndexOrderScanOperator(int relId, char attrName[ATTR_SIZE]);
+  ~IndexOrderScanOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  int relId;
+  int rootBlock;
+  LeafCursor *cursor;
+};
+
+// the values of an attribute with a B+ tree (of the records that satisfy a
+// condition on that attribute alone), in ascending order, read off the leaf
+// entries without fetching a record: each record produced has the attribute
+// as its only attribute. The walk starts at the leaf where the largest lower
+// bound (`=`, `>`, `>=`) the condition ANDs in is reached, and stops at the
+// first entry past an upper bound (`=`, `<`, `<=`) it ANDs in
+class IndexOnlyScanOperator : public Operator {
+ public:
+  // (the condition, if any, is resolved against the relation here; E_NOINDEX
+  // if the attribute has no B+ tree)
+  IndexOnlyScanOperator(int relId, char attrName[ATTR_SIZE], PredicateNode *condition = nullptr);
+  ~IndexOnlyScanOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  int rootBlock;
+  int attrOffset;
+  PredicateNode *condition;
+  std::vector<PredicateNode *> lowerBounds, upperBounds;
+  std::vector<Attribute> keyRecord;  // (a record of the relation with only the attribute set)
+  LeafCursor *cursor;
+};
+
+// the records of an open relation (or those that satisfy a condition) in
+// batches: each record block the ScanCursor selects records from is copied
+// into the columns of the batch as a whole (RecBuffer::getColumns())
+class BatchScanOperator : public BatchOperator {
+ public:
+  BatchScanOperator(int relId, PredicateNode *condition = nullptr);
+  ~BatchScanOperator();
+
+  int open();
+  int nextBatch(Batch *batch);
+  void close();
+
+ private:
+  int relId;
+  PredicateNode *condition;
+  ScanCursor *cursor;
+  std::vector<int> attrTypes;
+
+  // a block read off the cursor that did not fit in the last batch (or -1)
+  int pendingBlock;
+  uint64_t pendingBitmap[SELECTION_BITMAP_WORDS];
+};
+
+// the same, with the blocks read and filtered by several worker threads (a
+// ParallelScan); the records come out in the same order
+class ParallelScanOperator : public BatchOperator {
+ public:
+  ParallelScanOperator(int relId, PredicateNode *condition, int numWorkers);
+  ~ParallelScanOperator();
+
+  int open();
+  int nextBatch(Batch *batch);
+  void close();
+
+ private:
+  int relId;
+  PredicateNode *condition;
+  int numWorkers;
+  ParallelScan *scan;
+};
+
+#endif  // NITCBASE_SCANOPERATOR_H
@@ -0,0 +1,234 @@
+#include "SemiJoinOperator.h"
+
+// the offset and type of the attribute of the child to look up, checked
+// against the type of the inner attribute; the status of the operator
+static int lookupAttr(Operator *child, char attrName[ATTR_SIZE], int innerType, int *attrOffset, int *attrType)
+{
+	if (child->getStatus() != SUCCESS) return child->getStatus();
+
+	*attrOffset = child->getAttrOffset(attrName);
+	if (*attrOffset < 0) return *attrOffset;
+
+	*attrType = child->getAttr(*attrOffset)->attrType;
+	if (*attrType != innerType) return E_ATTRTYPEMISMATCH;
+
+	return SUCCESS;
+}
+
+SemiJoinOperator::SemiJoinOperator(Operator *child, char attrName[ATTR_SIZE], Operator *inner, bool anti)
+{
+	this->child = child;
+	this->inner = inner;
+	this->anti = anti;
+	attrOffset = -1;
+	attrType = NUMBER;
+
+	for (int offset = 0; offset < child->getNumAttrs(); offset++)
+		attrs.push_back(*child->getAttr(offset));
+
+	if (inner->getStatus() != SUCCESS)
+		status = inner->getStatus();
+	else if (inner->getNumAttrs() != 1)
+		status = E_NATTRMISMATCH;
+	else
+		status = lookupAttr(child, attrName, inner->getAttr(0)->attrType, &attrOffset, &attrType);
+
+	// (the table is never held to its budget: it has to hold every inner value)
+	values = new HashTable(1, &attrType, 1, getMaxValues());
+	childOpen = false;
+}
+
+SemiJoinOperator::~SemiJoinOperator()
+{
+	close();
+	delete values;
+	delete child;
+	delete inner;
+}
+
+int SemiJoinOperator::getMaxValues()
+{
+	return HashTable::getMaxKeys(1, 0);
+}
+
+int SemiJoinOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+
+	// the distinct inner values
+	int ret = inner->open();
+	if (ret != SUCCESS) return ret;
+
+	Attribute innerRecord[1];
+	while ((ret = inner->next(innerRecord)) == SUCCESS)
+	{
+		uint32_t hash = values->hash(innerRecord);
+		if (values->find(innerRecord, hash) == -1) values->add(innerRecord, hash);
+	}
+
+	inner->close();
+	if (ret != E_NOTFOUND) return ret;
+
+	ret = child->open();
+	childOpen = ret == SUCCESS;
+
+	return ret;
+}
+
+int SemiJoinOperator::next(Attribute *record)
+{
+	int ret;
+	while ((ret = child->next(record)) == SUCCESS)
+	{
+		Attribute *attrVal = &record[attrOffset];
+		bool found = values->find(attrVal, values->hash(attrVal)) != -1;
+		if (found != anti) return SUCCESS;
+	}
+
+	return ret;
+}
+
+void SemiJoinOperator::close()
+{
+	if (childOpen) child->close();
+	childOpen = false;
+
+	values->clear();
+}
+
+IndexSemiJoinOperator::IndexSemiJoinOperator(Operator *child, char attrName[ATTR_SIZE], int innerRelId,
+											 char innerAttrName[ATTR_SIZE], bool anti)
+{
+	this->child = child;
+	this->anti = anti;
+	attrOffset = -1;
+	attrType = NUMBER;
+	rootBlock = -1;
+
+	for (int offset = 0; offset < child->getNumAttrs(); offset++)
+		attrs.push_back(*child->getAttr(offset));
+
+	AttrCatEntry attrCatEntry;
+	status = AttrCacheTable::getAttrCatEntry(innerRelId, innerAttrName, &attrCatEntry);
+	if (status != SUCCESS) return;
+
+	rootBlock = attrCatEntry.rootBlock;
+	if (rootBlock == -1)
+	{
+		status = E_NOINDEX;
+		return;
+	}
+
+	status = lookupAttr(child, attrName, attrCatEntry.attrType, &attrOffset, &attrType);
+}
+
+IndexSemiJoinOperator::~IndexSemiJoinOperator()
+{
+	delete child;
+}
+
+// whether the B+ tree has an entry equal to attrVal
+bool IndexSemiJoinOperator::contains(Attribute attrVal)
+{
+	// (the leaf the walk starts at may begin with smaller values)
+	LeafCursor cursor (rootBlock, attrVal, attrType, EQ);
+
+	Index entry;
+	while (cursor.next(&entry) == SUCCESS)
+	{
+		int cmpVal = compareAttrs(entry.attrVal, attrVal, attrType);
+		if (cmpVal >= 0) return cmpVal == 0;
+	}
+
+	return false;
+}
+
+int IndexSemiJoinOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	return child->open();
+}
+
+int IndexSemiJoinOperator::next(Attribute *record)
+{
+	int ret;
+	while ((ret = child->next(record)) == SUCCESS)
+		if (contains(record[attrOffset]) != anti) return SUCCESS;
+
+	return ret;
+}
+
+void IndexSemiJoinOperator::close()
+{
+	child->close();
+}
+
+MergeSemiJoinOperator::MergeSemiJoinOperator(Operator *child, char attrName[ATTR_SIZE], Operator *inner, bool anti)
+{
+	this->child = child;
+	this->inner = inner;
+	this->anti = anti;
+	attrOffset = -1;
+	attrType = NUMBER;
+	hasInner = false;
+
+	for (int offset = 0; offset < child->getNumAttrs(); offset++)
+		attrs.push_back(*child->getAttr(offset));
+
+	if (inner->getStatus() != SUCCESS)
+		status = inner->getStatus();
+	else if (inner->getNumAttrs() != 1)
+		status = E_NATTRMISMATCH;
+	else
+		status = lookupAttr(child, attrName, inner->getAttr(0)->attrType, &attrOffset, &attrType);
+}
+
+MergeSemiJoinOperator::~MergeSemiJoinOperator()
+{
+	delete child;
+	delete inner;
+}
+
+int MergeSemiJoinOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	int ret = child->open();
+	if (ret == SUCCESS) ret = inner->open();
+	if (ret != SUCCESS) return ret;
+
+	ret = inner->next(&innerValue);
+	hasInner = ret == SUCCESS;
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+int MergeSemiJoinOperator::next(Attribute *record)
+{
+	int ret;
+	while ((ret = child->next(record)) == SUCCESS)
+	{
+		// move the inner values up to the value of the record (the values of
+		// the records that follow are no smaller)
+		while (hasInner && compareAttrs(innerValue, record[attrOffset], attrType) < 0)
+		{
+			int innerRet = inner->next(&innerValue);
+			if (innerRet != SUCCESS && innerRet != E_NOTFOUND) return innerRet;
+			hasInner = innerRet == SUCCESS;
+		}
+
+		bool found = hasInner && compareAttrs(innerValue, record[attrOffset], attrType) == 0;
+		if (found != anti) return SUCCESS;
+	}
+
+	return ret;
+}
+
+void MergeSemiJoinOperator::close()
+{
+	child->close();
+	inner->close();
+	hasInner = false;
+}
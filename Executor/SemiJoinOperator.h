@@ -0,0 +1,93 @@
+#ifndef NITCBASE_SEMIJOINOPERATOR_H
+#define NITCBASE_SEMIJOINOPERATOR_H
+
+#include "../BPlusTree/LeafCursor.h"
+#include "../Cache/AttrCacheTable.h"
+#include "HashTable.h"
+#include "Operator.h"
+
+/*
+    Semi-join and anti-join: the records of the child whose value of an
+    attribute is (semi-join; IN, EXISTS) or is not (anti-join; NOT IN, NOT
+    EXISTS) among the values of an attribute of an inner relation. A record
+    of the child is handed out at most once, as it is, however many inner
+    records match it: the search for a match stops at the first one, and no
+    joined record is ever made.
+*/
+
+// the values of the inner attribute (the only attribute of the records of
+// `inner`) are held in a HashTable, built by reading `inner` once
+// in open(); it is meant for inners with at most getMaxValues() distinct
+// values (it still grows past that if the estimate it was chosen on is off)
+class SemiJoinOperator : public Operator {
+ public:
+  // (E_ATTRNOTEXIST if the child has no attribute attrName, E_ATTRTYPEMISMATCH
+  // if it is not of the type of the inner attribute)
+  SemiJoinOperator(Operator *child, char attrName[ATTR_SIZE], Operator *inner, bool anti);
+  ~SemiJoinOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+  // the number of values the hash table holds in OPERATOR_MEMORY_BLOCKS
+  static int getMaxValues();
+
+ private:
+  Operator *child, *inner;
+  int attrOffset;
+  int attrType;
+  bool anti;
+
+  HashTable *values;  // the distinct inner values
+  bool childOpen;
+};
+
+// the value of the attribute of each record of the child is looked up in the
+// B+ tree of the inner attribute, walking its leaves only up to the first
+// entry that is not smaller than the value
+class IndexSemiJoinOperator : public Operator {
+ public:
+  // (E_NOINDEX if the inner attribute has no B+ tree)
+  IndexSemiJoinOperator(Operator *child, char attrName[ATTR_SIZE], int innerRelId, char innerAttrName[ATTR_SIZE],
+                        bool anti);
+  ~IndexSemiJoinOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  int attrOffset;
+  int attrType;
+  int rootBlock;
+  bool anti;
+
+  bool contains(Attribute attrVal);
+};
+
+// the child produces its records in ascending order of the attribute, and
+// `inner` its values (its only attribute) in ascending order (e.g. both
+// SortOperators): the two are merged in a single pass
+class MergeSemiJoinOperator : public Operator {
+ public:
+  MergeSemiJoinOperator(Operator *child, char attrName[ATTR_SIZE], Operator *inner, bool anti);
+  ~MergeSemiJoinOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child, *inner;
+  int attrOffset;
+  int attrType;
+  bool anti;
+
+  // the smallest inner value not yet passed (valid if hasInner)
+  Attribute innerValue;
+  bool hasInner;
+};
+
+#endif  // NITCBASE_SEMIJOINOPERATOR_H
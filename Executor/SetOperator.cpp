@@ -0,0 +1,267 @@
+#include "SetOperator.h"
+
+// the status of an operator over two children that must be union-compatible
+static int compatibility(Operator *left, Operator *right)
+{
+	if (left->getStatus() != SUCCESS) return left->getStatus();
+	if (right->getStatus() != SUCCESS) return right->getStatus();
+
+	if (left->getNumAttrs() != right->getNumAttrs()) return E_NATTRMISMATCH;
+
+	for (int attrOffset = 0; attrOffset < left->getNumAttrs(); attrOffset++)
+		if (left->getAttr(attrOffset)->attrType != right->getAttr(attrOffset)->attrType) return E_ATTRTYPEMISMATCH;
+
+	return SUCCESS;
+}
+
+ConcatOperator::ConcatOperator(Operator *left, Operator *right)
+{
+	this->left = left;
+	this->right = right;
+	onRight = false;
+
+	for (int attrOffset = 0; attrOffset < left->getNumAttrs(); attrOffset++)
+		attrs.push_back(*left->getAttr(attrOffset));
+
+	status = compatibility(left, right);
+}
+
+ConcatOperator::~ConcatOperator()
+{
+	delete left;
+	delete right;
+}
+
+int ConcatOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	onRight = false;
+	return left->open();
+}
+
+int ConcatOperator::next(Attribute *record)
+{
+	if (!onRight)
+	{
+		int ret = left->next(record);
+		if (ret != E_NOTFOUND) return ret;
+
+		// (the left child is done; continue with the right child)
+		left->close();
+		onRight = true;
+
+		ret = right->open();
+		if (ret != SUCCESS) return ret;
+	}
+
+	return right->next(record);
+}
+
+void ConcatOperator::close()
+{
+	if (onRight)
+		right->close();
+	else
+		left->close();
+
+	onRight = false;
+}
+
+HashSetOperator::HashSetOperator(Operator *left, Operator *right, int setOp)
+{
+	this->left = left;
+	this->right = right;
+	this->setOp = setOp;
+	numAttrs = left->getNumAttrs();
+	leftOpen = false;
+
+	int attrTypes[numAttrs];
+	for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+	{
+		attrs.push_back(*left->getAttr(attrOffset));
+		attrTypes[attrOffset] = attrs[attrOffset].attrType;
+	}
+
+	// (the table is never held to its budget: it has to hold all of the right child)
+	records = new HashTable(numAttrs, attrTypes, numAttrs, HashTable::getMaxKeys(numAttrs, 0));
+
+	status = compatibility(left, right);
+	if (status == SUCCESS && setOp != SET_INTERSECT && setOp != SET_EXCEPT) status = E_INVALID;
+}
+
+HashSetOperator::~HashSetOperator()
+{
+	close();
+	delete records;
+	delete left;
+	delete right;
+}
+
+int HashSetOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+
+	// the distinct records of the right child
+	int ret = right->open();
+	if (ret != SUCCESS) return ret;
+
+	Attribute record[numAttrs];
+	while ((ret = right->next(record)) == SUCCESS)
+	{
+		uint32_t hash = records->hash(record);
+		if (records->find(record, hash) != -1) continue;
+
+		records->add(record, hash);
+		matched.push_back(false);
+	}
+
+	right->close();
+	if (ret != E_NOTFOUND) return ret;
+
+	ret = left->open();
+	leftOpen = ret == SUCCESS;
+
+	return ret;
+}
+
+int HashSetOperator::next(Attribute *record)
+{
+	int ret;
+	while ((ret = left->next(record)) == SUCCESS)
+	{
+		int stored = records->find(record, records->hash(record));
+
+		if (setOp == SET_EXCEPT)
+		{
+			if (stored == -1) return SUCCESS;
+			continue;
+		}
+
+		if (stored != -1 && !matched[stored])
+		{
+			matched[stored] = true;
+			return SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
+void HashSetOperator::close()
+{
+	if (leftOpen) left->close();
+	leftOpen = false;
+
+	records->clear();
+	matched.clear();
+}
+
+MergeSetOperator::MergeSetOperator(Operator *left, Operator *right, int setOp)
+{
+	this->left = left;
+	this->right = right;
+	this->setOp = setOp;
+	numAttrs = left->getNumAttrs();
+	hasLeft = hasRight = false;
+
+	for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+		attrs.push_back(*left->getAttr(attrOffset));
+
+	leftRecord.resize(numAttrs);
+	rightRecord.resize(numAttrs);
+
+	status = compatibility(left, right);
+	if (status == SUCCESS && setOp == SET_UNION_ALL) status = E_INVALID;
+}
+
+MergeSetOperator::~MergeSetOperator()
+{
+	delete left;
+	delete right;
+}
+
+int MergeSetOperator::compare(Attribute *lhs, Attribute *rhs)
+{
+	for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+	{
+		int diff = compareAttrs(lhs[attrOffset], rhs[attrOffset], attrs[attrOffset].attrType);
+		if (diff != 0) return diff;
+	}
+
+	return 0;
+}
+
+int MergeSetOperator::skipLeft(std::vector<Attribute> &value)
+{
+	int ret;
+	while ((ret = left->next(leftRecord.data())) == SUCCESS && compare(leftRecord.data(), value.data()) == 0)
+		;
+
+	hasLeft = ret == SUCCESS;
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+int MergeSetOperator::skipRight(std::vector<Attribute> &value)
+{
+	int ret;
+	while ((ret = right->next(rightRecord.data())) == SUCCESS && compare(rightRecord.data(), value.data()) == 0)
+		;
+
+	hasRight = ret == SUCCESS;
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+int MergeSetOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	int ret = left->open();
+	if (ret == SUCCESS) ret = right->open();
+	if (ret != SUCCESS) return ret;
+
+	ret = left->next(leftRecord.data());
+	hasLeft = ret == SUCCESS;
+	if (ret != SUCCESS && ret != E_NOTFOUND) return ret;
+
+	ret = right->next(rightRecord.data());
+	hasRight = ret == SUCCESS;
+	return ret == E_NOTFOUND ? SUCCESS : ret;
+}
+
+int MergeSetOperator::next(Attribute *record)
+{
+	while (hasLeft || hasRight)
+	{
+		// the smaller of the two records (both, if they are equal)
+		int cmpVal = !hasRight ? -1 : !hasLeft ? 1 : compare(leftRecord.data(), rightRecord.data());
+
+		std::vector<Attribute> value = cmpVal <= 0 ? leftRecord : rightRecord;
+		bool inLeft = cmpVal <= 0, inRight = cmpVal >= 0;
+
+		int ret = SUCCESS;
+		if (inLeft) ret = skipLeft(value);
+		if (ret == SUCCESS && inRight) ret = skipRight(value);
+		if (ret != SUCCESS) return ret;
+
+		bool keep = setOp == SET_UNION || (setOp == SET_INTERSECT && inLeft && inRight) ||
+					(setOp == SET_EXCEPT && inLeft && !inRight);
+
+		if (keep)
+		{
+			std::copy(value.begin(), value.end(), record);
+			return SUCCESS;
+		}
+	}
+
+	return E_NOTFOUND;
+}
+
+void MergeSetOperator::close()
+{
+	left->close();
+	right->close();
+	hasLeft = hasRight = false;
+}
@@ -0,0 +1,95 @@
+#ifndef NITCBASE_SETOPERATOR_H
+#define NITCBASE_SETOPERATOR_H
+
+#include "HashTable.h"
+#include "Operator.h"
+
+/*
+    Operators that combine the records of two union-compatible children
+    (the same number of attributes, of the same types in the same order;
+    the records produced take the attribute names of the left child). Each
+    child is read once. Two records are equal if they agree on every
+    attribute.
+*/
+
+enum SetOperation {
+  SET_UNION,      // the records of either child, each once
+  SET_UNION_ALL,  // the records of the left child, then those of the right child
+  SET_INTERSECT,  // the records of the left child that are also in the right child, each once
+  SET_EXCEPT      // the records of the left child that are not in the right child, each once
+};
+
+// the records of the left child, then those of the right child (UNION ALL;
+// a DistinctOperator over it gives UNION)
+class ConcatOperator : public Operator {
+ public:
+  // (E_NATTRMISMATCH or E_ATTRTYPEMISMATCH if the children are not union-compatible)
+  ConcatOperator(Operator *left, Operator *right);
+  ~ConcatOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *left, *right;
+  bool onRight;
+};
+
+// INTERSECT or EXCEPT: the distinct records of the right child are held in
+// a HashTable (which has to fit in OPERATOR_MEMORY_BLOCKS, see
+// DistinctOperator::getMaxRecords()), and each record of the left child is
+// looked up in it as it is read. For INTERSECT, a record is handed out the
+// first time it is found (the entry it matched is marked); for EXCEPT, every
+// record that is not found is handed out, so the duplicates among them are
+// left for a DistinctOperator above it to drop
+class HashSetOperator : public Operator {
+ public:
+  HashSetOperator(Operator *left, Operator *right, int setOp);
+  ~HashSetOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *left, *right;
+  int setOp;
+  int numAttrs;
+
+  HashTable *records;           // the distinct records of the right child
+  std::vector<bool> matched;   // (by their position in the table)
+  bool leftOpen;
+};
+
+// UNION, INTERSECT or EXCEPT of two children that produce their records in
+// ascending order of all their attributes (e.g. SortOperators on every
+// attribute, which spill to the disk when the children do not fit in
+// memory): the two are merged in a single pass, and each run of equal
+// records is handed out at most once
+class MergeSetOperator : public Operator {
+ public:
+  MergeSetOperator(Operator *left, Operator *right, int setOp);
+  ~MergeSetOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *left, *right;
+  int setOp;
+  int numAttrs;
+
+  // the next record of each child (valid if has*)
+  std::vector<Attribute> leftRecord, rightRecord;
+  bool hasLeft, hasRight;
+
+  int compare(Attribute *lhs, Attribute *rhs);
+
+  // move past the run of records equal to `value` in a child
+  int skipLeft(std::vector<Attribute> &value);
+  int skipRight(std::vector<Attribute> &value);
+};
+
+#endif  // NITCBASE_SETOPERATOR_H
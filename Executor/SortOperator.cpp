@@ -0,0 +1,207 @@
+#include "SortOperator.h"
+
+#include <algorithm>
+
+SortOperator::SortOperator(Operator *child, int numKeys, char keyNames[][ATTR_SIZE], bool descending[])
+{
+	this->child = child;
+	sorter = nullptr;
+
+	for (int offset = 0; offset < child->getNumAttrs(); offset++)
+		attrs.push_back(*child->getAttr(offset));
+
+	status = child->getStatus();
+
+	for (int keyIndex = 0; keyIndex < numKeys && status == SUCCESS; keyIndex++)
+	{
+		int attrOffset = child->getAttrOffset(keyNames[keyIndex]);
+		if (attrOffset < 0)
+		{
+			status = E_ATTRNOTEXIST;
+			break;
+		}
+
+		keys.push_back(SortKey {attrOffset, attrs[attrOffset].attrType, descending[keyIndex]});
+	}
+}
+
+SortOperator::~SortOperator()
+{
+	close();
+	delete child;
+}
+
+int SortOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+	sorter = new ExternalSort(attrs.size(), keys.size(), keys.data());
+
+	int ret = child->open();
+
+	// (all the records of the child have to be seen before the first one
+	// can be handed out)
+	Attribute record[attrs.size()];
+	while (ret == SUCCESS && (ret = child->next(record)) == SUCCESS)
+		ret = sorter->add(record);
+
+	child->close();
+
+	if (ret != E_NOTFOUND) return ret;
+
+	return sorter->sort();
+}
+
+int SortOperator::next(Attribute *record)
+{
+	return sorter->next(record);
+}
+
+void SortOperator::close()
+{
+	if (sorter != nullptr) sorter->release();
+	delete sorter;
+	sorter = nullptr;
+}
+
+TopNOperator::TopNOperator(Operator *child, int limit, int numKeys, char keyNames[][ATTR_SIZE], bool descending[])
+{
+	this->child = child;
+	this->limit = limit;
+	position = 0;
+
+	for (int offset = 0; offset < child->getNumAttrs(); offset++)
+		attrs.push_back(*child->getAttr(offset));
+
+	status = child->getStatus();
+	if (status == SUCCESS && limit < 0) status = E_INVALID;
+
+	for (int keyIndex = 0; keyIndex < numKeys && status == SUCCESS; keyIndex++)
+	{
+		int attrOffset = child->getAttrOffset(keyNames[keyIndex]);
+		if (attrOffset < 0)
+		{
+			status = E_ATTRNOTEXIST;
+			break;
+		}
+
+		keys.push_back(SortKey {attrOffset, attrs[attrOffset].attrType, descending[keyIndex]});
+	}
+}
+
+TopNOperator::~TopNOperator()
+{
+	close();
+	delete child;
+}
+
+bool TopNOperator::fits(int limit, int numAttrs)
+{
+	// (a record takes its values, its sequence number and its heap slot)
+	double recordSize = numAttrs * sizeof(Attribute) + 2 * sizeof(int);
+	return limit * recordSize <= OPERATOR_MEMORY_BLOCKS * BLOCK_SIZE;
+}
+
+// whether the record at index lhs comes before the one at index rhs
+bool TopNOperator::before(int lhs, int rhs)
+{
+	int numAttrs = attrs.size();
+
+	for (SortKey &key : keys)
+	{
+		int diff = compareAttrs(records[lhs * numAttrs + key.attrOffset], records[rhs * numAttrs + key.attrOffset],
+								key.attrType);
+		if (diff != 0) return key.descending ? diff > 0 : diff < 0;
+	}
+
+	return sequence[lhs] < sequence[rhs];
+}
+
+// move the record at heapIndex down until neither child comes after it
+void TopNOperator::siftDown(int heapIndex)
+{
+	int size = heap.size();
+	while (true)
+	{
+		int worst = heapIndex;
+		int left = 2 * heapIndex + 1, right = left + 1;
+
+		if (left < size && before(heap[worst], heap[left])) worst = left;
+		if (right < size && before(heap[worst], heap[right])) worst = right;
+		if (worst == heapIndex) return;
+
+		std::swap(heap[heapIndex], heap[worst]);
+		heapIndex = worst;
+	}
+}
+
+int TopNOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	close();
+
+	int numAttrs = attrs.size();
+	records.resize((limit + 1) * numAttrs);
+	sequence.resize(limit + 1);
+
+	int ret = limit == 0 ? E_NOTFOUND : child->open();
+
+	// (the slot after the `limit` kept is where each new record is read to)
+	Attribute *scratch = &records[limit * numAttrs];
+	auto keep = [&](int slot) {
+		std::copy(scratch, scratch + numAttrs, &records[slot * numAttrs]);
+		sequence[slot] = sequence[limit];
+	};
+
+	int numRead = 0;
+	while (ret == SUCCESS && (ret = child->next(scratch)) == SUCCESS)
+	{
+		sequence[limit] = numRead++;
+
+		// the first `limit` records are all kept, and made a heap once there
+		// are that many
+		if ((int)heap.size() < limit)
+		{
+			keep(heap.size());
+			heap.push_back(heap.size());
+
+			if ((int)heap.size() == limit)
+				for (int heapIndex = limit / 2 - 1; heapIndex >= 0; heapIndex--)
+					siftDown(heapIndex);
+			continue;
+		}
+
+		// after that, a record replaces the worst one kept if it comes before it
+		if (!before(limit, heap[0])) continue;
+
+		keep(heap[0]);
+		siftDown(0);
+	}
+
+	if (limit != 0) child->close();
+	if (ret != E_NOTFOUND) return ret;
+
+	// hand the records kept out best first
+	std::sort(heap.begin(), heap.end(), [this](int lhs, int rhs) { return before(lhs, rhs); });
+	return SUCCESS;
+}
+
+int TopNOperator::next(Attribute *record)
+{
+	if (position >= (int)heap.size()) return E_NOTFOUND;
+
+	int slot = heap[position++];
+	std::copy(&records[slot * attrs.size()], &records[(slot + 1) * attrs.size()], record);
+
+	return SUCCESS;
+}
+
+void TopNOperator::close()
+{
+	records.clear();
+	sequence.clear();
+	heap.clear();
+	position = 0;
+}
@@ -0,0 +1,60 @@
+#ifndef NITCBASE_SORTOPERATOR_H
+#define NITCBASE_SORTOPERATOR_H
+
+#include "../Algebra/ExternalSort.h"
+#include "Operator.h"
+
+// the records of the child in the order of one or more of its attributes,
+// each ascending or descending (records with equal keys keep the order the
+// child produced them in), sorted with an ExternalSort when the operator is
+// opened
+class SortOperator : public Operator {
+ public:
+  SortOperator(Operator *child, int numKeys, char keyNames[][ATTR_SIZE], bool descending[]);
+  ~SortOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  std::vector<SortKey> keys;
+  ExternalSort *sorter;
+};
+
+// the first `limit` records of the child in the order of the keys (as a
+// SortOperator followed by a LimitOperator would hand them out), found in a
+// single pass with a bounded heap that holds the best `limit` records seen so
+// far, so nothing is written to the disk and the other records are dropped
+// as soon as they are read
+class TopNOperator : public Operator {
+ public:
+  TopNOperator(Operator *child, int limit, int numKeys, char keyNames[][ATTR_SIZE], bool descending[]);
+  ~TopNOperator();
+
+  // whether the heap of `limit` records with numAttrs attributes fits in
+  // OPERATOR_MEMORY_BLOCKS
+  static bool fits(int limit, int numAttrs);
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  int limit;
+  std::vector<SortKey> keys;
+
+  // the records kept (attrs.size() values each), and the order they were
+  // read in, which breaks ties between equal keys
+  std::vector<Attribute> records;
+  std::vector<int> sequence;
+  std::vector<int> heap;  // indices into records; the worst record kept at the top
+  int position;
+
+  bool before(int lhs, int rhs);
+  void siftDown(int heapIndex);
+};
+
+#endif  // NITCBASE_SORTOPERATOR_H
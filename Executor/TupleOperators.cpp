@@ -0,0 +1,158 @@
+#include "TupleOperators.h"
+
+#include <cstdlib>
+#include <cstring>
+
+FilterOperator::FilterOperator(Operator *child, PredicateNode *condition)
+{
+	this->child = child;
+	this->condition = condition;
+
+	int numAttrs = child->getNumAttrs();
+	char attrNames[numAttrs][ATTR_SIZE];
+	int attrTypes[numAttrs];
+
+	for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+	{
+		OperatorAttr *attr = child->getAttr(attrOffset);
+		strcpy(attrNames[attrOffset], attr->attrName);
+		attrTypes[attrOffset] = attr->attrType;
+		attrs.push_back(*attr);
+	}
+
+	status = child->getStatus();
+	if (status == SUCCESS) status = Predicate::resolve(numAttrs, attrNames, attrTypes, condition);
+}
+
+FilterOperator::~FilterOperator()
+{
+	delete child;
+}
+
+int FilterOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	return child->open();
+}
+
+int FilterOperator::next(Attribute *record)
+{
+	int ret;
+	while ((ret = child->next(record)) == SUCCESS)
+	{
+		if (Predicate::evaluate(condition, record)) return SUCCESS;
+	}
+
+	return ret;
+}
+
+void FilterOperator::close()
+{
+	child->close();
+}
+
+ProjectOperator::ProjectOperator(Operator *child, int numAttrs, char attrNames[][ATTR_SIZE])
+{
+	this->child = child;
+	childRecord = nullptr;
+
+	status = child->getStatus();
+
+	for (int attrIndex = 0; attrIndex < numAttrs; attrIndex++)
+	{
+		int attrOffset = child->getAttrOffset(attrNames[attrIndex]);
+		if (attrOffset < 0)
+		{
+			if (status == SUCCESS) status = E_ATTRNOTEXIST;
+			continue;
+		}
+
+		srcOffsets.push_back(attrOffset);
+		attrs.push_back(*child->getAttr(attrOffset));
+	}
+}
+
+ProjectOperator::~ProjectOperator()
+{
+	free(childRecord);
+	delete child;
+}
+
+int ProjectOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	if (childRecord == nullptr)
+	{
+		childRecord = (Attribute *)malloc(child->getNumAttrs() * sizeof(Attribute));
+		if (childRecord == nullptr) return FAILURE;
+	}
+
+	return child->open();
+}
+
+int ProjectOperator::next(Attribute *record)
+{
+	int ret = child->next(childRecord);
+	if (ret != SUCCESS) return ret;
+
+	for (int attrIndex = 0; attrIndex < (int)srcOffsets.size(); attrIndex++)
+		record[attrIndex] = childRecord[srcOffsets[attrIndex]];
+
+	return SUCCESS;
+}
+
+void ProjectOperator::close()
+{
+	child->close();
+}
+
+LimitOperator::LimitOperator(Operator *child, int limit, int offset)
+{
+	this->child = child;
+	this->limit = limit;
+	this->offset = offset;
+	numSkipped = numReturned = 0;
+
+	for (int attrOffset = 0; attrOffset < child->getNumAttrs(); attrOffset++)
+		attrs.push_back(*child->getAttr(attrOffset));
+
+	status = child->getStatus();
+	if (status == SUCCESS && (limit < 0 || offset < 0)) status = E_INVALID;
+}
+
+LimitOperator::~LimitOperator()
+{
+	delete child;
+}
+
+int LimitOperator::open()
+{
+	if (status != SUCCESS) return status;
+
+	numSkipped = numReturned = 0;
+	return child->open();
+}
+
+int LimitOperator::next(Attribute *record)
+{
+	// (once the limit is reached, the child is not asked for anything more)
+	if (numReturned == limit) return E_NOTFOUND;
+
+	for (; numSkipped < offset; numSkipped++)
+	{
+		int ret = child->next(record);
+		if (ret != SUCCESS) return ret;
+	}
+
+	int ret = child->next(record);
+	if (ret == SUCCESS) numReturned++;
+
+	return ret;
+}
+
+void LimitOperator::close()
+{
+	child->close();
+}
@@ -0,0 +1,62 @@
+#ifndef NITCBASE_TUPLEOPERATORS_H
+#define NITCBASE_TUPLEOPERATORS_H
+
+#include "../BlockAccess/Predicate.h"
+#include "Operator.h"
+
+/*
+    Operators that look at one record of their child at a time.
+*/
+
+// the records of the child that satisfy a condition on its attributes
+class FilterOperator : public Operator {
+ public:
+  // (the tree is resolved against the attributes of the child here; it is
+  // not copied, and must live as long as the operator)
+  FilterOperator(Operator *child, PredicateNode *condition);
+  ~FilterOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  PredicateNode *condition;
+};
+
+// the records of the child, with only the attributes asked for, in that order
+class ProjectOperator : public Operator {
+ public:
+  ProjectOperator(Operator *child, int numAttrs, char attrNames[][ATTR_SIZE]);
+  ~ProjectOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  std::vector<int> srcOffsets;
+  Attribute *childRecord;
+};
+
+// at most `limit` records of the child, after skipping the first `offset`
+class LimitOperator : public Operator {
+ public:
+  LimitOperator(Operator *child, int limit, int offset = 0);
+  ~LimitOperator();
+
+  int open();
+  int next(Attribute *record);
+  void close();
+
+ private:
+  Operator *child;
+  int limit;
+  int offset;
+  int numSkipped;
+  int numReturned;
+};
+
+#endif  // NITCBASE_TUPLEOPERATORS_H
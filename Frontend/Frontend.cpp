@@ -1,8 +1,13 @@
 #include "Frontend.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 
+#include "../Executor/Executor.h"
+
 int Frontend::create_table(char relname[ATTR_SIZE], int no_attrs, char attributes[][ATTR_SIZE], int type_attrs[])
 {
 	return Schema::createRel(relname, no_attrs, attributes, type_attrs);
@@ -74,22 +79,114 @@ int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], c
 											   int attr_count, char attr_list[][ATTR_SIZE],
 											   char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE])
 {
-	int ret = Algebra::select(relname_source, "temp", attribute, op, value);
-	if (ret != SUCCESS)
-		return ret;
+	// a single condition is a predicate tree with just one leaf
+	PredicateNode *condition = Predicate::createCompare(attribute, op, value);
+	if (condition == nullptr)
+		return FAILURE;
 
-	ret = OpenRelTable::openRel("temp");
-	if (ret < 0 || ret >= MAX_OPEN)
-		return ret;
+	int ret = select_attrlist_from_table_where(relname_source, relname_target, attr_count, attr_list, condition);
+	Predicate::release(condition);
 
-	ret = Algebra::project("temp", relname_target, attr_count, attr_list);
-	if (ret != SUCCESS)
-		return ret;
+	return ret;
+}
+
+int Frontend::select_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+									  PredicateNode *condition)
+{
+	return Algebra::select(relname_source, relname_target, condition);
+}
 
-	Schema::closeRel("temp");
-	Schema::deleteRel("temp");
+int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+											   int attr_count, char attr_list[][ATTR_SIZE],
+											   PredicateNode *condition)
+{
+	// Algebra::select with a projection list filters and projects every
+	// record in one pass, straight into the target relation
+	return Algebra::select(relname_source, relname_target, attr_count, attr_list, condition);
+}
 
-	return SUCCESS;
+int Frontend::select_from_table_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+										 PredicateNode *condition, int key_count, char key_list[][ATTR_SIZE],
+										 bool descending[], int limit)
+{
+	return Algebra::orderBy(relname_source, relname_target, condition, key_count, key_list, descending, limit);
+}
+
+int Frontend::select_attrlist_from_table_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+												  int attr_count, char attr_list[][ATTR_SIZE],
+												  PredicateNode *condition, int key_count,
+												  char key_list[][ATTR_SIZE], bool descending[], int limit)
+{
+	return Algebra::orderBy(relname_source, relname_target, attr_count, attr_list, condition, key_count, key_list,
+							descending, limit);
+}
+
+int Frontend::select_from_table_limit(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+									  PredicateNode *condition, int limit)
+{
+	return Algebra::limit(relname_source, relname_target, condition, limit);
+}
+
+int Frontend::select_attrlist_from_table_limit(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+											   int attr_count, char attr_list[][ATTR_SIZE],
+											   PredicateNode *condition, int limit)
+{
+	return Algebra::limit(relname_source, relname_target, attr_count, attr_list, condition, limit);
+}
+
+int Frontend::select_aggregate_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+										  int item_count, int funcs[], char item_list[][ATTR_SIZE],
+										  PredicateNode *condition, char group_attr[ATTR_SIZE])
+{
+	return Algebra::groupBy(relname_source, relname_target, item_count, funcs, item_list, condition, group_attr);
+}
+
+int Frontend::select_distinct_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+										 PredicateNode *condition)
+{
+	return Algebra::distinct(relname_source, relname_target, condition);
+}
+
+int Frontend::select_distinct_attrlist_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+												  int attr_count, char attr_list[][ATTR_SIZE],
+												  PredicateNode *condition)
+{
+	return Algebra::distinct(relname_source, relname_target, attr_count, attr_list, condition);
+}
+
+int Frontend::set_operation(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
+							 char relname_target[ATTR_SIZE], int set_op)
+{
+	return Algebra::setOperation(relname_source_one, relname_source_two, relname_target, set_op);
+}
+
+int Frontend::select_from_table_semi_join(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+										  char attr[ATTR_SIZE], char relname_inner[ATTR_SIZE],
+										  char inner_attr[ATTR_SIZE], bool anti)
+{
+	return Algebra::semiJoin(relname_source, relname_target, attr, relname_inner, inner_attr, anti);
+}
+
+int Frontend::select_attrlist_from_table_semi_join(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+												   int attr_count, char attr_list[][ATTR_SIZE], char attr[ATTR_SIZE],
+												   char relname_inner[ATTR_SIZE], char inner_attr[ATTR_SIZE],
+												   bool anti)
+{
+	return Algebra::semiJoin(relname_source, relname_target, attr_count, attr_list, attr, relname_inner, inner_attr,
+							 anti);
+}
+
+int Frontend::explain_select_from_table_where(char relname_source[ATTR_SIZE], PredicateNode *condition,
+											  AccessPathEstimate *estimate)
+{
+	return Algebra::explainSelect(relname_source, condition, estimate);
+}
+
+int Frontend::explain_select_attrlist_from_table_where(char relname_source[ATTR_SIZE], int attr_count,
+													   char attr_list[][ATTR_SIZE], PredicateNode *condition,
+													   AccessPathEstimate *estimate)
+{
+	return Algebra::explainSelect(relname_source, attr_count, attr_list, condition, estimate);
 }
 
 // int Frontend::select_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
@@ -122,22 +219,371 @@ int Frontend::select_attrlist_from_join_where(char relname_source_one[ATTR_SIZE]
 												char join_attr_two[ATTR_SIZE],
 											  	int attr_count, char attr_list[][ATTR_SIZE])
 {
-	// Algebra::join + project
-	int ret = Algebra::join(relname_source_one, relname_source_two, 
-							"temp_relation", join_attr_one, join_attr_two);
-	if (ret != SUCCESS) return ret;
+	char join_attrs_one[1][ATTR_SIZE], join_attrs_two[1][ATTR_SIZE];
+	int ops[1] = {EQ};
+	strcpy(join_attrs_one[0], join_attr_one);
+	strcpy(join_attrs_two[0], join_attr_two);
 
-	ret = Algebra::project("temp_relation", relname_target, attr_count, attr_list);
-	OpenRelTable::closeRel(OpenRelTable::getRelId("temp_relation"));
-	Schema::deleteRel("temp_relation");
+	return Frontend::select_attrlist_from_join_where(relname_source_one, relname_source_two, relname_target,
+													 1, join_attrs_one, ops, join_attrs_two,
+													 attr_count, attr_list);
+}
 
+int Frontend::select_from_join_where(char relname_source_one[ATTR_SIZE], 
+										char relname_source_two[ATTR_SIZE], 
+										char relname_target[ATTR_SIZE], 
+										int cond_count, char join_attrs_one[][ATTR_SIZE],
+										int ops[], char join_attrs_two[][ATTR_SIZE]) 
+{
+	// Algebra::join
+	return Algebra::join(relname_source_one, relname_source_two, relname_target,
+						 cond_count, join_attrs_one, ops, join_attrs_two);
+}
+
+int Frontend::select_attrlist_from_join_where(char relname_source_one[ATTR_SIZE], 
+												char relname_source_two[ATTR_SIZE],
+											  	char relname_target[ATTR_SIZE],
+												int cond_count, char join_attrs_one[][ATTR_SIZE],
+												int ops[], char join_attrs_two[][ATTR_SIZE],
+											  	int attr_count, char attr_list[][ATTR_SIZE])
+{
+	// Algebra::join with a projection list assembles only the requested
+	// attributes of every matching pair, straight into the target relation
+	return Algebra::join(relname_source_one, relname_source_two, relname_target,
+						 cond_count, join_attrs_one, ops, join_attrs_two, attr_count, attr_list);
+}
+
+int Frontend::select_from_join_on(int rel_count, char relnames_source[][ATTR_SIZE],
+									 char relname_target[ATTR_SIZE], int cond_count,
+									 char cond_rels_one[][ATTR_SIZE], char cond_attrs_one[][ATTR_SIZE],
+									 int ops[], char cond_rels_two[][ATTR_SIZE],
+									 char cond_attrs_two[][ATTR_SIZE])
+{
+	// Algebra::multiJoin
+	return Algebra::multiJoin(rel_count, relnames_source, relname_target, cond_count,
+							  cond_rels_one, cond_attrs_one, ops, cond_rels_two, cond_attrs_two);
+}
+
+int Frontend::select_attrlist_from_join_on(int rel_count, char relnames_source[][ATTR_SIZE],
+											  char relname_target[ATTR_SIZE], int cond_count,
+											  char cond_rels_one[][ATTR_SIZE], char cond_attrs_one[][ATTR_SIZE],
+											  int ops[], char cond_rels_two[][ATTR_SIZE],
+											  char cond_attrs_two[][ATTR_SIZE], int attr_count,
+											  char attr_list[][ATTR_SIZE])
+{
+	// Algebra::multiJoin with a projection list
+	return Algebra::multiJoin(rel_count, relnames_source, relname_target, cond_count,
+							  cond_rels_one, cond_attrs_one, ops, cond_rels_two, cond_attrs_two,
+							  attr_count, attr_list);
+}
+
+/*
+	FUNCTION BENCH_FILTER <relname> <attrname> <EQ|LE|LT|GE|GT|NE> <value> [iterations]
+
+	Scans every record block of an open relation `iterations` times, once with
+	the record-at-a-time compareAttrs() loop that linearSearch() used to run and
+	once with each predicate kernel mode supported by this CPU, and prints the
+	time taken per scan together with the number of matching records.
+*/
+static int benchmark_filter(int argc, char argv[][ATTR_SIZE])
+{
+	int relId = OpenRelTable::getRelId(argv[0]);
+	if (relId < 0 || relId >= MAX_OPEN) return E_RELNOTOPEN;
+
+	AttrCatEntry attrCatEntry;
+	if (AttrCacheTable::getAttrCatEntry(relId, argv[1], &attrCatEntry) != SUCCESS)
+		return E_ATTRNOTEXIST;
+
+	const char *opNames[] = {"EQ", "LE", "LT", "GE", "GT", "NE"};
+	int op = -1;
+	for (int opIndex = EQ; opIndex <= NE; opIndex++)
+		if (strcmp(argv[2], opNames[opIndex]) == 0) op = opIndex;
+	if (op == -1) return E_INVALID;
+
+	Attribute attrVal;
+	if (attrCatEntry.attrType == NUMBER) attrVal.nVal = atof(argv[3]);
+	else strcpy(attrVal.sVal, argv[3]);
+
+	int iterations = argc > 4 ? atoi(argv[4]) : 1000;
+	if (iterations <= 0) return E_INVALID;
+
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+	int count = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		count = 0;
+		for (int block = relCatEntry.firstBlk; block != -1; )
+		{
+			RecBuffer blockBuffer (block);
+
+			HeadInfo blockHeader;
+			blockBuffer.getHeader(&blockHeader);
+
+			unsigned char slotMap[blockHeader.numSlots];
+			blockBuffer.getSlotMap(slotMap);
+
+			for (int slot = 0; slot < blockHeader.numSlots; slot++)
+			{
+				if (slotMap[slot] == SLOT_UNOCCUPIED) continue;
+
+				Attribute record[blockHeader.numAttrs];
+				blockBuffer.getRecord(record, slot);
+
+				int cmpVal = compareAttrs(record[attrCatEntry.offset], attrVal, attrCatEntry.attrType);
+				if ((op == NE && cmpVal != 0) || (op == LT && cmpVal < 0) || (op == LE && cmpVal <= 0) ||
+					(op == EQ && cmpVal == 0) || (op == GT && cmpVal > 0) || (op == GE && cmpVal >= 0))
+					count++;
+			}
+
+			block = blockHeader.rblock;
+		}
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	printf("%-18s %10.2f us/scan  %d records\n", "record-at-a-time", elapsed.count() / iterations, count);
+
+	const char *modeNames[] = {"kernel (scalar)", "kernel (SSE2)", "kernel (AVX2)"};
+	int previousMode = PredicateKernels::getMode();
+
+	for (int mode = KERNEL_SCALAR; mode <= PredicateKernels::bestMode(); mode++)
+	{
+		PredicateKernels::setMode(mode);
+
+		start = std::chrono::steady_clock::now();
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			count = 0;
+			for (int block = relCatEntry.firstBlk; block != -1; )
+			{
+				uint64_t selected[SELECTION_BITMAP_WORDS];
+				PredicateKernels::filterBlock(block, attrCatEntry.offset, attrCatEntry.attrType, attrVal, op,
+											  selected, &block);
+
+				for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+					count += __builtin_popcountll(selected[word]);
+			}
+		}
+		elapsed = std::chrono::steady_clock::now() - start;
+		printf("%-18s %10.2f us/scan  %d records\n", modeNames[mode], elapsed.count() / iterations, count);
+	}
+
+	PredicateKernels::setMode(previousMode);
+	return SUCCESS;
+}
+
+/*
+	FUNCTION BENCH_BATCH <relname> <attrname> <EQ|LE|LT|GE|GT|NE> <value> [iterations]
+
+	Counts the records of an open relation that satisfy `attrname op value`
+	`iterations` times: with the per-record BlockAccess::search() loop, with
+	the iterator engine (a FilterOperator over a ScanOperator, one record per
+	call) and with the vectorized engine (a BatchFilterOperator over a
+	BatchScanOperator, BATCH_SIZE records per call, and a BatchScanOperator
+	that filters the blocks itself), and prints the time taken per scan
+	together with the number of matching records.
+*/
+static int benchmark_batch(int argc, char argv[][ATTR_SIZE])
+{
+	int relId = OpenRelTable::getRelId(argv[0]);
+	if (relId < 0 || relId >= MAX_OPEN) return E_RELNOTOPEN;
+
+	const char *opNames[] = {"EQ", "LE", "LT", "GE", "GT", "NE"};
+	int op = -1;
+	for (int opIndex = EQ; opIndex <= NE; opIndex++)
+		if (strcmp(argv[2], opNames[opIndex]) == 0) op = opIndex;
+	if (op == -1) return E_INVALID;
+
+	int iterations = argc > 4 ? atoi(argv[4]) : 1000;
+	if (iterations <= 0) return E_INVALID;
+
+	// (resolved against the relation, and then against each plan)
+	PredicateNode *condition = Predicate::createCompare(argv[1], op, argv[3]);
+	if (condition == nullptr) return FAILURE;
+
+	int ret = Predicate::resolve(relId, condition);
+	if (ret != SUCCESS)
+	{
+		Predicate::release(condition);
+		return ret;
+	}
+
+	RelCatEntry relCatEntry;
+	RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	Attribute record[relCatEntry.numAttrs];
+
+	int count = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		count = 0;
+		RelCacheTable::resetSearchIndex(relId);
+		AttrCacheTable::resetSearchIndex(relId, condition->attrName);
+
+		while (BlockAccess::search(relId, record, condition->attrName, condition->attrVal, op) == SUCCESS)
+			count++;
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	printf("%-20s %10.2f us/scan  %d records\n", "BlockAccess::search", elapsed.count() / iterations, count);
+
+	FilterOperator iteratorPlan (new ScanOperator(relId), condition);
+
+	start = std::chrono::steady_clock::now();
+	for (int iteration = 0; iteration < iterations && ret == SUCCESS; iteration++)
+	{
+		count = 0;
+		ret = iteratorPlan.open();
+		while (ret == SUCCESS && iteratorPlan.next(record) == SUCCESS) count++;
+		iteratorPlan.close();
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	printf("%-20s %10.2f us/scan  %d records\n", "iterator", elapsed.count() / iterations, count);
+
+	BatchFilterOperator batchPlan (new BatchScanOperator(relId), condition);
+	std::vector<OperatorAttr> attrs;
+	for (int attrOffset = 0; attrOffset < batchPlan.getNumAttrs(); attrOffset++)
+		attrs.push_back(*batchPlan.getAttr(attrOffset));
+	Batch batch (attrs);
+
+	start = std::chrono::steady_clock::now();
+	for (int iteration = 0; iteration < iterations && ret == SUCCESS; iteration++)
+	{
+		count = 0;
+		ret = batchPlan.open();
+		while (ret == SUCCESS && batchPlan.nextBatch(&batch) == SUCCESS) count += batch.numSelected;
+		batchPlan.close();
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	printf("%-20s %10.2f us/scan  %d records\n", "batch", elapsed.count() / iterations, count);
+
+	// (the same, with the condition evaluated by the scan itself, which can
+	// skip blocks by their zones)
+	BatchScanOperator pushedPlan (relId, condition);
+
+	start = std::chrono::steady_clock::now();
+	for (int iteration = 0; iteration < iterations && ret == SUCCESS; iteration++)
+	{
+		count = 0;
+		ret = pushedPlan.open();
+		while (ret == SUCCESS && pushedPlan.nextBatch(&batch) == SUCCESS) count += batch.numSelected;
+		pushedPlan.close();
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	printf("%-20s %10.2f us/scan  %d records\n", "batch (scan filter)", elapsed.count() / iterations, count);
+
+	Predicate::release(condition);
+	return ret;
+}
+
+/*
+	FUNCTION BENCH_PARALLEL <relname> <attrname> <EQ|LE|LT|GE|GT|NE> <value> [iterations] [max workers]
+
+	Counts the records of an open relation that satisfy `attrname op value`
+	`iterations` times, with a BatchScanOperator (one thread) and with a
+	ParallelScanOperator with 1, 2, 4, ... workers (up to `max workers`, by
+	default WorkerPool::getDefaultWorkers()), and prints the time taken per
+	scan together with the number of matching records.
+*/
+static int benchmark_parallel(int argc, char argv[][ATTR_SIZE])
+{
+	int relId = OpenRelTable::getRelId(argv[0]);
+	if (relId < 0 || relId >= MAX_OPEN) return E_RELNOTOPEN;
+
+	const char *opNames[] = {"EQ", "LE", "LT", "GE", "GT", "NE"};
+	int op = -1;
+	for (int opIndex = EQ; opIndex <= NE; opIndex++)
+		if (strcmp(argv[2], opNames[opIndex]) == 0) op = opIndex;
+	if (op == -1) return E_INVALID;
+
+	int iterations = argc > 4 ? atoi(argv[4]) : 100;
+	int maxWorkers = argc > 5 ? atoi(argv[5]) : WorkerPool::getDefaultWorkers();
+	if (iterations <= 0 || maxWorkers <= 0 || maxWorkers > MAX_WORKERS) return E_INVALID;
+
+	PredicateNode *condition = Predicate::createCompare(argv[1], op, argv[3]);
+	if (condition == nullptr) return FAILURE;
+
+	int ret = Predicate::resolve(relId, condition);
+	if (ret != SUCCESS)
+	{
+		Predicate::release(condition);
+		return ret;
+	}
+
+	BatchScanOperator serialPlan (relId, condition);
+	std::vector<OperatorAttr> attrs;
+	for (int attrOffset = 0; attrOffset < serialPlan.getNumAttrs(); attrOffset++)
+		attrs.push_back(*serialPlan.getAttr(attrOffset));
+	Batch batch (attrs);
+
+	int count = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int iteration = 0; iteration < iterations && ret == SUCCESS; iteration++)
+	{
+		count = 0;
+		ret = serialPlan.open();
+		while (ret == SUCCESS && serialPlan.nextBatch(&batch) == SUCCESS) count += batch.numSelected;
+		serialPlan.close();
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	printf("%-20s %10.2f us/scan  %d records\n", "batch scan", elapsed.count() / iterations, count);
+
+	for (int numWorkers = 1; numWorkers <= maxWorkers && ret == SUCCESS; numWorkers *= 2)
+	{
+		// (the workers are started by the first open(), and kept until close())
+		ParallelScanOperator parallelPlan (relId, condition, numWorkers);
+
+		start = std::chrono::steady_clock::now();
+		for (int iteration = 0; iteration < iterations && ret == SUCCESS; iteration++)
+		{
+			count = 0;
+			ret = parallelPlan.open();
+			while (ret == SUCCESS && parallelPlan.nextBatch(&batch) == SUCCESS) count += batch.numSelected;
+		}
+		parallelPlan.close();
+		elapsed = std::chrono::steady_clock::now() - start;
+
+		char label[32];
+		sprintf(label, "parallel (%d)", numWorkers);
+		printf("%-20s %10.2f us/scan  %d records\n", label, elapsed.count() / iterations, count);
+	}
+
+	Predicate::release(condition);
 	return ret;
 }
 
+/*
+	FUNCTION SET_WORKERS <n>
+
+	Sets the number of worker threads of the parallel operations (0 for the
+	number of hardware threads, the default).
+*/
+static int set_workers(int argc, char argv[][ATTR_SIZE])
+{
+	int numWorkers = atoi(argv[0]);
+	if (numWorkers < 0 || numWorkers > MAX_WORKERS) return E_INVALID;
+
+	WorkerPool::setDefaultWorkers(numWorkers);
+	printf("Parallel operations use %d worker(s)\n", WorkerPool::getDefaultWorkers());
+	return SUCCESS;
+}
+
 int Frontend::custom_function(int argc, char argv[][ATTR_SIZE])
 {
 	// argc gives the size of the argv array
 	// argv stores every token delimited by space and comma
 
-	// implement whatever you desire
+	if (argc >= 5 && strcmp(argv[0], "BENCH_FILTER") == 0)
+		return benchmark_filter(argc - 1, argv + 1);
+
+	if (argc >= 5 && strcmp(argv[0], "BENCH_BATCH") == 0)
+		return benchmark_batch(argc - 1, argv + 1);
+
+	if (argc >= 5 && strcmp(argv[0], "BENCH_PARALLEL") == 0)
+		return benchmark_parallel(argc - 1, argv + 1);
+
+	if (argc == 2 && strcmp(argv[0], "SET_WORKERS") == 0)
+		return set_workers(argc - 1, argv + 1);
+
+	return E_INVALID;
 }
\ No newline at end of file
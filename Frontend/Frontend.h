@@ -39,6 +39,68 @@ class Frontend {
                                               int attr_count, char attr_list[][ATTR_SIZE],
                                               char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]);
 
+  static int select_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                     PredicateNode *condition);
+
+  static int select_attrlist_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                              int attr_count, char attr_list[][ATTR_SIZE],
+                                              PredicateNode *condition);
+
+  // ORDER BY (condition is nullptr without a WHERE clause)
+  static int select_from_table_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                        PredicateNode *condition, int key_count, char key_list[][ATTR_SIZE],
+                                        bool descending[], int limit);
+
+  static int select_attrlist_from_table_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                 int attr_count, char attr_list[][ATTR_SIZE],
+                                                 PredicateNode *condition, int key_count,
+                                                 char key_list[][ATTR_SIZE], bool descending[], int limit);
+
+  // LIMIT without ORDER BY (condition may be nullptr)
+  static int select_from_table_limit(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                     PredicateNode *condition, int limit);
+
+  static int select_attrlist_from_table_limit(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                              int attr_count, char attr_list[][ATTR_SIZE],
+                                              PredicateNode *condition, int limit);
+
+  // aggregates, GROUP BY (funcs[i] is an AggregateFunction; group_attr is
+  // nullptr without a GROUP BY clause)
+  static int select_aggregate_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                         int item_count, int funcs[], char item_list[][ATTR_SIZE],
+                                         PredicateNode *condition, char group_attr[ATTR_SIZE]);
+
+  // SELECT DISTINCT (condition may be nullptr)
+  static int select_distinct_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                        PredicateNode *condition);
+
+  static int select_distinct_attrlist_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                 int attr_count, char attr_list[][ATTR_SIZE],
+                                                 PredicateNode *condition);
+
+  // UNION [ALL], INTERSECT, EXCEPT (set_op is a SetOperation)
+  static int set_operation(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
+                           char relname_target[ATTR_SIZE], int set_op);
+
+  // semi-join (IN, EXISTS) and anti-join (NOT IN, NOT EXISTS): the records
+  // whose attr is (or, if anti, is not) among the values of inner_attr in
+  // relname_inner
+  static int select_from_table_semi_join(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                         char attr[ATTR_SIZE], char relname_inner[ATTR_SIZE],
+                                         char inner_attr[ATTR_SIZE], bool anti);
+
+  static int select_attrlist_from_table_semi_join(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                  int attr_count, char attr_list[][ATTR_SIZE], char attr[ATTR_SIZE],
+                                                  char relname_inner[ATTR_SIZE], char inner_attr[ATTR_SIZE],
+                                                  bool anti);
+
+  // EXPLAIN: the access path a select on the condition would take
+  static int explain_select_from_table_where(char relname_source[ATTR_SIZE], PredicateNode *condition,
+                                             AccessPathEstimate *estimate);
+  static int explain_select_attrlist_from_table_where(char relname_source[ATTR_SIZE], int attr_count,
+                                                      char attr_list[][ATTR_SIZE], PredicateNode *condition,
+                                                      AccessPathEstimate *estimate);
+
   static int select_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
                                     char relname_target[ATTR_SIZE],
                                     char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE]);
@@ -48,6 +110,30 @@ class Frontend {
                                              char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE],
                                              int attr_count, char attr_list[][ATTR_SIZE]);
 
+  // joins on a conjunction of conditions join_attrs_one[i] ops[i] join_attrs_two[i]
+  static int select_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
+                                    char relname_target[ATTR_SIZE], int cond_count,
+                                    char join_attrs_one[][ATTR_SIZE], int ops[], char join_attrs_two[][ATTR_SIZE]);
+
+  static int select_attrlist_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
+                                             char relname_target[ATTR_SIZE], int cond_count,
+                                             char join_attrs_one[][ATTR_SIZE], int ops[],
+                                             char join_attrs_two[][ATTR_SIZE],
+                                             int attr_count, char attr_list[][ATTR_SIZE]);
+
+  // joins any number of relations at once, on a conjunction of conditions
+  // cond_rels_one[i].cond_attrs_one[i] ops[i] cond_rels_two[i].cond_attrs_two[i]
+  static int select_from_join_on(int rel_count, char relnames_source[][ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                 int cond_count, char cond_rels_one[][ATTR_SIZE], char cond_attrs_one[][ATTR_SIZE],
+                                 int ops[], char cond_rels_two[][ATTR_SIZE], char cond_attrs_two[][ATTR_SIZE]);
+
+  static int select_attrlist_from_join_on(int rel_count, char relnames_source[][ATTR_SIZE],
+                                          char relname_target[ATTR_SIZE], int cond_count,
+                                          char cond_rels_one[][ATTR_SIZE], char cond_attrs_one[][ATTR_SIZE],
+                                          int ops[], char cond_rels_two[][ATTR_SIZE],
+                                          char cond_attrs_two[][ATTR_SIZE], int attr_count,
+                                          char attr_list[][ATTR_SIZE]);
+
   static int custom_function(int argc, char argv[][ATTR_SIZE]);
 };
 
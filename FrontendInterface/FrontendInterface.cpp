@@ -17,6 +17,8 @@ using namespace std;
 
 int getOperator(string op_str);
 
+PredicateNode *parseCondition(string condition);
+
 void attrToTruncatedArray(string nameString, char *nameArray);
 
 void printErrorMsg(int error);
@@ -378,31 +380,114 @@ int RegexHandler::selectAttrFromWhereHandler() {
   return ret;
 }
 
+int RegexHandler::selectFromWhereCondHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], sourceRelName);
+  attrToTruncatedArray(m[2], targetRelName);
+
+  PredicateNode *condition = parseCondition(m[3]);
+  if (condition == nullptr) {
+    return E_INVALID;
+  }
+
+  int ret = Frontend::select_from_table_where(sourceRelName, targetRelName, condition);
+  Predicate::release(condition);
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectAttrFromWhereCondHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+
+  vector<string> attrTokens = extractTokens(m[1]);
+
+  int attrCount = attrTokens.size();
+  char attrNames[attrCount][ATTR_SIZE];
+  for (int i = 0; i < attrCount; i++) {
+    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+  }
+
+  PredicateNode *condition = parseCondition(m[4]);
+  if (condition == nullptr) {
+    return E_INVALID;
+  }
+
+  int ret = Frontend::select_attrlist_from_table_where(sourceRelName, targetRelName, attrCount, attrNames,
+                                                       condition);
+  Predicate::release(condition);
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+/*
+  Orients the join condition `relA.attrA op relB.attrB` so that it reads
+  `relOne.attrOne opOne relTwo.attrTwo` (swapping the sides flips the operator);
+  returns false if the relations in the condition are not relOne and relTwo
+*/
+static bool orientJoinCondition(string relOne, string relTwo, string relA, string attrA, int op,
+                                string relB, string attrB, char attrOne[ATTR_SIZE], int *opOne,
+                                char attrTwo[ATTR_SIZE]) {
+  if (relA == relOne && relB == relTwo) {
+    attrToTruncatedArray(attrA, attrOne);
+    attrToTruncatedArray(attrB, attrTwo);
+    *opOne = op;
+  } else if (relA == relTwo && relB == relOne) {
+    attrToTruncatedArray(attrB, attrOne);
+    attrToTruncatedArray(attrA, attrTwo);
+    *opOne = Predicate::flipOperator(op);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/*
+  `relA.attrA BETWEEN relB.low AND relB.high` is the band condition
+  `relA.attrA >= relB.low AND relA.attrA <= relB.high`; fills in the two
+  conditions oriented as relOne.attr op relTwo.attr
+*/
+static bool orientBetweenCondition(string relOne, string relTwo, string relA, string attrA,
+                                   string relLow, string attrLow, string relHigh, string attrHigh,
+                                   char attrsOne[][ATTR_SIZE], int ops[], char attrsTwo[][ATTR_SIZE]) {
+  if (relLow != relHigh) {
+    return false;
+  }
+  return orientJoinCondition(relOne, relTwo, relA, attrA, GE, relLow, attrLow, attrsOne[0], &ops[0], attrsTwo[0]) &&
+         orientJoinCondition(relOne, relTwo, relA, attrA, LE, relHigh, attrHigh, attrsOne[1], &ops[1], attrsTwo[1]);
+}
+
 int RegexHandler::selectFromJoinHandler() {
   char sourceRelOneName[ATTR_SIZE];
   char sourceRelTwoName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
-  char joinAttributeOne[ATTR_SIZE];
-  char joinAttributeTwo[ATTR_SIZE];
+  char joinAttributesOne[1][ATTR_SIZE];
+  char joinAttributesTwo[1][ATTR_SIZE];
+  int ops[1];
 
   attrToTruncatedArray(m[1], sourceRelOneName);
   attrToTruncatedArray(m[2], sourceRelTwoName);
   attrToTruncatedArray(m[3], targetRelName);
 
-  if (m[1] == m[4] && m[2] == m[6]) {
-    attrToTruncatedArray(m[5], joinAttributeOne);
-    attrToTruncatedArray(m[7], joinAttributeTwo);
-  } else if (m[1] == m[6] && m[2] == m[4]) {
-    attrToTruncatedArray(m[7], joinAttributeOne);
-    attrToTruncatedArray(m[5], joinAttributeTwo);
-
-  } else {
+  if (!orientJoinCondition(m[1], m[2], m[4], m[5], getOperator(m[6]), m[7], m[8],
+                           joinAttributesOne[0], &ops[0], joinAttributesTwo[0])) {
     cout << "Syntax Error: Relation names do not match" << endl;
     return FAILURE;
   }
 
-  int ret = Frontend::select_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName,
-                                             joinAttributeOne, joinAttributeTwo);
+  int ret = Frontend::select_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName, 1,
+                                             joinAttributesOne, ops, joinAttributesTwo);
   if (ret == SUCCESS) {
     cout << "Selected successfully into " << targetRelName << endl;
   }
@@ -414,26 +499,81 @@ int RegexHandler::selectAttrFromJoinHandler() {
   char sourceRelOneName[ATTR_SIZE];
   char sourceRelTwoName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
-  char joinAttributeOne[ATTR_SIZE];
-  char joinAttributeTwo[ATTR_SIZE];
+  char joinAttributesOne[1][ATTR_SIZE];
+  char joinAttributesTwo[1][ATTR_SIZE];
+  int ops[1];
 
   attrToTruncatedArray(m[2], sourceRelOneName);
   attrToTruncatedArray(m[3], sourceRelTwoName);
   attrToTruncatedArray(m[4], targetRelName);
 
-  if (m[2] == m[5] && m[3] == m[7]) {
-    attrToTruncatedArray(m[6], joinAttributeOne);
-    attrToTruncatedArray(m[8], joinAttributeTwo);
-  } else if (m[2] == m[7] && m[3] == m[5]) {
-    attrToTruncatedArray(m[8], joinAttributeOne);
-    attrToTruncatedArray(m[6], joinAttributeTwo);
-  } else {
+  if (!orientJoinCondition(m[2], m[3], m[5], m[6], getOperator(m[7]), m[8], m[9],
+                           joinAttributesOne[0], &ops[0], joinAttributesTwo[0])) {
     cout << "Syntax Error: Relation names do not match" << endl;
     return FAILURE;
   }
 
-  attrToTruncatedArray(m[6], joinAttributeOne);
-  attrToTruncatedArray(m[8], joinAttributeTwo);
+  vector<string> attrTokens = extractTokens(m[1]);
+  int attrCount = attrTokens.size();
+  char attrNames[attrCount][ATTR_SIZE];
+  for (int i = 0; i < attrCount; i++) {
+    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+  }
+
+  int ret = Frontend::select_attrlist_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName, 1,
+                                                      joinAttributesOne, ops, joinAttributesTwo, attrCount,
+                                                      attrNames);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectFromJoinBetweenHandler() {
+  char sourceRelOneName[ATTR_SIZE];
+  char sourceRelTwoName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char joinAttributesOne[2][ATTR_SIZE];
+  char joinAttributesTwo[2][ATTR_SIZE];
+  int ops[2];
+
+  attrToTruncatedArray(m[1], sourceRelOneName);
+  attrToTruncatedArray(m[2], sourceRelTwoName);
+  attrToTruncatedArray(m[3], targetRelName);
+
+  if (!orientBetweenCondition(m[1], m[2], m[4], m[5], m[6], m[7], m[8], m[9],
+                              joinAttributesOne, ops, joinAttributesTwo)) {
+    cout << "Syntax Error: Relation names do not match" << endl;
+    return FAILURE;
+  }
+
+  int ret = Frontend::select_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName, 2,
+                                             joinAttributesOne, ops, joinAttributesTwo);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectAttrFromJoinBetweenHandler() {
+  char sourceRelOneName[ATTR_SIZE];
+  char sourceRelTwoName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char joinAttributesOne[2][ATTR_SIZE];
+  char joinAttributesTwo[2][ATTR_SIZE];
+  int ops[2];
+
+  attrToTruncatedArray(m[2], sourceRelOneName);
+  attrToTruncatedArray(m[3], sourceRelTwoName);
+  attrToTruncatedArray(m[4], targetRelName);
+
+  if (!orientBetweenCondition(m[2], m[3], m[5], m[6], m[7], m[8], m[9], m[10],
+                              joinAttributesOne, ops, joinAttributesTwo)) {
+    cout << "Syntax Error: Relation names do not match" << endl;
+    return FAILURE;
+  }
 
   vector<string> attrTokens = extractTokens(m[1]);
   int attrCount = attrTokens.size();
@@ -442,16 +582,499 @@ int RegexHandler::selectAttrFromJoinHandler() {
     attrToTruncatedArray(attrTokens[i], attrNames[i]);
   }
 
-  int ret = Frontend::select_attrlist_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName,
-                                                      joinAttributeOne, joinAttributeTwo, attrCount,
+  int ret = Frontend::select_attrlist_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName, 2,
+                                                      joinAttributesOne, ops, joinAttributesTwo, attrCount,
                                                       attrNames);
   if (ret == SUCCESS) {
-    cout << "Selected successfully into " << targetRelName;
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+/*
+  Splits the `JOIN rel ON rel.attr op rel.attr [AND ...]` clauses of a
+  multi-way join into the relations joined in and the conditions (each as
+  relOne, attrOne, op, relTwo, attrTwo)
+*/
+static void parseJoinClauses(string clauses, vector<string> &relations, vector<vector<string>> &conditions) {
+  regex joinRe("JOIN\\s+([A-Za-z0-9_-]+)\\s+ON\\s+", regex_constants::icase);
+  for (sregex_iterator it(clauses.begin(), clauses.end(), joinRe), end; it != end; ++it) {
+    relations.push_back((*it)[1]);
+  }
+
+  regex condRe("([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*(<=|>=|!=|<|>|=)\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)");
+  for (sregex_iterator it(clauses.begin(), clauses.end(), condRe), end; it != end; ++it) {
+    conditions.push_back({(*it)[1], (*it)[2], (*it)[3], (*it)[4], (*it)[5]});
+  }
+}
+
+// runs the multi-way join of `SELECT <attrs> FROM firstRel <clauses> INTO target`
+// (attrTokens is empty for SELECT *)
+static int selectFromJoinOn(string firstRel, string clauses, string target, vector<string> attrTokens) {
+  vector<string> relations = {firstRel};
+  vector<vector<string>> conditions;
+  parseJoinClauses(clauses, relations, conditions);
+
+  int relCount = relations.size();
+  char relNames[relCount][ATTR_SIZE];
+  for (int i = 0; i < relCount; i++) {
+    attrToTruncatedArray(relations[i], relNames[i]);
+  }
+
+  int condCount = conditions.size();
+  char relsOne[condCount][ATTR_SIZE], attrsOne[condCount][ATTR_SIZE];
+  char relsTwo[condCount][ATTR_SIZE], attrsTwo[condCount][ATTR_SIZE];
+  int ops[condCount];
+
+  for (int i = 0; i < condCount; i++) {
+    bool relOneFound = false, relTwoFound = false;
+    for (int j = 0; j < relCount; j++) {
+      relOneFound = relOneFound || conditions[i][0] == relations[j];
+      relTwoFound = relTwoFound || conditions[i][3] == relations[j];
+    }
+    if (!relOneFound || !relTwoFound) {
+      cout << "Syntax Error: Relation names do not match" << endl;
+      return FAILURE;
+    }
+
+    attrToTruncatedArray(conditions[i][0], relsOne[i]);
+    attrToTruncatedArray(conditions[i][1], attrsOne[i]);
+    ops[i] = getOperator(conditions[i][2]);
+    attrToTruncatedArray(conditions[i][3], relsTwo[i]);
+    attrToTruncatedArray(conditions[i][4], attrsTwo[i]);
+  }
+
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(target, targetRelName);
+
+  int attrCount = attrTokens.size();
+  char attrNames[attrCount > 0 ? attrCount : 1][ATTR_SIZE];
+  for (int i = 0; i < attrCount; i++) {
+    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+  }
+
+  int ret;
+  if (attrCount == 0) {
+    ret = Frontend::select_from_join_on(relCount, relNames, targetRelName, condCount, relsOne, attrsOne, ops,
+                                        relsTwo, attrsTwo);
+  } else {
+    ret = Frontend::select_attrlist_from_join_on(relCount, relNames, targetRelName, condCount, relsOne, attrsOne,
+                                                 ops, relsTwo, attrsTwo, attrCount, attrNames);
+  }
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectFromJoinOnHandler() {
+  return selectFromJoinOn(m[1], m[2], m[3], {});
+}
+
+int RegexHandler::selectAttrFromJoinOnHandler() {
+  return selectFromJoinOn(m[2], m[3], m[4], extractTokens(m[1]));
+}
+
+int RegexHandler::selectOrderByHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+
+  // the keys, each followed by an optional ASC or DESC
+  vector<string> keyTokens = extractTokens(m[5]);
+
+  int keyCount = 0;
+  char keyNames[keyTokens.size()][ATTR_SIZE];
+  bool descending[keyTokens.size()];
+  for (int i = 0; i < keyTokens.size(); i++) {
+    if (strcasecmp(keyTokens[i].c_str(), "ASC") == 0) {
+      continue;
+    }
+    if (strcasecmp(keyTokens[i].c_str(), "DESC") == 0) {
+      descending[keyCount - 1] = true;
+      continue;
+    }
+    attrToTruncatedArray(keyTokens[i], keyNames[keyCount]);
+    descending[keyCount] = false;
+    keyCount++;
+  }
+
+  // (no LIMIT keeps every record)
+  int limit = m[6].matched ? atoi(m.str(6).c_str()) : -1;
+
+  PredicateNode *condition = nullptr;
+  if (m[4].matched) {
+    condition = parseCondition(m[4]);
+    if (condition == nullptr) {
+      return E_INVALID;
+    }
+  }
+
+  int ret;
+  if (m[1] == "*") {
+    ret = Frontend::select_from_table_order_by(sourceRelName, targetRelName, condition, keyCount, keyNames,
+                                               descending, limit);
+  } else {
+    vector<string> attrTokens = extractTokens(m[1]);
+
+    int attrCount = attrTokens.size();
+    char attrNames[attrCount][ATTR_SIZE];
+    for (int i = 0; i < attrCount; i++) {
+      attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    }
+
+    ret = Frontend::select_attrlist_from_table_order_by(sourceRelName, targetRelName, attrCount, attrNames,
+                                                        condition, keyCount, keyNames, descending, limit);
+  }
+
+  if (condition != nullptr) {
+    Predicate::release(condition);
+  }
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
   }
 
   return ret;
 }
 
+int RegexHandler::selectLimitHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+
+  int limit = atoi(m.str(5).c_str());
+
+  PredicateNode *condition = nullptr;
+  if (m[4].matched) {
+    condition = parseCondition(m[4]);
+    if (condition == nullptr) {
+      return E_INVALID;
+    }
+  }
+
+  int ret;
+  if (m[1] == "*") {
+    ret = Frontend::select_from_table_limit(sourceRelName, targetRelName, condition, limit);
+  } else {
+    vector<string> attrTokens = extractTokens(m[1]);
+
+    int attrCount = attrTokens.size();
+    char attrNames[attrCount][ATTR_SIZE];
+    for (int i = 0; i < attrCount; i++) {
+      attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    }
+
+    ret = Frontend::select_attrlist_from_table_limit(sourceRelName, targetRelName, attrCount, attrNames,
+                                                     condition, limit);
+  }
+
+  if (condition != nullptr) {
+    Predicate::release(condition);
+  }
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectDistinctHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+
+  PredicateNode *condition = nullptr;
+  if (m[4].matched) {
+    condition = parseCondition(m[4]);
+    if (condition == nullptr) {
+      return E_INVALID;
+    }
+  }
+
+  int ret;
+  if (m[1] == "*") {
+    ret = Frontend::select_distinct_from_table(sourceRelName, targetRelName, condition);
+  } else {
+    vector<string> attrTokens = extractTokens(m[1]);
+
+    int attrCount = attrTokens.size();
+    char attrNames[attrCount][ATTR_SIZE];
+    for (int i = 0; i < attrCount; i++) {
+      attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    }
+
+    ret = Frontend::select_distinct_attrlist_from_table(sourceRelName, targetRelName, attrCount, attrNames,
+                                                        condition);
+  }
+
+  if (condition != nullptr) {
+    Predicate::release(condition);
+  }
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::setOperationHandler() {
+  char sourceRelOneName[ATTR_SIZE];
+  char sourceRelTwoName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], sourceRelOneName);
+  attrToTruncatedArray(m[3], sourceRelTwoName);
+  attrToTruncatedArray(m[4], targetRelName);
+
+  // (UNION ALL is the only operator of two words)
+  string op = m[2];
+
+  int setOp;
+  if (op.find_first_of(" \t\n") != string::npos) {
+    setOp = SET_UNION_ALL;
+  } else if (strcasecmp(op.c_str(), "UNION") == 0) {
+    setOp = SET_UNION;
+  } else if (strcasecmp(op.c_str(), "INTERSECT") == 0) {
+    setOp = SET_INTERSECT;
+  } else {
+    setOp = SET_EXCEPT;
+  }
+
+  int ret = Frontend::set_operation(sourceRelOneName, sourceRelTwoName, targetRelName, setOp);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+// the part shared by the IN and EXISTS forms of a semi-join or anti-join
+// (no attribute tokens for `SELECT *`)
+static int semiJoin(vector<string> attrTokens, char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE],
+                    char attr[ATTR_SIZE], char innerRel[ATTR_SIZE], char innerAttr[ATTR_SIZE], bool anti) {
+  int ret;
+  if (attrTokens.empty()) {
+    ret = Frontend::select_from_table_semi_join(srcRel, targetRel, attr, innerRel, innerAttr, anti);
+  } else {
+    int attrCount = attrTokens.size();
+    char attrNames[attrCount][ATTR_SIZE];
+    for (int i = 0; i < attrCount; i++) {
+      attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    }
+
+    ret = Frontend::select_attrlist_from_table_semi_join(srcRel, targetRel, attrCount, attrNames, attr, innerRel,
+                                                         innerAttr, anti);
+  }
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRel << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectInHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char attrName[ATTR_SIZE];
+  char innerRelName[ATTR_SIZE];
+  char innerAttrName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+  attrToTruncatedArray(m[5], attrName);
+  attrToTruncatedArray(m[7], innerAttrName);
+  attrToTruncatedArray(m[8], innerRelName);
+
+  // (the attribute may be qualified by the source relation only)
+  if (m[4].matched) {
+    char qualifier[ATTR_SIZE];
+    attrToTruncatedArray(m[4], qualifier);
+    if (strcmp(qualifier, sourceRelName) != 0) {
+      return E_INVALID;
+    }
+  }
+
+  vector<string> attrTokens;
+  if (m[1] != "*") {
+    attrTokens = extractTokens(m[1]);
+  }
+
+  return semiJoin(attrTokens, sourceRelName, targetRelName, attrName, innerRelName, innerAttrName, m[6].matched);
+}
+
+int RegexHandler::selectExistsHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char innerRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+  attrToTruncatedArray(m[5], innerRelName);
+
+  // the correlation `rel.attr = rel.attr` has one side on each relation, in either order
+  char relNames[2][ATTR_SIZE];
+  char attrNames[2][ATTR_SIZE];
+  attrToTruncatedArray(m[6], relNames[0]);
+  attrToTruncatedArray(m[7], attrNames[0]);
+  attrToTruncatedArray(m[8], relNames[1]);
+  attrToTruncatedArray(m[9], attrNames[1]);
+
+  int srcSide;
+  if (strcmp(relNames[0], sourceRelName) == 0 && strcmp(relNames[1], innerRelName) == 0) {
+    srcSide = 0;
+  } else if (strcmp(relNames[1], sourceRelName) == 0 && strcmp(relNames[0], innerRelName) == 0) {
+    srcSide = 1;
+  } else {
+    return E_INVALID;
+  }
+
+  vector<string> attrTokens;
+  if (m[1] != "*") {
+    attrTokens = extractTokens(m[1]);
+  }
+
+  return semiJoin(attrTokens, sourceRelName, targetRelName, attrNames[srcSide], innerRelName,
+                  attrNames[1 - srcSide], m[4].matched);
+}
+
+int RegexHandler::selectAggregateHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+
+  // every item of the select list is either FUNC(attr) or an attribute
+  string itemList = m[1];
+  regex itemRegex("(COUNT|SUM|MIN|MAX|AVG)\\s*\\(\\s*(\\*|[#A-Za-z0-9_-]+)\\s*\\)|([#A-Za-z0-9_-]+)",
+                  regex_constants::icase);
+
+  vector<int> funcs;
+  vector<string> itemAttrs;
+  for (sregex_iterator iter(itemList.begin(), itemList.end(), itemRegex); iter != sregex_iterator(); ++iter) {
+    smatch item = *iter;
+    if (!item[1].matched) {
+      funcs.push_back(AGG_NONE);
+      itemAttrs.push_back(item[3]);
+      continue;
+    }
+
+    string func = item[1];
+    for (char &c : func) {
+      c = toupper(c);
+    }
+
+    if (func == "COUNT")
+      funcs.push_back(AGG_COUNT);
+    else if (func == "SUM")
+      funcs.push_back(AGG_SUM);
+    else if (func == "MIN")
+      funcs.push_back(AGG_MIN);
+    else if (func == "MAX")
+      funcs.push_back(AGG_MAX);
+    else
+      funcs.push_back(AGG_AVG);
+    itemAttrs.push_back(item[2]);
+  }
+
+  int itemCount = funcs.size();
+  char itemNames[itemCount][ATTR_SIZE];
+  for (int i = 0; i < itemCount; i++) {
+    attrToTruncatedArray(itemAttrs[i], itemNames[i]);
+  }
+
+  PredicateNode *condition = nullptr;
+  if (m[4].matched) {
+    condition = parseCondition(m[4]);
+    if (condition == nullptr) {
+      return E_INVALID;
+    }
+  }
+
+  char groupAttrName[ATTR_SIZE];
+  if (m[5].matched) {
+    attrToTruncatedArray(m[5], groupAttrName);
+  }
+
+  int ret = Frontend::select_aggregate_from_table(sourceRelName, targetRelName, itemCount, funcs.data(), itemNames,
+                                                  condition, m[5].matched ? groupAttrName : nullptr);
+
+  if (condition != nullptr) {
+    Predicate::release(condition);
+  }
+
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::explainSelectHandler() {
+  char sourceRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+
+  PredicateNode *condition = parseCondition(m[3]);
+  if (condition == nullptr) {
+    return E_INVALID;
+  }
+
+  AccessPathEstimate estimate;
+  int ret;
+  if (m[1] == "*") {
+    ret = Frontend::explain_select_from_table_where(sourceRelName, condition, &estimate);
+  } else {
+    vector<string> attrTokens = extractTokens(m[1]);
+
+    int attrCount = attrTokens.size();
+    char attrNames[attrCount][ATTR_SIZE];
+    for (int i = 0; i < attrCount; i++) {
+      attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    }
+
+    ret = Frontend::explain_select_attrlist_from_table_where(sourceRelName, attrCount, attrNames, condition,
+                                                             &estimate);
+  }
+  Predicate::release(condition);
+
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  if (estimate.path == PATH_INDEX_ONLY) {
+    cout << "Access path: index-only scan" << endl;
+  } else if (estimate.path == PATH_BPLUS) {
+    cout << "Access path: B+ tree search" << endl;
+  } else if (estimate.numWorkers > 1) {
+    printf("Access path: parallel linear search (%d workers)\n", estimate.numWorkers);
+  } else {
+    cout << "Access path: linear search (batched)" << endl;
+  }
+  printf("Estimated records: %.0f of %d (selectivity %.4f)\n", estimate.numMatches, estimate.numRecords,
+         estimate.selectivity);
+  printf("Linear search cost: %.0f of %d blocks\n", estimate.linearCost, estimate.numBlocks);
+  if (estimate.indexCost < 0 && estimate.path == PATH_INDEX_ONLY) {
+    printf("B+ tree search cost: - (not estimated)\n");
+  } else if (estimate.indexCost < 0) {
+    printf("B+ tree search cost: - (no index answers the condition)\n");
+  } else {
+    printf("B+ tree search cost: %.1f blocks\n", estimate.indexCost);
+  }
+  if (estimate.indexOnlyCost < 0) {
+    printf("Index-only scan cost: - (no index covers the query)\n");
+  } else {
+    printf("Index-only scan cost: %.1f blocks\n", estimate.indexOnlyCost);
+  }
+
+  return SUCCESS;
+}
+
 int RegexHandler::customFunctionHandler() {
   vector<string> tokens = extractTokens(m[1]);
 
@@ -468,8 +1091,9 @@ int RegexHandler::handle(const string command) {
   for (auto iter = handlers.begin(); iter != handlers.end(); ++iter) {
     regex testCommand = iter->first;
     handlerFunction handler = iter->second;
-    if (regex_match(command, testCommand)) {
-      regex_search(command, m, testCommand);
+    // (the submatches are those of the match of the whole command, so that
+    // a lazy group such as the WHERE clause before GROUP BY is not cut short)
+    if (regex_match(command, m, testCommand)) {
       int status = (this->*handler)();
       if (status == SUCCESS || status == EXIT) {
         return status;
@@ -526,6 +1150,106 @@ int getOperator(string opStr) {
   return op;
 }
 
+/*
+  Parses a WHERE clause made of `attr op value` conditions joined by AND/OR
+  (AND binds tighter than OR; parentheses may be used to group conditions):
+    condition  := conjunction (OR conjunction)*
+    conjunction := comparison (AND comparison)*
+    comparison := '(' condition ')' | attr op value
+  returns the predicate tree, or nullptr if the clause is not well formed
+*/
+static bool isKeyword(const string &token, const char *keyword) {
+  if (token.size() != strlen(keyword)) return false;
+  for (int i = 0; i < token.size(); i++) {
+    if (toupper(token[i]) != keyword[i]) return false;
+  }
+  return true;
+}
+
+static bool isOperator(const string &token) {
+  return token == "=" || token == "<" || token == "<=" || token == ">" || token == ">=" || token == "!=";
+}
+
+static PredicateNode *parseDisjunction(vector<string> &tokens, int &pos);
+
+static PredicateNode *parseComparison(vector<string> &tokens, int &pos) {
+  if (pos < tokens.size() && tokens[pos] == "(") {
+    pos++;
+    PredicateNode *node = parseDisjunction(tokens, pos);
+    if (node == nullptr || pos >= tokens.size() || tokens[pos] != ")") {
+      Predicate::release(node);
+      return nullptr;
+    }
+    pos++;
+    return node;
+  }
+
+  if (pos + 3 > tokens.size()) return nullptr;
+
+  string attr = tokens[pos], opStr = tokens[pos + 1], value = tokens[pos + 2];
+  if (attr == "(" || attr == ")" || isOperator(attr) || !isOperator(opStr) ||
+      value == "(" || value == ")" || isOperator(value)) {
+    return nullptr;
+  }
+  pos += 3;
+
+  char attrName[ATTR_SIZE], valueStr[ATTR_SIZE];
+  attrToTruncatedArray(attr, attrName);
+  attrToTruncatedArray(value, valueStr);
+
+  return Predicate::createCompare(attrName, getOperator(opStr), valueStr);
+}
+
+static PredicateNode *parseConjunction(vector<string> &tokens, int &pos) {
+  PredicateNode *node = parseComparison(tokens, pos);
+
+  while (node != nullptr && pos < tokens.size() && isKeyword(tokens[pos], "AND")) {
+    pos++;
+    PredicateNode *right = parseComparison(tokens, pos);
+    if (right == nullptr) {
+      Predicate::release(node);
+      return nullptr;
+    }
+    node = Predicate::createNode(PRED_AND, node, right);
+  }
+
+  return node;
+}
+
+static PredicateNode *parseDisjunction(vector<string> &tokens, int &pos) {
+  PredicateNode *node = parseConjunction(tokens, pos);
+
+  while (node != nullptr && pos < tokens.size() && isKeyword(tokens[pos], "OR")) {
+    pos++;
+    PredicateNode *right = parseConjunction(tokens, pos);
+    if (right == nullptr) {
+      Predicate::release(node);
+      return nullptr;
+    }
+    node = Predicate::createNode(PRED_OR, node, right);
+  }
+
+  return node;
+}
+
+PredicateNode *parseCondition(string condition) {
+  // split the clause into parentheses, operators and words
+  regex re("\\(|\\)|<=|>=|!=|<|>|=|[#A-Za-z0-9_.-]+");
+  sregex_token_iterator first(condition.begin(), condition.end(), re, 0), last;
+  vector<string> tokens(first, last);
+
+  int pos = 0;
+  PredicateNode *node = parseDisjunction(tokens, pos);
+
+  // (every token must have been used)
+  if (node != nullptr && pos != tokens.size()) {
+    Predicate::release(node);
+    return nullptr;
+  }
+
+  return node;
+}
+
 // truncates a given name string to ATTR_NAME sized char array
 void attrToTruncatedArray(string nameString, char *nameArray) {
   string truncated = nameString.substr(0, ATTR_SIZE - 1);
@@ -598,8 +1322,20 @@ void printHelp() {
   printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation; \n\t-creates a relation with attributes specified and all records\n\n");
   printf("SELECT * FROM source_relation INTO target_relation WHERE attrname OP value; \n\t-retrieve records based on a condition and insert them into a target relation\n\n");
   printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation;\n\t-creates a relation with the attributes specified and inserts those records which satisfy the given condition.\n\n");
-  printf("SELECT * FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 = source_relation2.attribute2; \n\t-creates a new relation with by equi-join of both the source relations\n\n");
-  printf("SELECT Attribute1,Attribute2,.. FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 = source_relation2.attribute2; \n\t-creates a new relation by equi-join of both the source relations with the attributes specified \n\n");
+  printf("SELECT * FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 op source_relation2.attribute2; \n\t-creates a new relation by joining both the source relations (op is one of =, <, <=, >, >=, !=)\n\n");
+  printf("SELECT Attribute1,Attribute2,.. FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 op source_relation2.attribute2; \n\t-creates a new relation by joining both the source relations with the attributes specified \n\n");
+  printf("SELECT * FROM source_relation1 JOIN source_relation2 ON source_relation1.attribute1 op source_relation2.attribute2 [AND ...] JOIN source_relation3 ON ... INTO target_relation; \n\t-creates a new relation by joining any number of source relations, in the order the optimizer finds cheapest\n\n");
+  printf("SELECT Attribute1,Attribute2,.. FROM source_relation1 JOIN source_relation2 ON ... JOIN source_relation3 ON ... INTO target_relation; \n\t-creates a new relation by joining any number of source relations with the attributes specified\n\n");
+  printf("SELECT * FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 BETWEEN source_relation2.low AND source_relation2.high; \n\t-creates a new relation by band-joining both the source relations (low <= attribute1 <= high)\n\n");
+  printf("SELECT Attribute1,Attribute2,.. FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 BETWEEN source_relation2.low AND source_relation2.high; \n\t-creates a new relation by band-joining both the source relations with the attributes specified\n\n");
+  printf("SELECT ... FROM source_relation INTO target_relation [WHERE condition] ORDER BY attribute1 [ASC|DESC], attribute2 [ASC|DESC], ... [LIMIT n]; \n\t-creates a relation with the selected records sorted on the attributes given (an external merge sort), or only the first n of them\n\n");
+  printf("SELECT ... FROM source_relation INTO target_relation [WHERE condition] LIMIT n; \n\t-creates a relation with the first n of the selected records\n\n");
+  printf("SELECT DISTINCT * | Attribute1,Attribute2,... FROM source_relation INTO target_relation [WHERE condition]; \n\t-creates a relation with the selected records, each only once\n\n");
+  printf("SELECT * FROM source_relation1 UNION [ALL] | INTERSECT | EXCEPT SELECT * FROM source_relation2 INTO target_relation; \n\t-creates a relation with the records in either (UNION; UNION ALL keeps the duplicates), both (INTERSECT) or only the first (EXCEPT) of two relations with the same attribute types\n\n");
+  printf("SELECT * | Attribute1,Attribute2,... FROM source_relation INTO target_relation WHERE attribute [NOT] IN (SELECT attribute2 FROM relation2); \n\t-creates a relation with the records whose attribute is (or is not) among the values of attribute2 in relation2, each only once (semi-join / anti-join)\n\n");
+  printf("SELECT * | Attribute1,Attribute2,... FROM source_relation INTO target_relation WHERE [NOT] EXISTS (SELECT * FROM relation2 WHERE relation2.attribute2 = source_relation.attribute); \n\t-the same as [NOT] IN\n\n");
+  printf("SELECT [group_attribute,] FUNC(attribute), ... FROM source_relation INTO target_relation [WHERE condition] [GROUP BY group_attribute]; \n\t-creates a relation with the aggregates (FUNC is one of COUNT, SUM, MIN, MAX, AVG; COUNT(*) counts records) of each group of records with the same value of the group attribute\n\n");
+  printf("EXPLAIN SELECT ... FROM source_relation [INTO target_relation] WHERE condition; \n\t-shows whether the select would use a linear search (batched, or in parallel), the B+ trees of the relation or an index-only scan, with the estimated number of records and blocks read\n\n");
   printf("echo <any message> \n\t  -echo back the given string. \n\n");
   printf("run <filename> \n\t  -run commands from an input file in sequence. \n\n");
   printf("exit \n\t-Exit the interface\n");
@@ -26,8 +26,24 @@
 #define SELECT_ATTR_FROM_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s*;?"
 #define SELECT_FROM_WHERE_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+|([0-9]+(\\.)[0-9]+))\\s*;?"
 #define SELECT_ATTR_FROM_WHERE_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+|([0-9]+(\\.)[0-9]+))\\s*;?"
-#define SELECT_FROM_JOIN_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*\\=\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
-#define SELECT_ATTR_FROM_JOIN_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*\\=\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_FROM_WHERE_COND_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+)\\s*;?"
+#define SELECT_ATTR_FROM_WHERE_COND_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+)\\s*;?"
+#define SELECT_FROM_JOIN_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_ATTR_FROM_JOIN_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_FROM_JOIN_BETWEEN_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s+BETWEEN\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s+AND\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_ATTR_FROM_JOIN_BETWEEN_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s+BETWEEN\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s+AND\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_FROM_JOIN_ON_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)((?:\\s+JOIN\\s+[A-Za-z0-9_-]+\\s+ON\\s+[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+\\s*(?:<|<=|>|>=|=|!=)\\s*[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+(?:\\s+AND\\s+[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+\\s*(?:<|<=|>|>=|=|!=)\\s*[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+)*)+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_ATTR_FROM_JOIN_ON_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)((?:\\s+JOIN\\s+[A-Za-z0-9_-]+\\s+ON\\s+[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+\\s*(?:<|<=|>|>=|=|!=)\\s*[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+(?:\\s+AND\\s+[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+\\s*(?:<|<=|>|>=|=|!=)\\s*[A-Za-z0-9_-]+\\s*\\.[#A-Za-z0-9_-]+)*)+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_ORDER_BY_CMD "\\s*SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)(?:\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+?))?\\s+ORDER\\s+BY\\s+((?:[#A-Za-z0-9_-]+(?:\\s+(?:ASC|DESC))?\\s*,\\s*)*[#A-Za-z0-9_-]+(?:\\s+(?:ASC|DESC))?)(?:\\s+LIMIT\\s+([0-9]+))?\\s*;?"
+#define SELECT_LIMIT_CMD "\\s*SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)(?:\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+?))?\\s+LIMIT\\s+([0-9]+)\\s*;?"
+#define SELECT_DISTINCT_CMD "\\s*SELECT\\s+DISTINCT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)(?:\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+?))?\\s*;?"
+#define SET_OPERATION_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+(UNION\\s+ALL|UNION|INTERSECT|EXCEPT)\\s+SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_IN_CMD "\\s*SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+(?:([A-Za-z0-9_-]+)\\s*\\.)?([#A-Za-z0-9_-]+)\\s+(NOT\\s+)?IN\\s*\\(\\s*SELECT\\s+([#A-Za-z0-9_-]+)\\s+FROM\\s+([A-Za-z0-9_-]+)\\s*\\)\\s*;?"
+#define SELECT_EXISTS_CMD "\\s*SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+(NOT\\s+)?EXISTS\\s*\\(\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*=\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*\\)\\s*;?"
+#define AGGREGATE_ITEM "(?:COUNT|SUM|MIN|MAX|AVG)\\s*\\(\\s*(?:\\*|[#A-Za-z0-9_-]+)\\s*\\)"
+#define SELECT_ITEM "(?:" AGGREGATE_ITEM "|[#A-Za-z0-9_-]+)"
+#define SELECT_AGGREGATE_CMD "\\s*SELECT\\s+((?:" SELECT_ITEM "\\s*,\\s*)*" AGGREGATE_ITEM "(?:\\s*,\\s*" SELECT_ITEM ")*)\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)(?:\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+?))?(?:\\s+GROUP\\s+BY\\s+([#A-Za-z0-9_-]+))?\\s*;?"
+#define EXPLAIN_SELECT_CMD "\\s*EXPLAIN\\s+SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)(?:\\s+INTO\\s+[A-Za-z0-9_-]+)?\\s+WHERE\\s+([#A-Za-z0-9_.\\s()<>=!-]+)\\s*;?"
 #define INSERT_SINGLE_CMD "\\s*INSERT\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+VALUES\\s*\\(\\s*((?:(?:[A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s*,\\s*)*(?:[A-Za-z0-9_-]+|[0-9]+\\.[0-9]+))\\s*\\)\\s*;?"
 #define INSERT_MULTIPLE_CMD "\\s*INSERT\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+VALUES\\s+FROM\\s+([a-zA-Z0-9_-]+\\.csv)\\s*;?"
 #define CUSTOM_CMD "\\s*FUNCTION\\s+([A-Za-z,#0-9\\s()_-]+)\\s*;?"
@@ -54,12 +70,26 @@ class RegexHandler {
       {REGEX(RENAME_COLUMN_CMD), &RegexHandler::renameColumnHandler},
       {REGEX(INSERT_SINGLE_CMD), &RegexHandler::insertSingleHandler},
       {REGEX(INSERT_MULTIPLE_CMD), &RegexHandler::insertFromFileHandler},
+      {REGEX(SELECT_DISTINCT_CMD), &RegexHandler::selectDistinctHandler},
+      {REGEX(SET_OPERATION_CMD), &RegexHandler::setOperationHandler},
+      {REGEX(SELECT_IN_CMD), &RegexHandler::selectInHandler},
+      {REGEX(SELECT_EXISTS_CMD), &RegexHandler::selectExistsHandler},
+      {REGEX(SELECT_ORDER_BY_CMD), &RegexHandler::selectOrderByHandler},
+      {REGEX(SELECT_LIMIT_CMD), &RegexHandler::selectLimitHandler},
+      {REGEX(SELECT_AGGREGATE_CMD), &RegexHandler::selectAggregateHandler},
       {REGEX(SELECT_FROM_CMD), &RegexHandler::selectFromHandler},
       {REGEX(SELECT_FROM_WHERE_CMD), &RegexHandler::selectFromWhereHandler},
       {REGEX(SELECT_ATTR_FROM_CMD), &RegexHandler::selectAttrFromHandler},
       {REGEX(SELECT_ATTR_FROM_WHERE_CMD), &RegexHandler::selectAttrFromWhereHandler},
+      {REGEX(SELECT_FROM_WHERE_COND_CMD), &RegexHandler::selectFromWhereCondHandler},
+      {REGEX(SELECT_ATTR_FROM_WHERE_COND_CMD), &RegexHandler::selectAttrFromWhereCondHandler},
       {REGEX(SELECT_FROM_JOIN_CMD), &RegexHandler::selectFromJoinHandler},
       {REGEX(SELECT_ATTR_FROM_JOIN_CMD), &RegexHandler::selectAttrFromJoinHandler},
+      {REGEX(SELECT_FROM_JOIN_BETWEEN_CMD), &RegexHandler::selectFromJoinBetweenHandler},
+      {REGEX(SELECT_ATTR_FROM_JOIN_BETWEEN_CMD), &RegexHandler::selectAttrFromJoinBetweenHandler},
+      {REGEX(SELECT_FROM_JOIN_ON_CMD), &RegexHandler::selectFromJoinOnHandler},
+      {REGEX(SELECT_ATTR_FROM_JOIN_ON_CMD), &RegexHandler::selectAttrFromJoinOnHandler},
+      {REGEX(EXPLAIN_SELECT_CMD), &RegexHandler::explainSelectHandler},
       {REGEX(CUSTOM_CMD), &RegexHandler::customFunctionHandler},
   };
 
@@ -86,8 +116,22 @@ class RegexHandler {
   int selectFromWhereHandler();
   int selectAttrFromHandler();
   int selectAttrFromWhereHandler();
+  int selectFromWhereCondHandler();
+  int selectAttrFromWhereCondHandler();
   int selectFromJoinHandler();
   int selectAttrFromJoinHandler();
+  int selectFromJoinBetweenHandler();
+  int selectAttrFromJoinBetweenHandler();
+  int selectFromJoinOnHandler();
+  int selectAttrFromJoinOnHandler();
+  int selectOrderByHandler();
+  int selectDistinctHandler();
+  int selectLimitHandler();
+  int setOperationHandler();
+  int selectInHandler();
+  int selectExistsHandler();
+  int selectAggregateHandler();
+  int explainSelectHandler();
   int customFunctionHandler();
 
  public:
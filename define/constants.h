@@ -35,6 +35,17 @@
 #define NO_OF_ATTRS_RELCAT_ATTRCAT 6    // Common variable to indicate the number of attributes present in one entry of Relation Catalog / Attribute Catalog
 #define SLOTMAP_SIZE_RELCAT_ATTRCAT 20  // Size of slotmap in both Relation Catalog and Attribute Catalog
 
+#define MAX_SLOTS_PER_BLOCK 118  // Maximum number of slots in a record block (floor(2016 / (16 * 1 + 1)) for a single attribute relation)
+#define SELECTION_BITMAP_WORDS 2  // Number of 64-bit words in the selection bitmap of a record block (one bit per slot)
+#define OPERATOR_MEMORY_BLOCKS 16  // Number of blocks worth of records an operator (e.g. a hash join) may hold in memory before spilling to disk
+#define MAX_JOIN_RELATIONS 8  // Maximum number of relations in a single (multi-way) join
+#define DISTINCT_SKETCH_REGISTERS 256  // Number of registers of the sketch that estimates the number of distinct values of an attribute
+#define BATCH_SIZE 1024  // Number of records in a batch exchanged by the operators of the vectorized engine (a multiple of 64)
+#define MORSEL_BLOCKS 4  // Number of record blocks in a morsel, the unit of work a worker thread of a parallel scan takes at a time
+#define MAX_WORKERS 64  // Maximum number of worker threads of a parallel operation
+#define INDEX_BUILD_MEMORY_BLOCKS 2048  // Number of blocks worth of (value, rec-id) pairs CREATE INDEX may sort in memory to build a B+ tree bottom-up
+#define INDEX_BUILD_FILL_PERCENT 90  // How full (in percent of its capacity) CREATE INDEX makes every block of a B+ tree it builds bottom-up
+
 #define SLOT_OCCUPIED '1'    // Value to mark a slot in Slotmap as Occupied
 #define SLOT_UNOCCUPIED '0'  // Value to mark a slot in Slotmap as Unoccupied
 